@@ -0,0 +1,25 @@
+/**
+ * @file bytes.hpp
+ * @brief Umbrella header for byte swapping, endianness, checksums, hashing, integer codecs, bit streams, sort keys,
+ * hex/Base64 text encodings, UTF-8 validation, fp16/bf16 conversion, record/column transposition and bulk byte
+ * operations.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/bytes/base64.hpp>       // IWYU pragma: export
+#include <saburou/platform/v2/bytes/bitpack.hpp>      // IWYU pragma: export
+#include <saburou/platform/v2/bytes/bitstream.hpp>    // IWYU pragma: export
+#include <saburou/platform/v2/bytes/byte_swap.hpp>    // IWYU pragma: export
+#include <saburou/platform/v2/bytes/crc.hpp>          // IWYU pragma: export
+#include <saburou/platform/v2/bytes/endian.hpp>       // IWYU pragma: export
+#include <saburou/platform/v2/bytes/half.hpp>         // IWYU pragma: export
+#include <saburou/platform/v2/bytes/hex.hpp>          // IWYU pragma: export
+#include <saburou/platform/v2/bytes/key_encoder.hpp>  // IWYU pragma: export
+#include <saburou/platform/v2/bytes/mem.hpp>          // IWYU pragma: export
+#include <saburou/platform/v2/bytes/radix_sort.hpp>   // IWYU pragma: export
+#include <saburou/platform/v2/bytes/soa.hpp>          // IWYU pragma: export
+#include <saburou/platform/v2/bytes/stream_vbyte.hpp> // IWYU pragma: export
+#include <saburou/platform/v2/bytes/utf8.hpp>         // IWYU pragma: export
+#include <saburou/platform/v2/bytes/varint.hpp>       // IWYU pragma: export
+#include <saburou/platform/v2/bytes/xxh3.hpp>         // IWYU pragma: export
@@ -0,0 +1,205 @@
+#pragma once
+
+/**
+ * @file base64.hpp
+ * @brief Base64 (RFC 4648) with the standard and URL-safe alphabets into caller buffers, with AVX2,
+ * AVX-512 VBMI and NEON kernels.
+ *
+ * The standard alphabet ('+', '/') is written with '=' padding and must be padded when decoded. The URL
+ * alphabet ('-', '_') is written without padding, as in JWT and most URLs, and decodes with or without it.
+ * Decoding is strict: no whitespace or line breaks, no characters from the other alphabet, padding only at
+ * the end, and unused bits of the last character must be zero, so every byte string has exactly one
+ * accepted encoding per alphabet.
+ *
+ * Errors follow varint.hpp: @c no_buffer_space for a too small output, @c message_size for a length no
+ * encoding can have, @c illegal_byte_sequence for anything else that is not valid Base64.
+ *
+ * @code
+ * std::vector<char> text(bytes::base64_encoded_size(blob.size()));
+ * auto n = bytes::base64_encode(blob, text);
+ * auto m = bytes::base64_decode({text.data(), *n}, blob, bytes::base64_alphabet_t::standard);
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/detail/base64_kernels.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+namespace saburou::platform::v2::bytes {
+
+/**
+ * @brief Base64 alphabet, which also decides the padding.
+ */
+enum class base64_alphabet_t : uint8_t {
+    standard, // A-Z a-z 0-9 + /, padded with '='
+    url       // A-Z a-z 0-9 - _, unpadded
+};
+
+/**
+ * @brief Converts a base64_alphabet_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(base64_alphabet_t a) {
+    switch (a) {
+    case base64_alphabet_t::standard: return "standard";
+    case base64_alphabet_t::url:      return "url";
+    default:                          return "unknown";
+    }
+}
+
+namespace detail {
+
+/** @brief Base64 loops of one alphabet, selected once per process. */
+struct base64_kernels_t {
+    std::size_t (*encode)(const unsigned char *, std::size_t, char *) noexcept;
+    std::size_t (*decode)(const char *, std::size_t, unsigned char *, std::size_t) noexcept;
+};
+
+template <bool Url>
+inline std::size_t base64_scalar_decode(const char *in, std::size_t n, unsigned char *out, std::size_t) noexcept {
+    return base64_scalar::decode<Url>(in, n, out);
+}
+
+template <bool Url> [[nodiscard]] inline base64_kernels_t select_base64_kernels(const cpu::features_t &f) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_X86
+    if (f.avx512bw && f.avx512vbmi) return {base64_vbmi::encode<Url>, base64_vbmi::decode<Url>};
+    if (f.avx2) return {base64_avx2::encode<Url>, base64_avx2::decode<Url>};
+#elif SABUROU_PLATFORM_V2_SIMD_NEON
+    if (f.neon) return {base64_neon::encode<Url>, base64_neon::decode<Url>};
+#endif
+    (void)f;
+    return {base64_scalar::encode<Url>, base64_scalar_decode<Url>};
+}
+
+template <bool Url> [[nodiscard]] inline const base64_kernels_t &base64_kernels() noexcept {
+    static const base64_kernels_t k = select_base64_kernels<Url>(cpu::features());
+    return k;
+}
+
+template <bool Url> inline void base64_encode_all(const unsigned char *in, std::size_t n, char *out) noexcept {
+    std::size_t done = base64_kernels<Url>().encode(in, n, out);
+    done += base64_scalar::encode<Url>(in + done, n - done, out + done / 3 * 4);
+    out += done / 3 * 4;
+    std::size_t rest = n - done;
+    if (rest == 0) return;
+    const char *chars = base64_chars<Url>;
+    uint32_t v = uint32_t{in[done]} << 16 | (rest == 2 ? uint32_t{in[done + 1]} << 8 : 0);
+    out[0] = chars[v >> 18];
+    out[1] = chars[(v >> 12) & 63];
+    if (rest == 2) out[2] = chars[(v >> 6) & 63];
+    if constexpr (!Url) {
+        if (rest == 1) out[2] = '=';
+        out[3] = '=';
+    }
+}
+
+/**
+ * @brief Decodes @p n characters without padding, ending in a partial quantum of @p n % 4 (0, 2, 3).
+ * @param room Bytes of @p out the SIMD loops may store to; the AVX2 loop stores 32 bytes per 24 decoded.
+ */
+template <bool Url>
+[[nodiscard]] inline bool base64_decode_all(const char *in, std::size_t n, unsigned char *out,
+                                            std::size_t room) noexcept {
+    std::size_t full = n - n % 4;
+    std::size_t done = base64_kernels<Url>().decode(in, full, out, room);
+    done += base64_scalar::decode<Url>(in + done, full - done, out + done / 4 * 3);
+    if (done != full) return false;
+    out += full / 4 * 3;
+    in += full;
+    std::size_t rest = n - full;
+    if (rest == 0) return true;
+    const auto &values = base64_values<Url>;
+    uint32_t a = values[static_cast<unsigned char>(in[0])], b = values[static_cast<unsigned char>(in[1])];
+    uint32_t c = rest == 3 ? values[static_cast<unsigned char>(in[2])] : 0;
+    if ((a | b | c) > 63) return false;
+    uint32_t v = a << 18 | b << 12 | c << 6;
+    // The bits below the last full byte must be zero for the encoding to be canonical.
+    if (v & (rest == 2 ? 0xFFFFu : 0xFFu)) return false;
+    out[0] = static_cast<unsigned char>(v >> 16);
+    if (rest == 3) out[1] = static_cast<unsigned char>(v >> 8);
+    return true;
+}
+
+[[nodiscard]] inline std::unexpected<std::error_code> base64_error(std::errc e) noexcept {
+    return std::unexpected(std::make_error_code(e));
+}
+
+} // namespace detail
+
+/** @brief Characters base64_encode() writes for @p n bytes. */
+[[nodiscard]] constexpr std::size_t
+base64_encoded_size(std::size_t n, base64_alphabet_t alphabet = base64_alphabet_t::standard) noexcept {
+    if (alphabet == base64_alphabet_t::standard) return (n + 2) / 3 * 4;
+    return n / 3 * 4 + (n % 3 ? n % 3 + 1 : 0);
+}
+
+/** @brief Upper bound of the bytes base64_decode() writes for @p n characters. */
+[[nodiscard]] constexpr std::size_t base64_decoded_max_size(std::size_t n) noexcept { return (n + 3) / 4 * 3; }
+
+/**
+ * @brief Writes the Base64 encoding of @p in to @p out.
+ * @return Characters written, or @c no_buffer_space if @p out is shorter than base64_encoded_size().
+ */
+[[nodiscard]] inline std::expected<std::size_t, std::error_code>
+base64_encode(std::span<const std::byte> in, std::span<char> out,
+              base64_alphabet_t alphabet = base64_alphabet_t::standard) noexcept {
+    std::size_t size = base64_encoded_size(in.size(), alphabet);
+    if (out.size() < size) return detail::base64_error(std::errc::no_buffer_space);
+    const auto *p = reinterpret_cast<const unsigned char *>(in.data());
+    if (alphabet == base64_alphabet_t::url) detail::base64_encode_all<true>(p, in.size(), out.data());
+    else detail::base64_encode_all<false>(p, in.size(), out.data());
+    return size;
+}
+
+/**
+ * @brief Decodes Base64 @p in into @p out, strictly (see the file comment).
+ * @return Bytes written; @c message_size or @c illegal_byte_sequence for invalid input (with @p out partially
+ * written), @c no_buffer_space if @p out is too small for the decoded bytes.
+ */
+[[nodiscard]] inline std::expected<std::size_t, std::error_code>
+base64_decode(std::string_view in, std::span<std::byte> out,
+              base64_alphabet_t alphabet = base64_alphabet_t::standard) noexcept {
+    std::size_t n = in.size(), pad = 0;
+    if (n % 4 == 0 && n > 0 && in[n - 1] == '=') pad = in[n - 2] == '=' ? 2 : 1;
+    if (alphabet == base64_alphabet_t::standard && n % 4 != 0) return detail::base64_error(std::errc::message_size);
+    if (n % 4 == 1) return detail::base64_error(std::errc::message_size);
+    std::size_t body = n - pad;
+    std::size_t size = body / 4 * 3 + (body % 4 ? body % 4 - 1 : 0);
+    if (out.size() < size) return detail::base64_error(std::errc::no_buffer_space);
+    auto *o = reinterpret_cast<unsigned char *>(out.data());
+    // Only the decoded bytes may be written: the rest of the caller's span is left alone.
+    bool ok = alphabet == base64_alphabet_t::url ? detail::base64_decode_all<true>(in.data(), body, o, size)
+                                                 : detail::base64_decode_all<false>(in.data(), body, o, size);
+    if (!ok) return detail::base64_error(std::errc::illegal_byte_sequence);
+    return size;
+}
+
+} // namespace saburou::platform::v2::bytes
+
+/**
+ * @brief std::formatter specialization for base64_alphabet_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "base64_alphabet_t::url").
+ */
+template <> struct std::formatter<saburou::platform::v2::bytes::base64_alphabet_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::bytes::base64_alphabet_t &a, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::bytes::to_code_name(a);
+        return repr ? std::format_to(ctx.out(), "base64_alphabet_t::{}", name)
+                    : std::format_to(ctx.out(), "{}", name);
+    }
+};
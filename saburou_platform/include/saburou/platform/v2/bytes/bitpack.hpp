@@ -0,0 +1,173 @@
+#pragma once
+
+/**
+ * @file bitpack.hpp
+ * @brief Bit-packing of 32-bit integers in blocks of 128 or 256 values, with delta and frame-of-reference
+ * transforms, for sorted ID columns and posting lists.
+ *
+ * A block of Block values packed at @c bits bits takes exactly Block * bits / 8 bytes, in the SIMD-BP128
+ * interleaved layout (4 lanes for 128-value blocks, 8 for 256-value blocks). The transforms apply before
+ * packing:
+ * - plain: values as they are.
+ * - frame_of_reference: value - base, for values clustered above a known minimum.
+ * - delta: differences of sorted values. Each value is stored relative to the one Block / 32 positions
+ *   earlier (the previous value of the same lane), the first row relative to @c base, so decoding is a
+ *   vector prefix sum.
+ *
+ * Every width and transform is a separate fully unrolled instantiation. 128-value blocks run on SSE2 or
+ * NEON, 256-value blocks on AVX2 when the CPU has it; the packed bytes are the same on every host.
+ *
+ * @code
+ * unsigned bits = bytes::bitpack_width(ids, bytes::bitpack_mode_t::delta, prev_last);
+ * bytes::bitpack(ids, bits, out, bytes::bitpack_mode_t::delta, prev_last);
+ * bytes::bitunpack(out, bits, ids, bytes::bitpack_mode_t::delta, prev_last);
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/detail/bitpack_kernels.hpp>
+#include <saburou/platform/v2/bytes/endian/little.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+
+namespace saburou::platform::v2::bytes {
+
+/**
+ * @brief Transform applied to a block before packing.
+ */
+enum class bitpack_mode_t : uint8_t {
+    plain,              // Values packed as they are
+    frame_of_reference, // Values minus a base
+    delta               // Differences to the previous value of the same lane
+};
+
+/**
+ * @brief Converts a bitpack_mode_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(bitpack_mode_t m) {
+    switch (m) {
+    case bitpack_mode_t::plain:              return "plain";
+    case bitpack_mode_t::frame_of_reference: return "frame_of_reference";
+    case bitpack_mode_t::delta:              return "delta";
+    default:                                 return "unknown";
+    }
+}
+
+/** @brief Block sizes the kernels support. */
+template <std::size_t Block>
+concept BitpackBlock = Block == 128 || Block == 256;
+
+/** @brief Packed bytes of one block at @p bits bits per value. */
+template <std::size_t Block = 128>
+    requires BitpackBlock<Block>
+[[nodiscard]] constexpr std::size_t bitpack_size(unsigned bits) noexcept {
+    return Block * bits / 8;
+}
+
+namespace detail {
+
+static_assert(static_cast<unsigned>(bitpack_mode_t::plain) == bitpack_plain);
+static_assert(static_cast<unsigned>(bitpack_mode_t::frame_of_reference) == bitpack_frame);
+static_assert(static_cast<unsigned>(bitpack_mode_t::delta) == bitpack_delta);
+
+[[nodiscard]] inline const bitpack_table_t &select_bitpack_256(const cpu::features_t &f) noexcept {
+    if constexpr (endian::is_little) {
+#if SABUROU_PLATFORM_V2_SIMD_X86 && SABUROU_PLATFORM_V2_BITPACK_VECTOR_TYPES
+        static constexpr bitpack_table_t avx2 =
+            make_bitpack_table<bitpack_avx2_entries>(std::make_integer_sequence<unsigned, 33>{});
+        if (f.avx2) return avx2;
+#endif
+    }
+    (void)f;
+    return bitpack_generic_table<bitpack_default_vec<8>>;
+}
+
+/** @brief Kernel table of a block size, selected once per process. */
+template <std::size_t Block> [[nodiscard]] inline const bitpack_table_t &bitpack_kernels() noexcept {
+    if constexpr (Block == 128) {
+        return bitpack_generic_table<bitpack_default_vec<4>>;
+    } else {
+        static const bitpack_table_t &k = select_bitpack_256(cpu::features());
+        return k;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Smallest width that packs the block at @p in under @p mode without loss.
+ * @param in Block values.
+ * @param mode Transform the block will be packed with.
+ * @param base Base of frame_of_reference, or the value preceding the block for delta (0 for the first block).
+ */
+template <std::size_t Block = 128>
+    requires BitpackBlock<Block>
+[[nodiscard]] inline unsigned bitpack_width(const uint32_t *in, bitpack_mode_t mode = bitpack_mode_t::plain,
+                                            uint32_t base = 0) noexcept {
+    constexpr std::size_t lanes = Block / detail::bitpack_rows;
+    uint32_t bits = 0;
+    switch (mode) {
+    case bitpack_mode_t::frame_of_reference:
+        for (std::size_t i = 0; i < Block; ++i) bits |= in[i] - base;
+        break;
+    case bitpack_mode_t::delta:
+        for (std::size_t i = 0; i < lanes; ++i) bits |= in[i] - base;
+        for (std::size_t i = lanes; i < Block; ++i) bits |= in[i] - in[i - lanes];
+        break;
+    default:
+        for (std::size_t i = 0; i < Block; ++i) bits |= in[i];
+        break;
+    }
+    return static_cast<unsigned>(std::bit_width(bits));
+}
+
+/**
+ * @brief Packs the Block values at @p in into bitpack_size<Block>(bits) bytes at @p out.
+ * * Bits of the transformed values above @p bits are dropped; see bitpack_width().
+ * @pre bits <= 32
+ */
+template <std::size_t Block = 128>
+    requires BitpackBlock<Block>
+inline void bitpack(const uint32_t *in, unsigned bits, std::byte *out, bitpack_mode_t mode = bitpack_mode_t::plain,
+                    uint32_t base = 0) noexcept {
+    detail::bitpack_kernels<Block>().pack[static_cast<unsigned>(mode)][bits](
+        in, reinterpret_cast<unsigned char *>(out), base);
+}
+
+/**
+ * @brief Unpacks one block written by bitpack() with the same @p bits, @p mode and @p base.
+ * @pre bits <= 32
+ */
+template <std::size_t Block = 128>
+    requires BitpackBlock<Block>
+inline void bitunpack(const std::byte *in, unsigned bits, uint32_t *out, bitpack_mode_t mode = bitpack_mode_t::plain,
+                      uint32_t base = 0) noexcept {
+    detail::bitpack_kernels<Block>().unpack[static_cast<unsigned>(mode)][bits](
+        reinterpret_cast<const unsigned char *>(in), out, base);
+}
+
+} // namespace saburou::platform::v2::bytes
+
+/**
+ * @brief std::formatter specialization for bitpack_mode_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "bitpack_mode_t::delta").
+ */
+template <> struct std::formatter<saburou::platform::v2::bytes::bitpack_mode_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::bytes::bitpack_mode_t &m, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::bytes::to_code_name(m);
+        return repr ? std::format_to(ctx.out(), "bitpack_mode_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
@@ -0,0 +1,324 @@
+#pragma once
+
+/**
+ * @file bitstream.hpp
+ * @brief Bit-level readers and writers for entropy coders and packed formats (Huffman, ANS, telemetry).
+ *
+ * A stream is a sequence of Word-sized units stored in Backing byte order, each consumed from its least
+ * (bit_order_t::lsb_first) or most (bit_order_t::msb_first) significant bit. With the default byte words this
+ * covers DEFLATE, zstd and Brotli (LSB first) and JPEG, H.264 or MPEG (MSB first); 16-bit words cover formats
+ * such as LZX and XPRESS that pack bits into little-endian words read from the top.
+ *
+ * Both classes keep up to 64 bits in a register and touch memory with one unaligned 64-bit endian load or
+ * store per refill/flush, advancing by whole words without a loop (the "lookahead" refill: bits beyond the
+ * buffered count are re-read, not cleared). peek() and consume() are shifts and masks without branches; a
+ * read() can take up to max_bits bits, 56 for byte streams. Reading past the end yields zero bits and is
+ * reported by overrun(), so decoders check once at the end instead of on every symbol.
+ *
+ * read_fixed() decodes runs of equal-width fields; on LSB-first streams with BMI2 (selected at run time) it
+ * expands up to eight fields per PDEP.
+ *
+ * @code
+ * auto file = io::mapped_file::open("trace.bin");
+ * bytes::bit_reader in(file->bytes());
+ * while (...) { in.refill(); auto sym = table[in.peek(11)]; in.consume(sym.length); }
+ * if (in.overrun()) ... // truncated input
+ *
+ * bytes::bit_writer<bytes::bit_order_t::msb_first> out(buffer);
+ * out.write(code, length);
+ * auto size = out.finish(); // std::expected<std::size_t, std::error_code>
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/endian/big.hpp>
+#include <saburou/platform/v2/bytes/endian/little.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <format>
+#include <span>
+#include <system_error>
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace saburou::platform::v2::bytes {
+
+/**
+ * @brief Order in which the bits of each stream word are consumed.
+ */
+enum class bit_order_t : uint8_t {
+    lsb_first, // Least significant bit first (DEFLATE, zstd, Brotli)
+    msb_first  // Most significant bit first (JPEG, H.264, LZX)
+};
+
+/**
+ * @brief Converts a bit_order_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(bit_order_t o) {
+    switch (o) {
+    case bit_order_t::lsb_first: return "lsb_first";
+    case bit_order_t::msb_first: return "msb_first";
+    default:                     return "unknown";
+    }
+}
+
+/** @brief Storage units a bit stream can be made of. */
+template <class W>
+concept BitstreamWord = std::same_as<W, uint8_t> || std::same_as<W, uint16_t> || std::same_as<W, uint32_t>;
+
+namespace detail {
+
+/** @brief Reverses the bytes inside each @p N-byte lane of @p v. */
+template <std::size_t N> [[nodiscard]] constexpr uint64_t bits_swap_lanes(uint64_t v) noexcept {
+    if constexpr (N >= 2) v = ((v >> 8) & 0x00FF00FF00FF00FFull) | ((v & 0x00FF00FF00FF00FFull) << 8);
+    if constexpr (N >= 4) v = ((v >> 16) & 0x0000FFFF0000FFFFull) | ((v & 0x0000FFFF0000FFFFull) << 16);
+    return v;
+}
+
+/**
+ * @brief The 64 stream bits starting at @p p, first bit in bit 0 (LSB first) or bit 63 (MSB first).
+ * * Words whose byte order disagrees with the bit order (e.g. MSB-first little-endian words) are loaded in
+ * stream byte order and then byte-reversed inside each word.
+ */
+template <bit_order_t Order, class Word, std::endian Backing>
+[[nodiscard]] inline uint64_t bits_load(const unsigned char *p) noexcept {
+    constexpr bool lsb = Order == bit_order_t::lsb_first;
+    uint64_t raw;
+    std::memcpy(&raw, p, 8);
+    uint64_t v = lsb ? endian::from_little(raw) : endian::from_big(raw);
+    if constexpr (Backing != (lsb ? std::endian::little : std::endian::big)) v = bits_swap_lanes<sizeof(Word)>(v);
+    return v;
+}
+
+/** @brief Inverse of bits_load(): the first @p n bytes of the stored form of @p v. */
+template <bit_order_t Order, class Word, std::endian Backing>
+inline void bits_store(unsigned char *p, uint64_t v, std::size_t n = 8) noexcept {
+    constexpr bool lsb = Order == bit_order_t::lsb_first;
+    if constexpr (Backing != (lsb ? std::endian::little : std::endian::big)) v = bits_swap_lanes<sizeof(Word)>(v);
+    uint64_t raw = lsb ? endian::to_little(v) : endian::to_big(v);
+    std::memcpy(p, &raw, n);
+}
+
+/** @brief Low @p n bits set, @p n < 64 (BZHI under -mbmi2). */
+[[nodiscard]] constexpr uint64_t bits_mask(unsigned n) noexcept { return (uint64_t{1} << n) - 1; }
+
+/** @brief @p lanes copies of bits_mask(n), one per @p lane_bits-bit lane: the PDEP mask of n-bit fields. */
+[[nodiscard]] constexpr uint64_t bits_lane_mask(unsigned n, unsigned lane_bits, unsigned lanes) noexcept {
+    uint64_t m = 0;
+    for (unsigned i = 0; i < lanes; ++i) m |= bits_mask(n) << (i * lane_bits);
+    return m;
+}
+
+} // namespace detail
+
+/**
+ * @brief Reads a bit stream from a byte span (e.g. io::mapped_file::bytes()).
+ * @tparam Order Bit order within each word.
+ * @tparam Word Storage unit: uint8_t for byte streams, uint16_t/uint32_t for word-packed formats.
+ * @tparam Backing Byte order of multi-byte words.
+ */
+template <bit_order_t Order = bit_order_t::lsb_first, BitstreamWord Word = uint8_t,
+          std::endian Backing = std::endian::little>
+class bit_reader {
+public:
+    static constexpr unsigned word_bits = 8 * sizeof(Word);
+    /** @brief Bits available to peek() after refill(). */
+    static constexpr unsigned max_bits = 64 - word_bits;
+
+    bit_reader() = default;
+
+    /** @brief Starts at the first bit of @p in; the span must outlive the reader. */
+    explicit bit_reader(std::span<const std::byte> in) noexcept
+        : data_(reinterpret_cast<const unsigned char *>(in.data())), size_(in.size()) {
+        refill();
+    }
+
+    /** @brief Tops the buffer up to at least max_bits bits. */
+    void refill() noexcept {
+        uint64_t v;
+        if (pos_ + 8 <= size_) {
+            v = detail::bits_load<Order, Word, Backing>(data_ + pos_);
+        } else {
+            // The last few bytes, then zeros.
+            unsigned char tail[8] = {};
+            if (pos_ < size_) std::memcpy(tail, data_ + pos_, size_ - pos_);
+            v = detail::bits_load<Order, Word, Backing>(tail);
+        }
+        if constexpr (Order == bit_order_t::lsb_first) buf_ |= v << count_;
+        else buf_ |= v >> count_;
+        unsigned words = (63 - count_) / word_bits;
+        pos_ += words * sizeof(Word);
+        count_ += words * word_bits;
+    }
+
+    /** @brief Next @p n bits without consuming them. @pre n <= buffered() */
+    [[nodiscard]] uint64_t peek(unsigned n) const noexcept {
+        if constexpr (Order == bit_order_t::lsb_first) return buf_ & detail::bits_mask(n);
+        else return (buf_ >> 1) >> (63 - n);
+    }
+
+    /** @brief Drops @p n bits. @pre n <= buffered() */
+    void consume(unsigned n) noexcept {
+        if constexpr (Order == bit_order_t::lsb_first) buf_ >>= n;
+        else buf_ <<= n;
+        count_ -= n;
+    }
+
+    /** @brief refill(), peek() and consume() in one call. @pre n <= max_bits */
+    uint64_t read(unsigned n) noexcept {
+        refill();
+        uint64_t v = peek(n);
+        consume(n);
+        return v;
+    }
+
+    /**
+     * @brief Reads out.size() fields of @p n bits each.
+     * @pre n <= max_bits and n <= the bits of T
+     */
+    template <std::unsigned_integral T> void read_fixed(std::span<T> out, unsigned n) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_X86
+        if constexpr (Order == bit_order_t::lsb_first && sizeof(T) <= 2) {
+            if (cpu::features().bmi2) return read_fixed_bmi2(out, n);
+        }
+#endif
+        for (T &v : out) v = static_cast<T>(read(n));
+    }
+
+    /** @brief Skips to the next word boundary. */
+    void align() noexcept {
+        refill();
+        consume(static_cast<unsigned>((word_bits - bit_position() % word_bits) % word_bits));
+    }
+
+    /** @brief Bits currently buffered. */
+    [[nodiscard]] unsigned buffered() const noexcept { return count_; }
+
+    /** @brief Bits consumed since the start. */
+    [[nodiscard]] std::size_t bit_position() const noexcept { return pos_ * 8 - count_; }
+
+    /** @brief True once more bits were consumed than the input holds. */
+    [[nodiscard]] bool overrun() const noexcept { return bit_position() > size_ * 8; }
+
+private:
+#if SABUROU_PLATFORM_V2_SIMD_X86
+    /** @brief Expands up to 64 / (8 * sizeof(T)) fields per PDEP, one per lane of T. */
+    template <class T> SABUROU_PLATFORM_V2_TARGET("bmi2") void read_fixed_bmi2(std::span<T> out, unsigned n) noexcept {
+        constexpr unsigned lane_bits = 8 * sizeof(T), lanes = 64 / lane_bits;
+        unsigned k = std::min(lanes, max_bits / std::max(n, 1u));
+        uint64_t mask = detail::bits_lane_mask(n, lane_bits, k);
+        T *p = out.data(), *end = p + out.size();
+        for (; end - p >= static_cast<std::ptrdiff_t>(lanes); p += k) {
+            refill();
+            uint64_t v = endian::to_little(static_cast<uint64_t>(_pdep_u64(buf_, mask)));
+            std::memcpy(p, &v, 8);
+            consume(k * n);
+        }
+        for (; p != end; ++p) *p = static_cast<T>(read(n));
+    }
+#endif
+
+    const unsigned char *data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t pos_ = 0; ///< Next byte to load
+    uint64_t buf_ = 0;
+    unsigned count_ = 0;
+};
+
+/**
+ * @brief Writes a bit stream into a caller-provided byte span.
+ * * Flushes store 8 bytes at a time, so bytes past the final size may be overwritten.
+ * @tparam Order Bit order within each word.
+ * @tparam Word Storage unit: uint8_t for byte streams, uint16_t/uint32_t for word-packed formats.
+ * @tparam Backing Byte order of multi-byte words.
+ */
+template <bit_order_t Order = bit_order_t::lsb_first, BitstreamWord Word = uint8_t,
+          std::endian Backing = std::endian::little>
+class bit_writer {
+public:
+    static constexpr unsigned word_bits = 8 * sizeof(Word);
+    /** @brief Widest write(). */
+    static constexpr unsigned max_bits = 64 - word_bits;
+
+    bit_writer() = default;
+
+    explicit bit_writer(std::span<std::byte> out) noexcept
+        : data_(reinterpret_cast<unsigned char *>(out.data())), size_(out.size()) {}
+
+    /** @brief Appends the low @p n bits of @p value. @pre n <= max_bits */
+    void write(uint64_t value, unsigned n) noexcept {
+        value &= detail::bits_mask(n);
+        if constexpr (Order == bit_order_t::lsb_first) buf_ |= value << count_;
+        else buf_ |= ((value << (63 - n)) << 1) >> count_;
+        count_ += n;
+        flush();
+    }
+
+    /** @brief Pads with zero bits to the next word boundary. */
+    void align() noexcept {
+        count_ = (count_ + word_bits - 1) / word_bits * word_bits;
+        flush();
+    }
+
+    /** @brief Bits written since the start. */
+    [[nodiscard]] std::size_t bit_position() const noexcept { return pos_ * 8 + count_; }
+
+    /**
+     * @brief Pads the last word and flushes it.
+     * @return Bytes of the stream, or @c no_buffer_space if it did not fit the span.
+     */
+    [[nodiscard]] std::expected<std::size_t, std::error_code> finish() noexcept {
+        align();
+        if (pos_ > size_) return std::unexpected(std::make_error_code(std::errc::no_buffer_space));
+        return pos_;
+    }
+
+private:
+    /** @brief Stores the buffer and drops its complete words. */
+    void flush() noexcept {
+        if (pos_ + 8 <= size_) detail::bits_store<Order, Word, Backing>(data_ + pos_, buf_);
+        else if (pos_ < size_) detail::bits_store<Order, Word, Backing>(data_ + pos_, buf_, size_ - pos_);
+        unsigned words = count_ / word_bits, shift = words * word_bits;
+        pos_ += words * sizeof(Word);
+        if constexpr (Order == bit_order_t::lsb_first) buf_ >>= shift;
+        else buf_ <<= shift;
+        count_ -= shift;
+    }
+
+    unsigned char *data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t pos_ = 0; ///< Next byte to store
+    uint64_t buf_ = 0;
+    unsigned count_ = 0;
+};
+
+} // namespace saburou::platform::v2::bytes
+
+/**
+ * @brief std::formatter specialization for bit_order_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "bit_order_t::msb_first").
+ */
+template <> struct std::formatter<saburou::platform::v2::bytes::bit_order_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::bytes::bit_order_t &o, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::bytes::to_code_name(o);
+        return repr ? std::format_to(ctx.out(), "bit_order_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
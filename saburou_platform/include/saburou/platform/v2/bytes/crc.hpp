@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file crc.hpp
+ * @brief CRC-32C (Castagnoli) and CRC-32 (IEEE 802.3, zlib) with runtime-dispatched hardware kernels.
+ *
+ * Results match the usual definitions (init and final xor 0xFFFFFFFF, reflected): crc32c("123456789")
+ * is 0xE3069283 and crc32("123456789") is 0xCBF43926. Passing the previous result as @p crc continues a
+ * stream, and the *_combine() functions join CRCs of chunks computed in parallel.
+ *
+ * @code
+ * uint32_t crc = 0;
+ * for (auto chunk : chunks) crc = bytes::crc32c(chunk, crc);
+ * uint32_t whole = bytes::crc32c_combine(crc_a, crc_b, size_b); // == crc32c(a ++ b)
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/detail/crc_kernels.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace saburou::platform::v2::bytes {
+
+namespace detail {
+
+using crc_kernel_fn = uint32_t (*)(uint32_t, const unsigned char *, std::size_t) noexcept;
+
+/** @brief Smallest input the 512-bit folding kernel takes; below it the per-call setup dominates. */
+inline constexpr std::size_t crc_vpclmul_min = 1024;
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+/** @brief Folds the 16-byte aligned prefix, finishing the tail with @p tail. */
+template <uint32_t Poly, bool Wide>
+[[nodiscard]] inline uint32_t crc_fold(uint32_t crc, const unsigned char *p, std::size_t n,
+                                       crc_kernel_fn tail) noexcept {
+    std::size_t body = n & ~std::size_t{15};
+    if constexpr (Wide) crc = vpclmul::fold_crc(crc, p, body, crc_fold_constants<Poly>);
+    else crc = pclmul::fold_crc(crc, p, body, crc_fold_constants<Poly>);
+    return tail(crc, p + body, n - body);
+}
+
+inline uint32_t crc32c_x86(uint32_t crc, const unsigned char *p, std::size_t n) noexcept {
+    if (n >= crc_vpclmul_min && cpu::features().vpclmulqdq && cpu::features().avx512vl)
+        return crc_fold<crc32c_poly, true>(crc, p, n, sse42::crc32c);
+    return sse42::crc32c(crc, p, n);
+}
+
+inline uint32_t crc32_x86(uint32_t crc, const unsigned char *p, std::size_t n) noexcept {
+    if (n >= crc_vpclmul_min && cpu::features().vpclmulqdq && cpu::features().avx512vl)
+        return crc_fold<crc32_poly, true>(crc, p, n, crc_slice8<crc32_poly>);
+    if (n >= 64) return crc_fold<crc32_poly, false>(crc, p, n, crc_slice8<crc32_poly>);
+    return crc_slice8<crc32_poly>(crc, p, n);
+}
+#endif
+
+/** @brief Picks the CRC-32C kernel for @p f. */
+[[nodiscard]] inline crc_kernel_fn select_crc32c(const cpu::features_t &f) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_X86
+    if (f.sse42) return crc32c_x86;
+#elif SABUROU_PLATFORM_V2_CRC_ARM
+    if (f.arm_crc32) return arm::crc<true>;
+#endif
+    (void)f;
+    return crc_slice8<crc32c_poly>;
+}
+
+/** @brief Picks the CRC-32 (IEEE) kernel for @p f. */
+[[nodiscard]] inline crc_kernel_fn select_crc32(const cpu::features_t &f) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_X86
+    if (f.pclmul && f.sse41) return crc32_x86;
+#elif SABUROU_PLATFORM_V2_CRC_ARM
+    if (f.arm_crc32) return arm::crc<false>;
+#endif
+    (void)f;
+    return crc_slice8<crc32_poly>;
+}
+
+/** @brief crc_a followed by len_b bytes whose CRC is crc_b, for finalized (post-xor) values. */
+[[nodiscard]] constexpr uint32_t crc_combine(uint32_t crc_a, uint32_t crc_b, uint64_t len_b, uint32_t poly) noexcept {
+    // The 0xFFFFFFFF pre/post conditioning cancels out, leaving shift(crc_a) ^ crc_b.
+    return crc_shift(crc_a, len_b, poly) ^ crc_b;
+}
+
+} // namespace detail
+
+/**
+ * @brief CRC-32C (Castagnoli) of @p n bytes, continuing from @p crc (0 to start).
+ * * SSE4.2 crc32 with 3-way interleaving, VPCLMULQDQ folding for inputs of 1 KiB or more on AVX-512
+ * CPUs, ARMv8 CRC32 instructions, or slicing-by-8 tables.
+ */
+[[nodiscard]] inline uint32_t crc32c(const void *data, std::size_t n, uint32_t crc = 0) noexcept {
+    static const detail::crc_kernel_fn kernel = detail::select_crc32c(cpu::features());
+    return ~kernel(~crc, static_cast<const unsigned char *>(data), n);
+}
+
+/** @brief CRC-32C of a byte span, continuing from @p crc. */
+[[nodiscard]] inline uint32_t crc32c(std::span<const std::byte> data, uint32_t crc = 0) noexcept {
+    return crc32c(data.data(), data.size(), crc);
+}
+
+/**
+ * @brief CRC-32 (IEEE 802.3, as in zlib, gzip and PNG) of @p n bytes, continuing from @p crc (0 to start).
+ * * PCLMULQDQ folding (VPCLMULQDQ from 1 KiB on AVX-512 CPUs), ARMv8 CRC32 instructions, or slicing-by-8.
+ */
+[[nodiscard]] inline uint32_t crc32(const void *data, std::size_t n, uint32_t crc = 0) noexcept {
+    static const detail::crc_kernel_fn kernel = detail::select_crc32(cpu::features());
+    return ~kernel(~crc, static_cast<const unsigned char *>(data), n);
+}
+
+/** @brief CRC-32 (IEEE) of a byte span, continuing from @p crc. */
+[[nodiscard]] inline uint32_t crc32(std::span<const std::byte> data, uint32_t crc = 0) noexcept {
+    return crc32(data.data(), data.size(), crc);
+}
+
+/**
+ * @brief CRC-32C of the concatenation A ++ B from crc32c(A), crc32c(B) and the length of B.
+ * * O(log len_b) carry-less multiplications, so chunks can be checksummed on separate threads.
+ */
+[[nodiscard]] constexpr uint32_t crc32c_combine(uint32_t crc_a, uint32_t crc_b, uint64_t len_b) noexcept {
+    return detail::crc_combine(crc_a, crc_b, len_b, detail::crc32c_poly);
+}
+
+/** @brief CRC-32 (IEEE) of A ++ B from crc32(A), crc32(B) and the length of B. */
+[[nodiscard]] constexpr uint32_t crc32_combine(uint32_t crc_a, uint32_t crc_b, uint64_t len_b) noexcept {
+    return detail::crc_combine(crc_a, crc_b, len_b, detail::crc32_poly);
+}
+
+} // namespace saburou::platform::v2::bytes
@@ -0,0 +1,317 @@
+#pragma once
+
+/**
+ * @file base64_kernels.hpp
+ * @brief Base64 encode/decode loops over complete 3-byte groups and 4-character quanta: scalar, AVX2,
+ * AVX-512 VBMI and NEON, for the standard and URL alphabets.
+ *
+ * The SIMD kernels follow Muła and Lemire: encoders gather the 6-bit fields with shuffles and multiplies
+ * (AVX2) or VPMULTISHIFTQB (VBMI) and map them to ASCII with a table; decoders classify characters by their
+ * nibbles (AVX2) or a 128-entry VPERMI2B lookup (VBMI), then merge the fields with VPMADDUBSW/VPMADDWD. The
+ * lookup tables are derived from the alphabets at compile time.
+ *
+ * Padding and partial quanta are left to the caller. Decoders stop before the first block with an invalid
+ * character (padding included) and return the characters consumed, so the scalar loop finishes the input
+ * and pinpoints the error.
+ */
+
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+#include <immintrin.h>
+#endif
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace saburou::platform::v2::bytes::detail {
+
+/** @brief The 64 characters of the standard (RFC 4648 section 4) or URL-safe (section 5) alphabet. */
+template <bool Url>
+inline constexpr char base64_chars[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+template <>
+inline constexpr char base64_chars<true>[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+/** @brief Value of each character, 0xFF outside the alphabet. */
+template <bool Url>
+inline constexpr std::array<uint8_t, 256> base64_values = [] {
+    std::array<uint8_t, 256> t{};
+    t.fill(0xFF);
+    for (unsigned i = 0; i < 64; ++i) t[static_cast<unsigned char>(base64_chars<Url>[i])] = static_cast<uint8_t>(i);
+    return t;
+}();
+
+/** @brief ASCII half of base64_values with 0x80 for invalid characters: the VBMI and NEON lookup table. */
+template <bool Url>
+inline constexpr std::array<uint8_t, 128> base64_ascii_values = [] {
+    std::array<uint8_t, 128> t{};
+    for (unsigned c = 0; c < 128; ++c) t[c] = base64_values<Url>[c] == 0xFF ? 0x80 : base64_values<Url>[c];
+    return t;
+}();
+
+namespace base64_scalar {
+
+template <bool Url> inline std::size_t encode(const unsigned char *in, std::size_t n, char *out) noexcept {
+    const char *chars = base64_chars<Url>;
+    std::size_t i = 0;
+    for (; i + 3 <= n; i += 3, out += 4) {
+        uint32_t v = uint32_t{in[i]} << 16 | uint32_t{in[i + 1]} << 8 | in[i + 2];
+        out[0] = chars[v >> 18];
+        out[1] = chars[(v >> 12) & 63];
+        out[2] = chars[(v >> 6) & 63];
+        out[3] = chars[v & 63];
+    }
+    return i;
+}
+
+/** @brief Decodes complete quanta of @p n characters; stops before the first quantum with an invalid one. */
+template <bool Url> inline std::size_t decode(const char *in, std::size_t n, unsigned char *out) noexcept {
+    const auto &values = base64_values<Url>;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4, out += 3) {
+        uint32_t a = values[static_cast<unsigned char>(in[i])], b = values[static_cast<unsigned char>(in[i + 1])];
+        uint32_t c = values[static_cast<unsigned char>(in[i + 2])], d = values[static_cast<unsigned char>(in[i + 3])];
+        if ((a | b | c | d) > 63) break;
+        uint32_t v = a << 18 | b << 12 | c << 6 | d;
+        out[0] = static_cast<unsigned char>(v >> 16);
+        out[1] = static_cast<unsigned char>(v >> 8);
+        out[2] = static_cast<unsigned char>(v);
+    }
+    return i;
+}
+
+} // namespace base64_scalar
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+/**
+ * @brief Tables of the AVX2 kernels.
+ * * encode_offsets maps the class of a 6-bit value (see base64_avx2::encode) to the distance to its character.
+ * Decoding checks lo[c & 15] & hi[c >> 4] == 0 for valid characters, adds roll[c >> 4] to each one, and
+ * patches the one character whose distance differs from the rest of its high nibble ('/' or '_').
+ */
+struct base64_avx2_luts_t {
+    alignas(16) uint8_t encode_offsets[16];
+    alignas(16) uint8_t lo[16];
+    alignas(16) uint8_t hi[16];
+    alignas(16) uint8_t roll[16];
+    char special;
+};
+
+template <bool Url>
+inline constexpr base64_avx2_luts_t base64_avx2_luts = [] {
+    const char *chars = base64_chars<Url>;
+    const auto &values = base64_values<Url>;
+    base64_avx2_luts_t t{};
+    auto offset = [&](unsigned v) { return static_cast<uint8_t>(static_cast<unsigned char>(chars[v]) - v); };
+    t.encode_offsets[0] = offset(26);
+    for (unsigned k = 1; k <= 10; ++k) t.encode_offsets[k] = offset(52);
+    t.encode_offsets[11] = offset(62);
+    t.encode_offsets[12] = offset(63);
+    t.encode_offsets[13] = offset(0);
+    t.special = chars[63];
+
+    // One bit per high nibble with mixed validity, bit 0 for high nibbles without any valid character.
+    uint8_t next = 2;
+    for (unsigned h = 0; h < 16; ++h) {
+        bool any = false;
+        for (unsigned l = 0; l < 16; ++l) any |= values[h << 4 | l] != 0xFF;
+        if (!any) {
+            t.hi[h] = 1;
+            continue;
+        }
+        t.hi[h] = next;
+        for (unsigned l = 0; l < 16; ++l) {
+            unsigned c = h << 4 | l;
+            if (values[c] == 0xFF) t.lo[l] |= next;
+            else if (static_cast<char>(c) != t.special) t.roll[h] = static_cast<uint8_t>(values[c] - c);
+        }
+        next = static_cast<uint8_t>(next << 1);
+    }
+    for (auto &lo : t.lo) lo |= 1;
+    return t;
+}();
+
+namespace base64_avx2 {
+
+/** @brief A 16-byte table in both 128-bit lanes, for VPSHUFB. */
+SABUROU_PLATFORM_V2_TARGET("avx2") inline __m256i load_lut(const uint8_t *p) noexcept {
+    return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(p)));
+}
+
+template <bool Url>
+SABUROU_PLATFORM_V2_TARGET("avx2")
+inline std::size_t encode(const unsigned char *in, std::size_t n, char *out) noexcept {
+    const auto &luts = base64_avx2_luts<Url>;
+    const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, //
+                                             1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = load_lut(luts.encode_offsets);
+    std::size_t i = 0;
+    // 24 bytes per step, 12 per 128-bit lane; the second load reads 4 bytes past them.
+    for (; i + 28 <= n; i += 24, out += 32) {
+        __m256i v = _mm256_set_m128i(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 12)),
+                                     _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)));
+        v = _mm256_shuffle_epi8(v, shuffle);
+        // Each 32-bit lane now holds bytes [b1 b0 b2 b1]; split it into four 6-bit values, one per byte.
+        __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00)),
+                                        _mm256_set1_epi32(0x04000040));
+        __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0)),
+                                        _mm256_set1_epi32(0x01000010));
+        __m256i idx = _mm256_or_si256(t0, t1);
+        // Class: 0 for 26..51, 1..12 for 52..63, 13 for 0..25.
+        __m256i cls = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+        cls = _mm256_or_si256(cls, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx),
+                                                    _mm256_set1_epi8(13)));
+        __m256i chars = _mm256_add_epi8(idx, _mm256_shuffle_epi8(offsets, cls));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), chars);
+    }
+    return i;
+}
+
+/** @brief Decodes 32 characters at a time while @p room allows the 32-byte store. */
+template <bool Url>
+SABUROU_PLATFORM_V2_TARGET("avx2")
+inline std::size_t decode(const char *in, std::size_t n, unsigned char *out, std::size_t room) noexcept {
+    const auto &luts = base64_avx2_luts<Url>;
+    const __m256i lut_lo = load_lut(luts.lo), lut_hi = load_lut(luts.hi), lut_roll = load_lut(luts.roll);
+    const __m256i low4 = _mm256_set1_epi8(0x0F), special = _mm256_set1_epi8(luts.special);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, //
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    std::size_t i = 0;
+    for (; i + 32 <= n && room >= 32; i += 32, out += 24, room -= 24) {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(c, 4), low4);
+        __m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(c, low4));
+        if (!_mm256_testz_si256(lo, _mm256_shuffle_epi8(lut_hi, hi_nibbles))) break;
+        __m256i v = _mm256_add_epi8(c, _mm256_shuffle_epi8(lut_roll, hi_nibbles));
+        v = _mm256_blendv_epi8(v, _mm256_set1_epi8(63), _mm256_cmpeq_epi8(c, special));
+        // Merge 4 x 6 bits into 24 bits per 32-bit lane, then gather the 3 bytes of each lane.
+        v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+        v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+        v = _mm256_shuffle_epi8(v, pack);
+        v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), v);
+    }
+    return i;
+}
+
+} // namespace base64_avx2
+
+/** @brief Output byte j of a 48-byte block is byte 2 - j % 3 of 32-bit lane j / 3. */
+inline constexpr std::array<uint8_t, 64> base64_vbmi_pack = [] {
+    std::array<uint8_t, 64> t{};
+    for (unsigned j = 0; j < 48; ++j) t[j] = static_cast<uint8_t>(4 * (j / 3) + 2 - j % 3);
+    return t;
+}();
+
+/** @brief Input byte feeding each output byte of the VBMI encoder: [b1 b0 b2 b1] per 3-byte group. */
+inline constexpr std::array<uint8_t, 64> base64_vbmi_spread = [] {
+    std::array<uint8_t, 64> t{};
+    for (unsigned g = 0; g < 16; ++g) {
+        t[4 * g] = static_cast<uint8_t>(3 * g + 1);
+        t[4 * g + 1] = static_cast<uint8_t>(3 * g);
+        t[4 * g + 2] = static_cast<uint8_t>(3 * g + 2);
+        t[4 * g + 3] = static_cast<uint8_t>(3 * g + 1);
+    }
+    return t;
+}();
+
+// Full-mask maskz forms, as in xxh3_kernels.hpp: the unmasked VBMI intrinsics trip GCC 12's -Wuninitialized.
+namespace base64_vbmi {
+
+template <bool Url>
+SABUROU_PLATFORM_V2_TARGET("avx512f,avx512bw,avx512vbmi")
+inline std::size_t encode(const unsigned char *in, std::size_t n, char *out) noexcept {
+    const __m512i alphabet = _mm512_loadu_si512(base64_chars<Url>);
+    const __m512i spread = _mm512_loadu_si512(base64_vbmi_spread.data());
+    // Bit offsets of the four 6-bit fields of each 32-bit lane, in output order.
+    const __m512i fields = _mm512_set1_epi64(0x3036242a1016040a);
+    std::size_t i = 0;
+    for (; i + 48 <= n; i += 48, out += 64) {
+        __m512i v = _mm512_maskz_loadu_epi8(0x0000FFFFFFFFFFFFull, in + i);
+        v = _mm512_maskz_permutexvar_epi8(~0ull, spread, v);
+        __m512i idx = _mm512_maskz_multishift_epi64_epi8(~0ull, fields, v);
+        _mm512_storeu_si512(out, _mm512_maskz_permutexvar_epi8(~0ull, idx, alphabet));
+    }
+    return i;
+}
+
+template <bool Url>
+SABUROU_PLATFORM_V2_TARGET("avx512f,avx512bw,avx512vbmi")
+inline std::size_t decode(const char *in, std::size_t n, unsigned char *out, std::size_t) noexcept {
+    const __m512i lut0 = _mm512_loadu_si512(base64_ascii_values<Url>.data());
+    const __m512i lut1 = _mm512_loadu_si512(base64_ascii_values<Url>.data() + 64);
+    const __m512i pack = _mm512_loadu_si512(base64_vbmi_pack.data());
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64, out += 48) {
+        __m512i c = _mm512_loadu_si512(in + i);
+        __m512i v = _mm512_permutex2var_epi8(lut0, c, lut1);
+        // Bit 7 flags characters outside the alphabet, and bytes >= 0x80 in the input itself.
+        if (_mm512_movepi8_mask(_mm512_or_si512(v, c))) break;
+        v = _mm512_maddubs_epi16(v, _mm512_set1_epi32(0x01400140));
+        v = _mm512_madd_epi16(v, _mm512_set1_epi32(0x00011000));
+        _mm512_mask_storeu_epi8(out, 0x0000FFFFFFFFFFFFull, _mm512_maskz_permutexvar_epi8(~0ull, pack, v));
+    }
+    return i;
+}
+
+} // namespace base64_vbmi
+#endif
+
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+namespace base64_neon {
+
+/** @brief The alphabet or value table as four 16-byte registers, for TBL over 64 entries. */
+inline uint8x16x4_t load_table(const uint8_t *p) noexcept {
+    return {{vld1q_u8(p), vld1q_u8(p + 16), vld1q_u8(p + 32), vld1q_u8(p + 48)}};
+}
+
+template <bool Url> inline std::size_t encode(const unsigned char *in, std::size_t n, char *out) noexcept {
+    const uint8x16x4_t alphabet = load_table(reinterpret_cast<const uint8_t *>(base64_chars<Url>));
+    const uint8x16_t six = vdupq_n_u8(0x3F);
+    std::size_t i = 0;
+    for (; i + 48 <= n; i += 48, out += 64) {
+        uint8x16x3_t v = vld3q_u8(in + i); // De-interleaved: byte 0, 1 and 2 of 16 groups.
+        uint8x16x4_t r;
+        r.val[0] = vshrq_n_u8(v.val[0], 2);
+        r.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(v.val[0], 4), vshrq_n_u8(v.val[1], 4)), six);
+        r.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(v.val[1], 2), vshrq_n_u8(v.val[2], 6)), six);
+        r.val[3] = vandq_u8(v.val[2], six);
+        for (auto &x : r.val) x = vqtbl4q_u8(alphabet, x);
+        vst4q_u8(reinterpret_cast<uint8_t *>(out), r);
+    }
+    return i;
+}
+
+template <bool Url>
+inline std::size_t decode(const char *in, std::size_t n, unsigned char *out, std::size_t) noexcept {
+    const uint8x16x4_t lut0 = load_table(base64_ascii_values<Url>.data());
+    const uint8x16x4_t lut1 = load_table(base64_ascii_values<Url>.data() + 64);
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64, out += 48) {
+        uint8x16x4_t c = vld4q_u8(reinterpret_cast<const uint8_t *>(in + i));
+        uint8x16_t bad = vdupq_n_u8(0);
+        uint8x16x4_t v;
+        for (int k = 0; k < 4; ++k) {
+            // Out-of-range TBL indices give 0, so each character hits exactly one of the two halves.
+            v.val[k] = vorrq_u8(vqtbl4q_u8(lut0, c.val[k]), vqtbl4q_u8(lut1, vsubq_u8(c.val[k], vdupq_n_u8(64))));
+            bad = vorrq_u8(bad, vorrq_u8(v.val[k], c.val[k]));
+        }
+        if (vmaxvq_u8(bad) & 0x80) break;
+        uint8x16x3_t r;
+        r.val[0] = vorrq_u8(vshlq_n_u8(v.val[0], 2), vshrq_n_u8(v.val[1], 4));
+        r.val[1] = vorrq_u8(vshlq_n_u8(v.val[1], 4), vshrq_n_u8(v.val[2], 2));
+        r.val[2] = vorrq_u8(vshlq_n_u8(v.val[2], 6), v.val[3]);
+        vst3q_u8(out, r);
+    }
+    return i;
+}
+
+} // namespace base64_neon
+#endif
+
+} // namespace saburou::platform::v2::bytes::detail
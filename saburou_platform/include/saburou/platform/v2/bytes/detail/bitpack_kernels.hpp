@@ -0,0 +1,282 @@
+#pragma once
+
+/**
+ * @file bitpack_kernels.hpp
+ * @brief Bit-packing kernels for blocks of 32 x L integers in L interleaved 32-bit lanes (SIMD-BP128 layout),
+ * one fully unrolled instantiation per bit width and lane count.
+ *
+ * Row r of a block holds values r*L .. r*L + L-1, one per lane, and each lane packs its 32 values into
+ * consecutive 32-bit little-endian words stored lane-interleaved. Packing and unpacking are thus the same
+ * shifts and masks applied to every lane, which the kernels express once over a lane vector type:
+ * - bitpack_lanes<L>: portable per-lane loops, used on big-endian hosts and compilers without vector types.
+ * - GCC/Clang vector types (bitpack_v4, bitpack_v8): lowered to SSE2/NEON by default and to AVX2 inside
+ *   the target-attributed entry points, without intrinsics, so the same template serves every ISA.
+ */
+
+#include <saburou/platform/v2/bytes/endian/little.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+#include <saburou/platform/v2/detect.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if SABUROU_PLATFORM_V2_GCC || SABUROU_PLATFORM_V2_CLANG
+#define SABUROU_PLATFORM_V2_BITPACK_VECTOR_TYPES 1
+#define SABUROU_PLATFORM_V2_BITPACK_INLINE [[gnu::always_inline]] inline
+#else
+#define SABUROU_PLATFORM_V2_BITPACK_VECTOR_TYPES 0
+#define SABUROU_PLATFORM_V2_BITPACK_INLINE inline
+#endif
+
+namespace saburou::platform::v2::bytes::detail {
+
+/** @brief Block transforms, in the order of bitpack_mode_t. */
+inline constexpr unsigned bitpack_plain = 0, bitpack_frame = 1, bitpack_delta = 2;
+
+/** @brief Portable lane vector: element-wise operators over L words. */
+template <unsigned L> struct bitpack_lanes {
+    uint32_t w[L];
+
+#define SABUROU_PLATFORM_V2_BITPACK_LANE_OP(op)                                                                     \
+    friend bitpack_lanes operator op(bitpack_lanes a, const bitpack_lanes &b) noexcept {                            \
+        for (unsigned i = 0; i < L; ++i) a.w[i] = a.w[i] op b.w[i];                                                 \
+        return a;                                                                                                   \
+    }
+    SABUROU_PLATFORM_V2_BITPACK_LANE_OP(+)
+    SABUROU_PLATFORM_V2_BITPACK_LANE_OP(-)
+    SABUROU_PLATFORM_V2_BITPACK_LANE_OP(&)
+    SABUROU_PLATFORM_V2_BITPACK_LANE_OP(|)
+#undef SABUROU_PLATFORM_V2_BITPACK_LANE_OP
+
+    friend bitpack_lanes operator<<(bitpack_lanes a, unsigned n) noexcept {
+        for (unsigned i = 0; i < L; ++i) a.w[i] <<= n;
+        return a;
+    }
+    friend bitpack_lanes operator>>(bitpack_lanes a, unsigned n) noexcept {
+        for (unsigned i = 0; i < L; ++i) a.w[i] >>= n;
+        return a;
+    }
+};
+
+/** @brief Loads, stores and broadcasts for a lane vector type V. */
+template <class V> struct bitpack_traits;
+
+template <unsigned L> struct bitpack_traits<bitpack_lanes<L>> {
+    using vec = bitpack_lanes<L>;
+    static constexpr unsigned lanes = L;
+
+    static void splat(vec &v, uint32_t x) noexcept {
+        for (unsigned i = 0; i < L; ++i) v.w[i] = x;
+    }
+    static void load(vec &v, const uint32_t *p) noexcept { std::memcpy(v.w, p, sizeof(v.w)); }
+    static void store(uint32_t *p, const vec &v) noexcept { std::memcpy(p, v.w, sizeof(v.w)); }
+    static void load_packed(vec &v, const unsigned char *p) noexcept {
+        std::memcpy(v.w, p, sizeof(v.w));
+        for (unsigned i = 0; i < L; ++i) v.w[i] = endian::from_little(v.w[i]);
+    }
+    static void store_packed(unsigned char *p, vec v) noexcept {
+        for (unsigned i = 0; i < L; ++i) v.w[i] = endian::to_little(v.w[i]);
+        std::memcpy(p, v.w, sizeof(v.w));
+    }
+};
+
+#if SABUROU_PLATFORM_V2_BITPACK_VECTOR_TYPES
+typedef uint32_t bitpack_v4 __attribute__((vector_size(16)));
+typedef uint32_t bitpack_v8 __attribute__((vector_size(32)));
+
+/** @brief Compiler vector types; only used on little-endian hosts, where packed words need no swapping. */
+template <class V, unsigned L> struct bitpack_vector_traits {
+    using vec = V;
+    static constexpr unsigned lanes = L;
+
+    SABUROU_PLATFORM_V2_BITPACK_INLINE static void splat(vec &v, uint32_t x) noexcept { v = vec{} + x; }
+    SABUROU_PLATFORM_V2_BITPACK_INLINE static void load(vec &v, const uint32_t *p) noexcept {
+        std::memcpy(&v, p, sizeof(v));
+    }
+    SABUROU_PLATFORM_V2_BITPACK_INLINE static void store(uint32_t *p, const vec &v) noexcept {
+        std::memcpy(p, &v, sizeof(v));
+    }
+    SABUROU_PLATFORM_V2_BITPACK_INLINE static void load_packed(vec &v, const unsigned char *p) noexcept {
+        std::memcpy(&v, p, sizeof(v));
+    }
+    SABUROU_PLATFORM_V2_BITPACK_INLINE static void store_packed(unsigned char *p, const vec &v) noexcept {
+        std::memcpy(p, &v, sizeof(v));
+    }
+};
+
+template <> struct bitpack_traits<bitpack_v4> : bitpack_vector_traits<bitpack_v4, 4> {};
+template <> struct bitpack_traits<bitpack_v8> : bitpack_vector_traits<bitpack_v8, 8> {};
+#endif
+
+/** @brief Values per lane in a block. */
+inline constexpr unsigned bitpack_rows = 32;
+
+template <unsigned B> inline constexpr uint32_t bitpack_mask = B >= 32 ? 0xFFFFFFFFu : (uint32_t{1} << B) - 1;
+
+// -- Unpacking: row I reads word (I*B)/32 of each lane, plus the next one when the value straddles both. --
+
+template <class V, unsigned B, unsigned M, unsigned I>
+SABUROU_PLATFORM_V2_BITPACK_INLINE void unpack_row(const unsigned char *in, uint32_t *out, V &acc) noexcept {
+    using T = bitpack_traits<V>;
+    constexpr unsigned bytes = 4 * T::lanes, word = I * B / 32, shift = I * B % 32;
+    V v;
+    if constexpr (B == 0) {
+        T::splat(v, 0);
+    } else {
+        T::load_packed(v, in + word * bytes);
+        if constexpr (shift != 0) v = v >> shift;
+        if constexpr (shift + B > 32) {
+            V next;
+            T::load_packed(next, in + (word + 1) * bytes);
+            v = v | (next << (32 - shift));
+        }
+        if constexpr (B < 32) {
+            V mask;
+            T::splat(mask, bitpack_mask<B>);
+            v = v & mask;
+        }
+    }
+    if constexpr (M == bitpack_delta) {
+        acc = acc + v;
+        T::store(out + I * T::lanes, acc);
+    } else if constexpr (M == bitpack_frame) {
+        T::store(out + I * T::lanes, v + acc);
+    } else {
+        T::store(out + I * T::lanes, v);
+    }
+}
+
+template <class V, unsigned B, unsigned M, unsigned... I>
+SABUROU_PLATFORM_V2_BITPACK_INLINE void unpack_rows(const unsigned char *in, uint32_t *out, uint32_t base,
+                                                    std::integer_sequence<unsigned, I...>) noexcept {
+    V acc;
+    bitpack_traits<V>::splat(acc, base);
+    (unpack_row<V, B, M, I>(in, out, acc), ...);
+}
+
+template <class V, unsigned B, unsigned M>
+SABUROU_PLATFORM_V2_BITPACK_INLINE void unpack_block(const unsigned char *in, uint32_t *out, uint32_t base) noexcept {
+    unpack_rows<V, B, M>(in, out, base, std::make_integer_sequence<unsigned, bitpack_rows>{});
+}
+
+// -- Packing: values are ORed into the current word of each lane, which is stored once full. --
+
+template <class V, unsigned B, unsigned M, unsigned I>
+SABUROU_PLATFORM_V2_BITPACK_INLINE void pack_row(const uint32_t *in, unsigned char *out, V &word, V &prev) noexcept {
+    using T = bitpack_traits<V>;
+    constexpr unsigned bytes = 4 * T::lanes, index = I * B / 32, shift = I * B % 32;
+    V v;
+    T::load(v, in + I * T::lanes);
+    if constexpr (M == bitpack_delta) {
+        V current = v;
+        v = v - prev;
+        prev = current;
+    } else if constexpr (M == bitpack_frame) {
+        v = v - prev;
+    }
+    if constexpr (B < 32) {
+        V mask;
+        T::splat(mask, bitpack_mask<B>);
+        v = v & mask;
+    }
+    if constexpr (shift == 0) word = v;
+    else word = word | (v << shift);
+    if constexpr (shift + B >= 32) {
+        T::store_packed(out + index * bytes, word);
+        if constexpr (shift + B > 32) word = v >> (32 - shift);
+    }
+}
+
+template <class V, unsigned B, unsigned M, unsigned... I>
+SABUROU_PLATFORM_V2_BITPACK_INLINE void pack_rows(const uint32_t *in, unsigned char *out, uint32_t base,
+                                                  std::integer_sequence<unsigned, I...>) noexcept {
+    V word, prev;
+    bitpack_traits<V>::splat(word, 0);
+    bitpack_traits<V>::splat(prev, base);
+    (pack_row<V, B, M, I>(in, out, word, prev), ...);
+}
+
+template <class V, unsigned B, unsigned M>
+SABUROU_PLATFORM_V2_BITPACK_INLINE void pack_block(const uint32_t *in, unsigned char *out, uint32_t base) noexcept {
+    if constexpr (B != 0) pack_rows<V, B, M>(in, out, base, std::make_integer_sequence<unsigned, bitpack_rows>{});
+}
+
+// -- Entry points: one function per (lane type, width, mode), collected into 33-entry tables by width. --
+
+using bitpack_fn = void (*)(const uint32_t *, unsigned char *, uint32_t) noexcept;
+using bitunpack_fn = void (*)(const unsigned char *, uint32_t *, uint32_t) noexcept;
+
+/** @brief Kernels of one lane type: [mode][bits]. */
+struct bitpack_table_t {
+    std::array<std::array<bitpack_fn, 33>, 3> pack;
+    std::array<std::array<bitunpack_fn, 33>, 3> unpack;
+};
+
+template <class V, unsigned B, unsigned M>
+inline void bitpack_entry(const uint32_t *in, unsigned char *out, uint32_t base) noexcept {
+    pack_block<V, B, M>(in, out, base);
+}
+
+template <class V, unsigned B, unsigned M>
+inline void bitunpack_entry(const unsigned char *in, uint32_t *out, uint32_t base) noexcept {
+    unpack_block<V, B, M>(in, out, base);
+}
+
+#if SABUROU_PLATFORM_V2_SIMD_X86 && SABUROU_PLATFORM_V2_BITPACK_VECTOR_TYPES
+/** @brief 8-lane kernels compiled for AVX2; the inlined templates inherit the target from here. */
+template <unsigned B, unsigned M>
+SABUROU_PLATFORM_V2_TARGET("avx2") inline void bitpack_avx2(const uint32_t *in, unsigned char *out,
+                                                             uint32_t base) noexcept {
+    pack_block<bitpack_v8, B, M>(in, out, base);
+}
+
+template <unsigned B, unsigned M>
+SABUROU_PLATFORM_V2_TARGET("avx2") inline void bitunpack_avx2(const unsigned char *in, uint32_t *out,
+                                                               uint32_t base) noexcept {
+    unpack_block<bitpack_v8, B, M>(in, out, base);
+}
+#endif
+
+/** @brief Table of Entries<B, M>::pack/unpack for every width B and mode M. */
+template <template <unsigned, unsigned> class Entries, unsigned... B>
+[[nodiscard]] constexpr bitpack_table_t make_bitpack_table(std::integer_sequence<unsigned, B...>) noexcept {
+    return {{{{Entries<B, bitpack_plain>::pack...},
+              {Entries<B, bitpack_frame>::pack...},
+              {Entries<B, bitpack_delta>::pack...}}},
+            {{{Entries<B, bitpack_plain>::unpack...},
+              {Entries<B, bitpack_frame>::unpack...},
+              {Entries<B, bitpack_delta>::unpack...}}}};
+}
+
+template <class V> struct bitpack_generic_entries {
+    template <unsigned B, unsigned M> struct of {
+        static constexpr bitpack_fn pack = bitpack_entry<V, B, M>;
+        static constexpr bitunpack_fn unpack = bitunpack_entry<V, B, M>;
+    };
+};
+
+#if SABUROU_PLATFORM_V2_SIMD_X86 && SABUROU_PLATFORM_V2_BITPACK_VECTOR_TYPES
+template <unsigned B, unsigned M> struct bitpack_avx2_entries {
+    static constexpr bitpack_fn pack = bitpack_avx2<B, M>;
+    static constexpr bitunpack_fn unpack = bitunpack_avx2<B, M>;
+};
+#endif
+
+template <class V>
+inline constexpr bitpack_table_t bitpack_generic_table =
+    make_bitpack_table<bitpack_generic_entries<V>::template of>(std::make_integer_sequence<unsigned, 33>{});
+
+/** @brief Lane vector type the default-target kernels use for L lanes. */
+#if SABUROU_PLATFORM_V2_BITPACK_VECTOR_TYPES
+template <unsigned L>
+using bitpack_default_vec = std::conditional_t<!endian::is_little, bitpack_lanes<L>,
+                                               std::conditional_t<L == 4, bitpack_v4, bitpack_v8>>;
+#else
+template <unsigned L> using bitpack_default_vec = bitpack_lanes<L>;
+#endif
+
+} // namespace saburou::platform::v2::bytes::detail
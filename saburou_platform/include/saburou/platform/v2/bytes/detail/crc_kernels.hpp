@@ -0,0 +1,353 @@
+#pragma once
+
+/**
+ * @file crc_kernels.hpp
+ * @brief CRC-32 kernels: slicing-by-8 tables, SSE4.2 and ARMv8 CRC instructions with 3-way interleaving,
+ * and PCLMULQDQ/VPCLMULQDQ folding.
+ *
+ * Kernels work on the raw (reflected) CRC register: callers apply the ~crc pre/post conditioning.
+ * Polynomials are given in reflected form: 0x82F63B78 (Castagnoli, CRC-32C) and 0xEDB88320 (IEEE 802.3).
+ */
+
+#include <saburou/platform/v2/bytes/endian/little.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+#include <saburou/platform/v2/detect.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+#include <immintrin.h>
+#endif
+#if SABUROU_PLATFORM_V2_SIMD_NEON && (defined(__ARM_FEATURE_CRC32) || SABUROU_PLATFORM_V2_HAS_TARGET_ATTRIBUTE)
+#include <arm_acle.h>
+#define SABUROU_PLATFORM_V2_CRC_ARM 1
+#else
+#define SABUROU_PLATFORM_V2_CRC_ARM 0
+#endif
+
+namespace saburou::platform::v2::bytes::detail {
+
+inline constexpr uint32_t crc32c_poly = 0x82F63B78u;
+inline constexpr uint32_t crc32_poly = 0xEDB88320u;
+
+// -- GF(2) arithmetic modulo the CRC polynomial, in the reflected bit order of the register. --
+
+/** @brief a * b mod P (both reflected, x^0 in the top bit). */
+[[nodiscard]] constexpr uint32_t crc_multiply(uint32_t a, uint32_t b, uint32_t poly) noexcept {
+    uint32_t product = 0;
+    for (uint32_t m = 0x80000000u; m; m >>= 1) {
+        if (a & m) product ^= b;
+        b = (b & 1) ? (b >> 1) ^ poly : b >> 1;
+    }
+    return product;
+}
+
+/** @brief x^n mod P, reflected. */
+[[nodiscard]] constexpr uint32_t crc_x_pow(uint64_t n, uint32_t poly) noexcept {
+    uint32_t result = 0x80000000u, square = 0x40000000u; // x^0, x^1
+    for (; n; n >>= 1) {
+        if (n & 1) result = crc_multiply(result, square, poly);
+        square = crc_multiply(square, square, poly);
+    }
+    return result;
+}
+
+/** @brief CRC register after appending @p bytes zero bytes: crc * x^(8 * bytes) mod P. */
+[[nodiscard]] constexpr uint32_t crc_shift(uint32_t crc, uint64_t bytes, uint32_t poly) noexcept {
+    return crc_multiply(crc, crc_x_pow(8 * bytes, poly), poly);
+}
+
+// -- Slicing-by-8 --
+
+using crc_table_t = std::array<std::array<uint32_t, 256>, 8>;
+
+[[nodiscard]] constexpr crc_table_t make_crc_tables(uint32_t poly) noexcept {
+    crc_table_t t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c & 1) ? (c >> 1) ^ poly : c >> 1;
+        t[0][i] = c;
+    }
+    for (std::size_t k = 1; k < 8; ++k) {
+        for (std::size_t i = 0; i < 256; ++i) t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+    }
+    return t;
+}
+
+template <uint32_t Poly> inline constexpr crc_table_t crc_tables = make_crc_tables(Poly);
+
+/** @brief Portable kernel: eight table lookups per 8 bytes. */
+template <uint32_t Poly>
+[[nodiscard]] inline uint32_t crc_slice8(uint32_t crc, const unsigned char *p, std::size_t n) noexcept {
+    const auto &t = crc_tables<Poly>;
+    for (; n >= 8; n -= 8, p += 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        v = endian::from_little(v) ^ crc;
+        crc = t[7][v & 0xFF] ^ t[6][(v >> 8) & 0xFF] ^ t[5][(v >> 16) & 0xFF] ^ t[4][(v >> 24) & 0xFF] ^
+              t[3][(v >> 32) & 0xFF] ^ t[2][(v >> 40) & 0xFF] ^ t[1][(v >> 48) & 0xFF] ^ t[0][v >> 56];
+    }
+    for (; n; --n, ++p) crc = t[0][(crc ^ *p) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+// -- 3-way interleaving: three independent CRC chains hide the 3-cycle latency of the CRC instruction. --
+
+/** @brief Stripe lane length for the interleaved kernels. */
+inline constexpr std::size_t crc_lane_bytes = 256;
+
+/** @brief Multiplication by a fixed x^k, as four byte-indexed tables (the map is linear over GF(2)). */
+struct crc_shift_table_t {
+    std::array<std::array<uint32_t, 256>, 4> t{};
+
+    [[nodiscard]] constexpr uint32_t operator()(uint32_t crc) const noexcept {
+        return t[0][crc & 0xFF] ^ t[1][(crc >> 8) & 0xFF] ^ t[2][(crc >> 16) & 0xFF] ^ t[3][crc >> 24];
+    }
+};
+
+[[nodiscard]] constexpr crc_shift_table_t make_shift_table(uint64_t bytes, uint32_t poly) noexcept {
+    crc_shift_table_t s{};
+    uint32_t k = crc_x_pow(8 * bytes, poly);
+    for (uint32_t i = 0; i < 4; ++i) {
+        for (uint32_t b = 0; b < 256; ++b) s.t[i][b] = crc_multiply(b << (8 * i), k, poly);
+    }
+    return s;
+}
+
+/** @brief Shifts by one and by two lanes. */
+template <uint32_t Poly> inline constexpr crc_shift_table_t crc_shift_1 = make_shift_table(crc_lane_bytes, Poly);
+template <uint32_t Poly> inline constexpr crc_shift_table_t crc_shift_2 = make_shift_table(2 * crc_lane_bytes, Poly);
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+namespace sse42 {
+
+SABUROU_PLATFORM_V2_TARGET("sse4.2")
+[[nodiscard]] inline uint32_t step8(uint32_t crc, const unsigned char *p) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+#if SABUROU_PLATFORM_V2_ARCH_X86_64
+    return static_cast<uint32_t>(_mm_crc32_u64(crc, v));
+#else
+    crc = _mm_crc32_u32(crc, static_cast<uint32_t>(v));
+    return _mm_crc32_u32(crc, static_cast<uint32_t>(v >> 32));
+#endif
+}
+
+/** @brief CRC-32C with the SSE4.2 crc32 instruction. */
+SABUROU_PLATFORM_V2_TARGET("sse4.2")
+[[nodiscard]] inline uint32_t crc32c(uint32_t crc, const unsigned char *p, std::size_t n) noexcept {
+    constexpr std::size_t lane = crc_lane_bytes;
+    for (; n >= 3 * lane; n -= 3 * lane, p += 3 * lane) {
+        uint32_t c0 = crc, c1 = 0, c2 = 0;
+        for (std::size_t i = 0; i < lane; i += 8) {
+            c0 = step8(c0, p + i);
+            c1 = step8(c1, p + lane + i);
+            c2 = step8(c2, p + 2 * lane + i);
+        }
+        crc = crc_shift_2<crc32c_poly>(c0) ^ crc_shift_1<crc32c_poly>(c1) ^ c2;
+    }
+    for (; n >= 8; n -= 8, p += 8) crc = step8(crc, p);
+    for (; n; --n, ++p) crc = _mm_crc32_u8(crc, *p);
+    return crc;
+}
+
+} // namespace sse42
+
+/**
+ * @brief Folding constants for one polynomial (Intel, "Fast CRC Computation Using PCLMULQDQ").
+ * * fold_N holds x^(8N+32) and x^(8N-32) mod P, reflected and shifted left by one, for folding a
+ * 128-bit lane forward by N bytes.
+ */
+struct crc_fold_constants_t {
+    uint64_t fold_64[2];
+    uint64_t fold_16[2];
+    uint64_t fold_256[2];
+    uint64_t k5;      ///< x^64 mod P
+    uint64_t poly;    ///< P, reflected, 33 bits
+    uint64_t mu;      ///< floor(x^64 / P), reflected, 33 bits
+};
+
+[[nodiscard]] constexpr uint64_t reflect_bits(uint64_t v, int bits) noexcept {
+    uint64_t r = 0;
+    for (int i = 0; i < bits; ++i) r |= ((v >> i) & 1) << (bits - 1 - i);
+    return r;
+}
+
+[[nodiscard]] constexpr crc_fold_constants_t make_fold_constants(uint32_t poly) noexcept {
+    auto k = [poly](uint64_t bits) { return uint64_t{crc_x_pow(bits, poly)} << 1; };
+    uint64_t normal = reflect_bits(poly, 32) | (uint64_t{1} << 32);
+    // Barrett constant: long division of x^64 by P in normal bit order, one dividend bit at a time.
+    uint64_t quotient = 0, rem = 0;
+    for (int i = 64; i >= 0; --i) {
+        rem = (rem << 1) | (i == 64 ? 1 : 0);
+        quotient <<= 1;
+        if ((rem >> 32) & 1) {
+            rem ^= normal;
+            quotient |= 1;
+        }
+    }
+    return {{k(4 * 128 + 32), k(4 * 128 - 32)},
+            {k(128 + 32), k(128 - 32)},
+            {k(16 * 128 + 32), k(16 * 128 - 32)},
+            k(64),
+            reflect_bits(normal, 33),
+            reflect_bits(quotient, 33)};
+}
+
+template <uint32_t Poly> inline constexpr crc_fold_constants_t crc_fold_constants = make_fold_constants(Poly);
+
+namespace pclmul {
+
+SABUROU_PLATFORM_V2_TARGET("sse4.1,pclmul")
+[[nodiscard]] inline __m128i fold(__m128i x, __m128i k, __m128i data) noexcept {
+    __m128i lo = _mm_clmulepi64_si128(x, k, 0x00), hi = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(lo, hi), data);
+}
+
+SABUROU_PLATFORM_V2_TARGET("sse4.1,pclmul")
+[[nodiscard]] inline __m128i load(const unsigned char *p) noexcept { return _mm_loadu_si128((const __m128i *)p); }
+
+SABUROU_PLATFORM_V2_TARGET("sse4.1,pclmul")
+[[nodiscard]] inline __m128i pair(const uint64_t (&k)[2]) noexcept {
+    return _mm_set_epi64x(static_cast<long long>(k[1]), static_cast<long long>(k[0]));
+}
+
+/**
+ * @brief Continues folding from four 128-bit lanes that stand for the preceding 64 bytes.
+ * @param n Remaining bytes, a multiple of 16.
+ * @return The raw CRC register after all input.
+ */
+SABUROU_PLATFORM_V2_TARGET("sse4.1,pclmul")
+[[nodiscard]] inline uint32_t fold_from(__m128i x1, __m128i x2, __m128i x3, __m128i x4, const unsigned char *p,
+                                        std::size_t n, const crc_fold_constants_t &c) noexcept {
+    __m128i k = pair(c.fold_64);
+    for (; n >= 64; n -= 64, p += 64) {
+        x1 = fold(x1, k, load(p));
+        x2 = fold(x2, k, load(p + 16));
+        x3 = fold(x3, k, load(p + 32));
+        x4 = fold(x4, k, load(p + 48));
+    }
+    k = pair(c.fold_16);
+    x1 = fold(x1, k, x2);
+    x1 = fold(x1, k, x3);
+    x1 = fold(x1, k, x4);
+    for (; n >= 16; n -= 16, p += 16) x1 = fold(x1, k, load(p));
+
+    // 128 -> 64 bits.
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    __m128i x2r = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2r);
+    __m128i k5 = _mm_set_epi64x(0, static_cast<long long>(c.k5));
+    x2r = _mm_srli_si128(x1, 4);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k5, 0x00), x2r);
+    // Barrett reduction to 32 bits.
+    __m128i pm = _mm_set_epi64x(static_cast<long long>(c.mu), static_cast<long long>(c.poly));
+    x2r = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), pm, 0x10);
+    x2r = _mm_clmulepi64_si128(_mm_and_si128(x2r, mask32), pm, 0x00);
+    return static_cast<uint32_t>(_mm_extract_epi32(_mm_xor_si128(x1, x2r), 1));
+}
+
+/**
+ * @brief Folds @p n bytes (n >= 64, multiple of 16) with 128-bit PCLMULQDQ.
+ */
+SABUROU_PLATFORM_V2_TARGET("sse4.1,pclmul")
+[[nodiscard]] inline uint32_t fold_crc(uint32_t crc, const unsigned char *p, std::size_t n,
+                                       const crc_fold_constants_t &c) noexcept {
+    __m128i x1 = _mm_xor_si128(load(p), _mm_cvtsi32_si128(static_cast<int>(crc)));
+    return fold_from(x1, load(p + 16), load(p + 32), load(p + 48), p + 64, n - 64, c);
+}
+
+} // namespace pclmul
+
+namespace vpclmul {
+
+SABUROU_PLATFORM_V2_TARGET("avx512f,avx512vl,vpclmulqdq,pclmul,sse4.1")
+[[nodiscard]] inline __m512i broadcast(const uint64_t (&k)[2]) noexcept {
+    auto lo = static_cast<long long>(k[0]), hi = static_cast<long long>(k[1]);
+    return _mm512_set_epi64(hi, lo, hi, lo, hi, lo, hi, lo);
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx512f,avx512vl,vpclmulqdq,pclmul,sse4.1")
+[[nodiscard]] inline __m512i fold(__m512i x, __m512i k, __m512i data) noexcept {
+    __m512i lo = _mm512_clmulepi64_epi128(x, k, 0x00), hi = _mm512_clmulepi64_epi128(x, k, 0x11);
+    return _mm512_ternarylogic_epi64(lo, hi, data, 0x96); // lo ^ hi ^ data
+}
+
+/**
+ * @brief Folds @p n bytes (n >= 256, multiple of 16) four 512-bit lanes at a time, then hands the
+ * last 64-byte state to the 128-bit kernel.
+ */
+SABUROU_PLATFORM_V2_TARGET("avx512f,avx512vl,vpclmulqdq,pclmul,sse4.1")
+[[nodiscard]] inline uint32_t fold_crc(uint32_t crc, const unsigned char *p, std::size_t n,
+                                       const crc_fold_constants_t &c) noexcept {
+    __m512i z0 = _mm512_loadu_si512(p), z1 = _mm512_loadu_si512(p + 64);
+    __m512i z2 = _mm512_loadu_si512(p + 128), z3 = _mm512_loadu_si512(p + 192);
+    z0 = _mm512_xor_si512(z0, _mm512_zextsi128_si512(_mm_cvtsi32_si128(static_cast<int>(crc))));
+    p += 256;
+    n -= 256;
+    __m512i k = broadcast(c.fold_256);
+    for (; n >= 256; n -= 256, p += 256) {
+        z0 = fold(z0, k, _mm512_loadu_si512(p));
+        z1 = fold(z1, k, _mm512_loadu_si512(p + 64));
+        z2 = fold(z2, k, _mm512_loadu_si512(p + 128));
+        z3 = fold(z3, k, _mm512_loadu_si512(p + 192));
+    }
+    k = broadcast(c.fold_64);
+    z1 = fold(z0, k, z1);
+    z2 = fold(z1, k, z2);
+    z3 = fold(z2, k, z3);
+    alignas(64) __m128i lanes[4];
+    _mm512_store_si512(lanes, z3);
+    return pclmul::fold_from(lanes[0], lanes[1], lanes[2], lanes[3], p, n, c);
+}
+
+} // namespace vpclmul
+#endif
+
+#if SABUROU_PLATFORM_V2_CRC_ARM
+namespace arm {
+
+#if SABUROU_PLATFORM_V2_CLANG
+#define SABUROU_PLATFORM_V2_TARGET_ARM_CRC SABUROU_PLATFORM_V2_TARGET("crc")
+#else
+#define SABUROU_PLATFORM_V2_TARGET_ARM_CRC SABUROU_PLATFORM_V2_TARGET("+crc")
+#endif
+
+template <bool Castagnoli>
+SABUROU_PLATFORM_V2_TARGET_ARM_CRC [[nodiscard]] inline uint32_t step8(uint32_t r, const unsigned char *q) noexcept {
+    uint64_t v;
+    std::memcpy(&v, q, 8);
+    if constexpr (Castagnoli) return __crc32cd(r, v);
+    else return __crc32d(r, v);
+}
+
+/** @brief ARMv8 CRC32 instructions, which cover both polynomials, 3-way interleaved. */
+template <bool Castagnoli>
+SABUROU_PLATFORM_V2_TARGET_ARM_CRC [[nodiscard]] inline uint32_t crc(uint32_t c, const unsigned char *p,
+                                                                      std::size_t n) noexcept {
+    constexpr uint32_t poly = Castagnoli ? crc32c_poly : crc32_poly;
+    constexpr std::size_t lane = crc_lane_bytes;
+    for (; n >= 3 * lane; n -= 3 * lane, p += 3 * lane) {
+        uint32_t c0 = c, c1 = 0, c2 = 0;
+        for (std::size_t i = 0; i < lane; i += 8) {
+            c0 = step8<Castagnoli>(c0, p + i);
+            c1 = step8<Castagnoli>(c1, p + lane + i);
+            c2 = step8<Castagnoli>(c2, p + 2 * lane + i);
+        }
+        c = crc_shift_2<poly>(c0) ^ crc_shift_1<poly>(c1) ^ c2;
+    }
+    for (; n >= 8; n -= 8, p += 8) c = step8<Castagnoli>(c, p);
+    for (; n; --n, ++p) {
+        if constexpr (Castagnoli) c = __crc32cb(c, *p);
+        else c = __crc32b(c, *p);
+    }
+    return c;
+}
+
+} // namespace arm
+#endif
+
+} // namespace saburou::platform::v2::bytes::detail
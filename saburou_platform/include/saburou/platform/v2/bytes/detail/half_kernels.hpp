@@ -0,0 +1,310 @@
+#pragma once
+
+/**
+ * @file half_kernels.hpp
+ * @brief Bulk fp16/bf16 <-> fp32 conversion loops: scalar, F16C/AVX2, AVX-512 and NEON.
+ *
+ * Halves are read and written as raw bytes (unaligned, host order) so the same loops serve typed arrays and
+ * file buffers; the @c Swap instantiations byte-swap every half on the way, for data in the other byte order.
+ * Narrowing rounds to nearest, ties to even; NaNs stay NaN (quieted) with the top of their payload.
+ */
+
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+#include <immintrin.h>
+#endif
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace saburou::platform::v2::bytes::detail {
+
+/** @brief IEEE binary16 bits to binary32, exact. */
+[[nodiscard]] constexpr float fp16_bits_to_float(uint16_t h) noexcept {
+    uint32_t sign = uint32_t{h & 0x8000u} << 16;
+    uint32_t exp = (h >> 10) & 0x1F, mant = h & 0x3FFu;
+    // Infinity, or NaN with the quiet bit set as F16C and FCVTL do.
+    if (exp == 0x1F) return std::bit_cast<float>(sign | 0x7F800000u | mant << 13 | (mant ? 0x400000u : 0));
+    if (exp == 0) {
+        if (mant == 0) return std::bit_cast<float>(sign);
+        // Subnormal: shift the leading one into the implicit bit position.
+        int shift = std::countl_zero(mant) - 21;
+        return std::bit_cast<float>(sign | uint32_t(113 - shift) << 23 | (mant << shift & 0x3FFu) << 13);
+    }
+    return std::bit_cast<float>(sign | (exp + 112) << 23 | mant << 13);
+}
+
+/** @brief binary32 to IEEE binary16 bits, round to nearest even. */
+[[nodiscard]] constexpr uint16_t float_to_fp16_bits(float f) noexcept {
+    uint32_t x = std::bit_cast<uint32_t>(f);
+    uint32_t sign = (x >> 16) & 0x8000u, a = x & 0x7FFFFFFFu;
+    if (a > 0x7F800000u) return static_cast<uint16_t>(sign | 0x7E00u | (a >> 13 & 0x3FFu)); // NaN
+    if (a >= 0x477FF000u) return static_cast<uint16_t>(sign | 0x7C00u); // rounds past 65504, or infinity
+    if (a < 0x38800000u) {
+        // Below the smallest normal half: round a/2^-24 to an integer count of subnormal steps.
+        uint32_t shift = 126 - (a >> 23);
+        if (shift > 24) return static_cast<uint16_t>(sign);
+        uint32_t m = (a & 0x7FFFFFu) | 0x800000u;
+        uint32_t r = m >> shift, rem = m & ((1u << shift) - 1), half = 1u << (shift - 1);
+        r += rem > half || (rem == half && (r & 1));
+        return static_cast<uint16_t>(sign | r);
+    }
+    a -= 0x38000000u; // rebias the exponent from 127 to 15
+    return static_cast<uint16_t>(sign | (a + 0x0FFFu + (a >> 13 & 1)) >> 13);
+}
+
+[[nodiscard]] constexpr float bf16_bits_to_float(uint16_t b) noexcept {
+    return std::bit_cast<float>(uint32_t{b} << 16);
+}
+
+/** @brief binary32 to bfloat16 bits, round to nearest even. */
+[[nodiscard]] constexpr uint16_t float_to_bf16_bits(float f) noexcept {
+    uint32_t x = std::bit_cast<uint32_t>(f);
+    if ((x & 0x7FFFFFFFu) > 0x7F800000u) return static_cast<uint16_t>(x >> 16 | 0x40u); // NaN
+    return static_cast<uint16_t>((x + 0x7FFFu + (x >> 16 & 1)) >> 16);
+}
+
+namespace half_scalar {
+
+template <bool Swap> [[nodiscard]] inline uint16_t load(const unsigned char *p) noexcept {
+    uint16_t v;
+    std::memcpy(&v, p, 2);
+    return Swap ? std::byteswap(v) : v;
+}
+
+template <bool Swap> inline void store(unsigned char *p, uint16_t v) noexcept {
+    if constexpr (Swap) v = std::byteswap(v);
+    std::memcpy(p, &v, 2);
+}
+
+template <bool Swap> inline void fp16_widen(const unsigned char *in, std::size_t n, float *out) noexcept {
+    for (std::size_t i = 0; i < n; ++i) out[i] = fp16_bits_to_float(load<Swap>(in + 2 * i));
+}
+
+template <bool Swap> inline void fp16_narrow(const float *in, std::size_t n, unsigned char *out) noexcept {
+    for (std::size_t i = 0; i < n; ++i) store<Swap>(out + 2 * i, float_to_fp16_bits(in[i]));
+}
+
+template <bool Swap> inline void bf16_widen(const unsigned char *in, std::size_t n, float *out) noexcept {
+    for (std::size_t i = 0; i < n; ++i) out[i] = bf16_bits_to_float(load<Swap>(in + 2 * i));
+}
+
+template <bool Swap> inline void bf16_narrow(const float *in, std::size_t n, unsigned char *out) noexcept {
+    for (std::size_t i = 0; i < n; ++i) store<Swap>(out + 2 * i, float_to_bf16_bits(in[i]));
+}
+
+} // namespace half_scalar
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+namespace half_avx2 {
+
+// F16C converts 8 halves per instruction; bf16 is integer work (a shift to widen, a rounding add to narrow).
+#define SABUROU_PLATFORM_V2_TARGET_HALF_AVX2 SABUROU_PLATFORM_V2_TARGET("avx2,f16c")
+
+/** @brief PSHUFB control swapping the bytes of each 16-bit lane. */
+SABUROU_PLATFORM_V2_TARGET_HALF_AVX2 inline __m128i swap_pairs() noexcept {
+    return _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+}
+
+template <bool Swap> SABUROU_PLATFORM_V2_TARGET_HALF_AVX2 inline __m128i load8(const unsigned char *p) noexcept {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    return Swap ? _mm_shuffle_epi8(v, swap_pairs()) : v;
+}
+
+template <bool Swap> SABUROU_PLATFORM_V2_TARGET_HALF_AVX2 inline void store8(unsigned char *p, __m128i v) noexcept {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), Swap ? _mm_shuffle_epi8(v, swap_pairs()) : v);
+}
+
+template <bool Swap>
+SABUROU_PLATFORM_V2_TARGET_HALF_AVX2
+inline void fp16_widen(const unsigned char *in, std::size_t n, float *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) _mm256_storeu_ps(out + i, _mm256_cvtph_ps(load8<Swap>(in + 2 * i)));
+    half_scalar::fp16_widen<Swap>(in + 2 * i, n - i, out + i);
+}
+
+template <bool Swap>
+SABUROU_PLATFORM_V2_TARGET_HALF_AVX2
+inline void fp16_narrow(const float *in, std::size_t n, unsigned char *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        store8<Swap>(out + 2 * i, h);
+    }
+    half_scalar::fp16_narrow<Swap>(in + i, n - i, out + 2 * i);
+}
+
+template <bool Swap>
+SABUROU_PLATFORM_V2_TARGET_HALF_AVX2
+inline void bf16_widen(const unsigned char *in, std::size_t n, float *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_slli_epi32(_mm256_cvtepu16_epi32(load8<Swap>(in + 2 * i)), 16);
+        _mm256_storeu_ps(out + i, _mm256_castsi256_ps(v));
+    }
+    half_scalar::bf16_widen<Swap>(in + 2 * i, n - i, out + i);
+}
+
+/** @brief float_to_bf16_bits() on 8 lanes, results in the low half of each 32-bit lane. */
+SABUROU_PLATFORM_V2_TARGET_HALF_AVX2 inline __m256i bf16_round(__m256 f) noexcept {
+    __m256i x = _mm256_castps_si256(f);
+    __m256i odd = _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1));
+    __m256i r = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(0x7FFF)), odd), 16);
+    __m256i nan = _mm256_or_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(0x40));
+    return _mm256_blendv_epi8(r, nan, _mm256_castps_si256(_mm256_cmp_ps(f, f, _CMP_UNORD_Q)));
+}
+
+template <bool Swap>
+SABUROU_PLATFORM_V2_TARGET_HALF_AVX2
+inline void bf16_narrow(const float *in, std::size_t n, unsigned char *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i r = bf16_round(_mm256_loadu_ps(in + i));
+        store8<Swap>(out + 2 * i, _mm_packus_epi32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1)));
+    }
+    half_scalar::bf16_narrow<Swap>(in + i, n - i, out + 2 * i);
+}
+
+#undef SABUROU_PLATFORM_V2_TARGET_HALF_AVX2
+
+} // namespace half_avx2
+
+namespace half_avx512 {
+
+// VCVTPH2PS/VCVTPS2PH are AVX-512F; the AVX512-FP16 forms (VCVTPH2PSX) do the same conversion, so they add
+// nothing. The full-mask maskz forms avoid GCC 12's -Wuninitialized, as in xxh3_kernels.hpp.
+#define SABUROU_PLATFORM_V2_TARGET_HALF_AVX512 SABUROU_PLATFORM_V2_TARGET("avx512f,avx512bw,avx2,f16c")
+
+template <bool Swap> SABUROU_PLATFORM_V2_TARGET_HALF_AVX512 inline __m256i load16(const unsigned char *p) noexcept {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    return Swap ? _mm256_shuffle_epi8(v, _mm256_broadcastsi128_si256(half_avx2::swap_pairs())) : v;
+}
+
+template <bool Swap> SABUROU_PLATFORM_V2_TARGET_HALF_AVX512 inline void store16(unsigned char *p, __m256i v) noexcept {
+    if constexpr (Swap) v = _mm256_shuffle_epi8(v, _mm256_broadcastsi128_si256(half_avx2::swap_pairs()));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+}
+
+template <bool Swap>
+SABUROU_PLATFORM_V2_TARGET_HALF_AVX512
+inline void fp16_widen(const unsigned char *in, std::size_t n, float *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) _mm512_storeu_ps(out + i, _mm512_maskz_cvtph_ps(0xFFFF, load16<Swap>(in + 2 * i)));
+    half_avx2::fp16_widen<Swap>(in + 2 * i, n - i, out + i);
+}
+
+template <bool Swap>
+SABUROU_PLATFORM_V2_TARGET_HALF_AVX512
+inline void fp16_narrow(const float *in, std::size_t n, unsigned char *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i h =
+            _mm512_maskz_cvtps_ph(0xFFFF, _mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        store16<Swap>(out + 2 * i, h);
+    }
+    half_avx2::fp16_narrow<Swap>(in + i, n - i, out + 2 * i);
+}
+
+template <bool Swap>
+SABUROU_PLATFORM_V2_TARGET_HALF_AVX512
+inline void bf16_widen(const unsigned char *in, std::size_t n, float *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i v = _mm512_maskz_cvtepu16_epi32(0xFFFF, load16<Swap>(in + 2 * i));
+        _mm512_storeu_ps(out + i, _mm512_castsi512_ps(_mm512_maskz_slli_epi32(0xFFFF, v, 16)));
+    }
+    half_avx2::bf16_widen<Swap>(in + 2 * i, n - i, out + i);
+}
+
+/**
+ * @brief bf16 narrowing with AVX512-BF16 VCVTNEPS2BF16.
+ * * The instruction always treats subnormal inputs as zero, so fp32 subnormals (below 1.2e-38) become signed
+ * zeros instead of the nearest bf16 subnormal; everything else matches float_to_bf16_bits(). Only selected
+ * for subnormal_mode_t::flush_to_zero.
+ */
+template <bool Swap>
+SABUROU_PLATFORM_V2_TARGET("avx512f,avx512bw,avx512bf16,avx2,f16c")
+inline void bf16_narrow(const float *in, std::size_t n, unsigned char *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256bh h = _mm512_cvtneps_pbh(_mm512_loadu_ps(in + i));
+        store16<Swap>(out + 2 * i, reinterpret_cast<__m256i &>(h));
+    }
+    half_avx2::bf16_narrow<Swap>(in + i, n - i, out + 2 * i);
+}
+
+#undef SABUROU_PLATFORM_V2_TARGET_HALF_AVX512
+
+} // namespace half_avx512
+#endif
+
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+namespace half_neon {
+
+// FCVTL/FCVTN are base AArch64 SIMD and round with FPCR (nearest even unless changed). bf16 uses integer work,
+// which needs no BF16 extension and keeps subnormals.
+template <bool Swap> inline uint16x8_t load8(const unsigned char *p) noexcept {
+    uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t *>(p));
+    if constexpr (Swap) v = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(v)));
+    return v;
+}
+
+template <bool Swap> inline void store8(unsigned char *p, uint16x8_t v) noexcept {
+    if constexpr (Swap) v = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(v)));
+    vst1q_u16(reinterpret_cast<uint16_t *>(p), v);
+}
+
+template <bool Swap> inline void fp16_widen(const unsigned char *in, std::size_t n, float *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        float16x8_t h = vreinterpretq_f16_u16(load8<Swap>(in + 2 * i));
+        vst1q_f32(out + i, vcvt_f32_f16(vget_low_f16(h)));
+        vst1q_f32(out + i + 4, vcvt_high_f32_f16(h));
+    }
+    half_scalar::fp16_widen<Swap>(in + 2 * i, n - i, out + i);
+}
+
+template <bool Swap> inline void fp16_narrow(const float *in, std::size_t n, unsigned char *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        float16x8_t h = vcvt_high_f16_f32(vcvt_f16_f32(vld1q_f32(in + i)), vld1q_f32(in + i + 4));
+        store8<Swap>(out + 2 * i, vreinterpretq_u16_f16(h));
+    }
+    half_scalar::fp16_narrow<Swap>(in + i, n - i, out + 2 * i);
+}
+
+template <bool Swap> inline void bf16_widen(const unsigned char *in, std::size_t n, float *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t v = load8<Swap>(in + 2 * i);
+        vst1q_u32(reinterpret_cast<uint32_t *>(out + i), vshll_n_u16(vget_low_u16(v), 16));
+        vst1q_u32(reinterpret_cast<uint32_t *>(out + i + 4), vshll_high_n_u16(v, 16));
+    }
+    half_scalar::bf16_widen<Swap>(in + 2 * i, n - i, out + i);
+}
+
+inline uint16x4_t bf16_round(float32x4_t f) noexcept {
+    uint32x4_t x = vreinterpretq_u32_f32(f);
+    uint32x4_t odd = vandq_u32(vshrq_n_u32(x, 16), vdupq_n_u32(1));
+    uint32x4_t r = vaddq_u32(vaddq_u32(x, vdupq_n_u32(0x7FFF)), odd);
+    uint32x4_t nan = vorrq_u32(x, vdupq_n_u32(0x400000));
+    return vshrn_n_u32(vbslq_u32(vceqq_f32(f, f), r, nan), 16);
+}
+
+template <bool Swap> inline void bf16_narrow(const float *in, std::size_t n, unsigned char *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        store8<Swap>(out + 2 * i, vcombine_u16(bf16_round(vld1q_f32(in + i)), bf16_round(vld1q_f32(in + i + 4))));
+    half_scalar::bf16_narrow<Swap>(in + i, n - i, out + 2 * i);
+}
+
+} // namespace half_neon
+#endif
+
+} // namespace saburou::platform::v2::bytes::detail
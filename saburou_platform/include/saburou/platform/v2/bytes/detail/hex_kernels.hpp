@@ -0,0 +1,170 @@
+#pragma once
+
+/**
+ * @file hex_kernels.hpp
+ * @brief Hex encode/decode loops: scalar, AVX2 and NEON.
+ *
+ * Encoders turn each nibble into a digit with one byte shuffle over a 16-character table. Decoders classify
+ * each character as digit or letter with saturating range checks, so a whole block is validated at once.
+ * The SIMD loops only handle complete blocks and stop before the first block with an invalid character;
+ * they return how much input they consumed and the scalar loop finishes (and reports the error).
+ */
+
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+#include <immintrin.h>
+#endif
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace saburou::platform::v2::bytes::detail {
+
+inline constexpr char hex_digits_lower[17] = "0123456789abcdef";
+inline constexpr char hex_digits_upper[17] = "0123456789ABCDEF";
+
+/** @brief Value of each character, 0xFF if it is not a hex digit (either case). */
+inline constexpr std::array<uint8_t, 256> hex_values = [] {
+    std::array<uint8_t, 256> t{};
+    t.fill(0xFF);
+    for (unsigned i = 0; i < 16; ++i) {
+        t[static_cast<unsigned char>(hex_digits_lower[i])] = static_cast<uint8_t>(i);
+        t[static_cast<unsigned char>(hex_digits_upper[i])] = static_cast<uint8_t>(i);
+    }
+    return t;
+}();
+
+/** @brief Both digits of every byte value, high digit first. */
+struct hex_pairs_t {
+    char lower[512];
+    char upper[512];
+};
+
+inline constexpr hex_pairs_t hex_pairs = [] {
+    hex_pairs_t t{};
+    for (unsigned b = 0; b < 256; ++b) {
+        t.lower[2 * b] = hex_digits_lower[b >> 4];
+        t.lower[2 * b + 1] = hex_digits_lower[b & 15];
+        t.upper[2 * b] = hex_digits_upper[b >> 4];
+        t.upper[2 * b + 1] = hex_digits_upper[b & 15];
+    }
+    return t;
+}();
+
+namespace hex_scalar {
+
+inline std::size_t encode(const unsigned char *in, std::size_t n, char *out, bool upper) noexcept {
+    const char *pairs = upper ? hex_pairs.upper : hex_pairs.lower;
+    for (std::size_t i = 0; i < n; ++i) {
+        out[2 * i] = pairs[2 * in[i]];
+        out[2 * i + 1] = pairs[2 * in[i] + 1];
+    }
+    return n;
+}
+
+/** @brief Decodes @p n (even) characters; returns the characters consumed before the first invalid pair. */
+inline std::size_t decode(const char *in, std::size_t n, unsigned char *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        unsigned hi = hex_values[static_cast<unsigned char>(in[i])];
+        unsigned lo = hex_values[static_cast<unsigned char>(in[i + 1])];
+        if ((hi | lo) > 15) break;
+        out[i / 2] = static_cast<unsigned char>(hi << 4 | lo);
+    }
+    return i;
+}
+
+} // namespace hex_scalar
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+namespace hex_avx2 {
+
+SABUROU_PLATFORM_V2_TARGET("avx2")
+inline std::size_t encode(const unsigned char *in, std::size_t n, char *out, bool upper) noexcept {
+    const __m256i table = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(upper ? hex_digits_upper : hex_digits_lower)));
+    const __m256i low4 = _mm256_set1_epi8(0x0F);
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low4));
+        __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low4));
+        // Interleaving works per 128-bit lane; the permutes put the halves back in order.
+        __m256i a = _mm256_unpacklo_epi8(hi, lo), b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    return i;
+}
+
+/** @brief Nibble values of 32 characters; @p ok gets 0xFF for each valid one. */
+SABUROU_PLATFORM_V2_TARGET("avx2") inline __m256i nibbles(__m256i c, __m256i &ok) noexcept {
+    __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+    ok = _mm256_or_si256(is_digit, is_alpha);
+    return _mm256_blendv_epi8(_mm256_add_epi8(alpha, _mm256_set1_epi8(10)), digit, is_digit);
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx2")
+inline std::size_t decode(const char *in, std::size_t n, unsigned char *out) noexcept {
+    const __m256i weights = _mm256_set1_epi16(0x0110); // 16 * high digit + low digit
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m256i ok0, ok1;
+        __m256i v0 = nibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)), ok0);
+        __m256i v1 = nibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 32)), ok1);
+        if (_mm256_movemask_epi8(_mm256_and_si256(ok0, ok1)) != -1) break;
+        __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(v0, weights), _mm256_maddubs_epi16(v1, weights));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i / 2), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    return i;
+}
+
+} // namespace hex_avx2
+#endif
+
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+namespace hex_neon {
+
+inline std::size_t encode(const unsigned char *in, std::size_t n, char *out, bool upper) noexcept {
+    const uint8x16_t table = vld1q_u8(reinterpret_cast<const uint8_t *>(upper ? hex_digits_upper : hex_digits_lower));
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t v = vld1q_u8(in + i);
+        uint8x16x2_t r{{vqtbl1q_u8(table, vshrq_n_u8(v, 4)), vqtbl1q_u8(table, vandq_u8(v, vdupq_n_u8(0x0F)))}};
+        vst2q_u8(reinterpret_cast<uint8_t *>(out + 2 * i), r);
+    }
+    return i;
+}
+
+inline uint8x16_t nibbles(uint8x16_t c, uint8x16_t &ok) noexcept {
+    uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+    uint8x16_t alpha = vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    uint8x16_t is_digit = vcleq_u8(digit, vdupq_n_u8(9));
+    ok = vorrq_u8(is_digit, vcleq_u8(alpha, vdupq_n_u8(5)));
+    return vbslq_u8(is_digit, digit, vaddq_u8(alpha, vdupq_n_u8(10)));
+}
+
+inline std::size_t decode(const char *in, std::size_t n, unsigned char *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        uint8x16x2_t c = vld2q_u8(reinterpret_cast<const uint8_t *>(in + i));
+        uint8x16_t ok_hi, ok_lo;
+        uint8x16_t hi = nibbles(c.val[0], ok_hi), lo = nibbles(c.val[1], ok_lo);
+        if (vminvq_u8(vandq_u8(ok_hi, ok_lo)) != 0xFF) break;
+        vst1q_u8(out + i / 2, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+    return i;
+}
+
+} // namespace hex_neon
+#endif
+
+} // namespace saburou::platform::v2::bytes::detail
@@ -0,0 +1,408 @@
+#pragma once
+
+/**
+ * @file mem_kernels.hpp
+ * @brief Size-class specialized copy/fill/find/compare kernels (portable, SSE2, AVX2, NEON).
+ *
+ * Every kernel handles its tail with overlapping unaligned accesses instead of byte loops, and none
+ * reads outside [p, p + n). They are selected at runtime by bytes/mem.hpp.
+ */
+
+#include <saburou/platform/v2/cpu/features.hpp>
+#include <saburou/platform/v2/detect.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if SABUROU_PLATFORM_V2_OS_LINUX
+#include <saburou/platform/v2/os/linux/procfs/parse.hpp>
+#include <saburou/platform/v2/os/linux/procfs/reader.hpp>
+#endif
+#if SABUROU_PLATFORM_V2_SIMD_X86
+#include <immintrin.h>
+#endif
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace saburou::platform::v2::bytes::detail {
+
+using uchar = unsigned char;
+
+/**
+ * @brief Copy size from which stores bypass the cache: 3/4 of the last-level cache, or 4 MiB if unknown.
+ * * Below it the destination is likely to be read soon and fits in cache; above it, caching it would
+ * only evict the working set.
+ */
+[[nodiscard]] inline std::size_t non_temporal_threshold() noexcept {
+    static const std::size_t threshold = [] {
+        std::size_t llc = 0;
+#if SABUROU_PLATFORM_V2_OS_LINUX
+        namespace procfs = saburou::platform::v2::os::linux::procfs;
+        procfs::file_reader size("/sys/devices/system/cpu/cpu0/cache/index3/size", 64);
+        std::string_view text = procfs::trim(size.read()); // "32768K"
+        if (!text.empty() && (text.back() == 'K' || text.back() == 'M')) {
+            std::size_t unit = text.back() == 'K' ? 1024 : 1024 * 1024;
+            if (procfs::parse_number(text.substr(0, text.size() - 1), llc)) llc *= unit;
+        }
+#endif
+        return llc ? llc / 4 * 3 : std::size_t{4} << 20;
+    }();
+    return threshold;
+}
+
+// -- Portable helpers: fixed-size memcpy compiles to single loads/stores. --
+
+template <class T> [[nodiscard]] inline T load(const uchar *p) noexcept {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+template <class T> inline void store(uchar *p, T v) noexcept { std::memcpy(p, &v, sizeof(T)); }
+
+/** @brief Copies n <= 32 bytes with at most four overlapping loads and stores. */
+inline void copy_small(uchar *d, const uchar *s, std::size_t n) noexcept {
+    struct block16 {
+        uint64_t lo, hi;
+    };
+    if (n >= 16) {
+        auto a = load<block16>(s), b = load<block16>(s + n - 16);
+        store(d, a);
+        store(d + n - 16, b);
+    } else if (n >= 8) {
+        auto a = load<uint64_t>(s), b = load<uint64_t>(s + n - 8);
+        store(d, a);
+        store(d + n - 8, b);
+    } else if (n >= 4) {
+        auto a = load<uint32_t>(s), b = load<uint32_t>(s + n - 4);
+        store(d, a);
+        store(d + n - 4, b);
+    } else if (n >= 2) {
+        auto a = load<uint16_t>(s), b = load<uint16_t>(s + n - 2);
+        store(d, a);
+        store(d + n - 2, b);
+    } else if (n) {
+        *d = *s;
+    }
+}
+
+/** @brief Fills n <= 32 bytes. */
+inline void fill_small(uchar *d, uchar value, std::size_t n) noexcept {
+    uint64_t v = 0x0101010101010101ull * value;
+    if (n >= 16) {
+        store(d, v);
+        store(d + 8, v);
+        store(d + n - 16, v);
+        store(d + n - 8, v);
+    } else if (n >= 8) {
+        store(d, v);
+        store(d + n - 8, v);
+    } else if (n >= 4) {
+        store(d, static_cast<uint32_t>(v));
+        store(d + n - 4, static_cast<uint32_t>(v));
+    } else if (n >= 2) {
+        store(d, static_cast<uint16_t>(v));
+        store(d + n - 2, static_cast<uint16_t>(v));
+    } else if (n) {
+        *d = value;
+    }
+}
+
+/** @brief memcmp of n < 16 bytes through big-endian word compares. */
+[[nodiscard]] inline int compare_small(const uchar *a, const uchar *b, std::size_t n) noexcept {
+    auto order = [](auto x, auto y) { return (x > y) - (x < y); };
+    auto be = [](auto x) { return std::endian::native == std::endian::little ? std::byteswap(x) : x; };
+    if (n >= 8) {
+        auto x = be(load<uint64_t>(a)), y = be(load<uint64_t>(b));
+        if (x != y) return order(x, y);
+        return order(be(load<uint64_t>(a + n - 8)), be(load<uint64_t>(b + n - 8)));
+    }
+    if (n >= 4) {
+        auto x = be(load<uint32_t>(a)), y = be(load<uint32_t>(b));
+        if (x != y) return order(x, y);
+        return order(be(load<uint32_t>(a + n - 4)), be(load<uint32_t>(b + n - 4)));
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+// Lambdas do not inherit a function's target attribute, so the x86 kernels use target-attributed
+// helpers instead.
+namespace sse2 {
+
+SABUROU_PLATFORM_V2_TARGET("sse2")
+[[nodiscard]] inline unsigned match_mask(const uchar *p, __m128i v) noexcept {
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)p), v)));
+}
+
+SABUROU_PLATFORM_V2_TARGET("sse2")
+[[nodiscard]] inline unsigned diff_mask(const uchar *a, const uchar *b) noexcept {
+    __m128i x = _mm_loadu_si128((const __m128i *)a), y = _mm_loadu_si128((const __m128i *)b);
+    return ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xFFFFu;
+}
+
+SABUROU_PLATFORM_V2_TARGET("sse2")
+[[nodiscard]] inline const uchar *find_byte(const uchar *p, uchar value, std::size_t n) noexcept {
+    const uchar *end = p + n;
+    if (n < 16) {
+        for (; p < end; ++p)
+            if (*p == value) return p;
+        return nullptr;
+    }
+    const __m128i v = _mm_set1_epi8(static_cast<char>(value));
+    for (; end - p >= 16; p += 16) {
+        if (unsigned m = match_mask(p, v)) return p + std::countr_zero(m);
+    }
+    if (p < end) {
+        const uchar *last = end - 16; // overlaps bytes already checked; mask them out
+        unsigned m = match_mask(last, v) & (0xFFFFu << (p - last));
+        if (m) return last + std::countr_zero(m);
+    }
+    return nullptr;
+}
+
+SABUROU_PLATFORM_V2_TARGET("sse2")
+[[nodiscard]] inline int compare(const uchar *a, const uchar *b, std::size_t n) noexcept {
+    if (n < 16) return compare_small(a, b, n);
+    std::size_t off = 0;
+    for (; off + 16 <= n; off += 16) {
+        if (unsigned m = diff_mask(a + off, b + off)) {
+            std::size_t i = off + std::countr_zero(m);
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    if (off < n) {
+        off = n - 16;
+        if (unsigned m = diff_mask(a + off, b + off)) {
+            std::size_t i = off + std::countr_zero(m);
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace sse2
+
+namespace avx2 {
+
+SABUROU_PLATFORM_V2_TARGET("avx2")
+[[nodiscard]] inline __m256i loadu(const uchar *p) noexcept { return _mm256_loadu_si256((const __m256i *)p); }
+
+SABUROU_PLATFORM_V2_TARGET("avx2")
+inline void storeu(uchar *p, __m256i v) noexcept { _mm256_storeu_si256((__m256i *)p, v); }
+
+SABUROU_PLATFORM_V2_TARGET("avx2")
+[[nodiscard]] inline uint32_t match_mask(const uchar *p, __m256i v) noexcept {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(loadu(p), v)));
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx2")
+[[nodiscard]] inline uint32_t diff_mask(const uchar *a, const uchar *b) noexcept {
+    return ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(loadu(a), loadu(b))));
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx2")
+inline void copy(uchar *d, const uchar *s, std::size_t n) noexcept {
+    if (n <= 32) return copy_small(d, s, n);
+    if (n <= 64) {
+        __m256i a = loadu(s), b = loadu(s + n - 32);
+        storeu(d, a);
+        storeu(d + n - 32, b);
+        return;
+    }
+    if (n <= 128) {
+        __m256i a = loadu(s), b = loadu(s + 32), c = loadu(s + n - 64), e = loadu(s + n - 32);
+        storeu(d, a);
+        storeu(d + 32, b);
+        storeu(d + n - 64, c);
+        storeu(d + n - 32, e);
+        return;
+    }
+    // Unaligned head and 128-byte tail are loaded up front; the body runs on 32-byte aligned stores.
+    __m256i head = loadu(s);
+    __m256i t0 = loadu(s + n - 128), t1 = loadu(s + n - 96), t2 = loadu(s + n - 64), t3 = loadu(s + n - 32);
+    std::size_t skew = 32 - (reinterpret_cast<std::uintptr_t>(d) & 31);
+    uchar *dp = d + skew, *dlast = d + n - 128;
+    const uchar *sp = s + skew;
+    if (n >= non_temporal_threshold()) {
+        for (; dp < dlast; dp += 128, sp += 128) {
+            __m256i a = loadu(sp), b = loadu(sp + 32), c = loadu(sp + 64), e = loadu(sp + 96);
+            _mm256_stream_si256((__m256i *)dp, a);
+            _mm256_stream_si256((__m256i *)(dp + 32), b);
+            _mm256_stream_si256((__m256i *)(dp + 64), c);
+            _mm256_stream_si256((__m256i *)(dp + 96), e);
+        }
+        _mm_sfence(); // order the weakly-ordered streaming stores before anything that follows
+    } else {
+        for (; dp < dlast; dp += 128, sp += 128) {
+            __m256i a = loadu(sp), b = loadu(sp + 32), c = loadu(sp + 64), e = loadu(sp + 96);
+            _mm256_store_si256((__m256i *)dp, a);
+            _mm256_store_si256((__m256i *)(dp + 32), b);
+            _mm256_store_si256((__m256i *)(dp + 64), c);
+            _mm256_store_si256((__m256i *)(dp + 96), e);
+        }
+    }
+    storeu(d, head);
+    storeu(d + n - 128, t0);
+    storeu(d + n - 96, t1);
+    storeu(d + n - 64, t2);
+    storeu(d + n - 32, t3);
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx2")
+inline void fill(uchar *d, uchar value, std::size_t n) noexcept {
+    if (n <= 32) return fill_small(d, value, n);
+    const __m256i v = _mm256_set1_epi8(static_cast<char>(value));
+    if (n <= 128) {
+        storeu(d, v);
+        storeu(d + n - 32, v);
+        if (n > 64) {
+            storeu(d + 32, v);
+            storeu(d + n - 64, v);
+        }
+        return;
+    }
+    storeu(d, v);
+    uchar *dp = d + 32 - (reinterpret_cast<std::uintptr_t>(d) & 31), *dlast = d + n - 128;
+    if (n >= non_temporal_threshold()) {
+        for (; dp < dlast; dp += 128) {
+            for (int i = 0; i < 4; ++i) _mm256_stream_si256((__m256i *)(dp + 32 * i), v);
+        }
+        _mm_sfence();
+    } else {
+        for (; dp < dlast; dp += 128) {
+            for (int i = 0; i < 4; ++i) _mm256_store_si256((__m256i *)(dp + 32 * i), v);
+        }
+    }
+    for (int i = 4; i > 0; --i) storeu(d + n - 32 * i, v);
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx2")
+[[nodiscard]] inline const uchar *find_byte(const uchar *p, uchar value, std::size_t n) noexcept {
+    if (n < 32) return sse2::find_byte(p, value, n);
+    const uchar *end = p + n;
+    const __m256i v = _mm256_set1_epi8(static_cast<char>(value));
+    for (; end - p >= 128; p += 128) {
+        __m256i a = _mm256_cmpeq_epi8(loadu(p), v), b = _mm256_cmpeq_epi8(loadu(p + 32), v);
+        __m256i c = _mm256_cmpeq_epi8(loadu(p + 64), v), e = _mm256_cmpeq_epi8(loadu(p + 96), v);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, e));
+        if (_mm256_movemask_epi8(any)) break; // locate it below, 32 bytes at a time
+    }
+    for (; end - p >= 32; p += 32) {
+        if (uint32_t m = match_mask(p, v)) return p + std::countr_zero(m);
+    }
+    if (p < end) {
+        const uchar *last = end - 32;
+        uint32_t m = match_mask(last, v) & (~uint32_t{0} << (p - last));
+        if (m) return last + std::countr_zero(m);
+    }
+    return nullptr;
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx2")
+[[nodiscard]] inline int compare(const uchar *a, const uchar *b, std::size_t n) noexcept {
+    if (n < 32) return sse2::compare(a, b, n);
+    std::size_t off = 0;
+    for (; off + 128 <= n; off += 128) {
+        __m256i e0 = _mm256_cmpeq_epi8(loadu(a + off), loadu(b + off));
+        __m256i e1 = _mm256_cmpeq_epi8(loadu(a + off + 32), loadu(b + off + 32));
+        __m256i e2 = _mm256_cmpeq_epi8(loadu(a + off + 64), loadu(b + off + 64));
+        __m256i e3 = _mm256_cmpeq_epi8(loadu(a + off + 96), loadu(b + off + 96));
+        __m256i all = _mm256_and_si256(_mm256_and_si256(e0, e1), _mm256_and_si256(e2, e3));
+        if (~static_cast<uint32_t>(_mm256_movemask_epi8(all))) break; // locate it below
+    }
+    for (; off + 32 <= n; off += 32) {
+        if (uint32_t m = diff_mask(a + off, b + off)) {
+            std::size_t i = off + std::countr_zero(m);
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    if (off < n) {
+        off = n - 32;
+        if (uint32_t m = diff_mask(a + off, b + off)) {
+            std::size_t i = off + std::countr_zero(m);
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace avx2
+#endif
+
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+namespace neon {
+
+/** @brief Narrows a 0x00/0xFF byte mask to 4 bits per byte, the NEON stand-in for movemask. */
+[[nodiscard]] inline uint64_t nibble_mask(uint8x16_t eq) noexcept {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+}
+
+inline void copy(uchar *d, const uchar *s, std::size_t n) noexcept {
+    if (n <= 32) return copy_small(d, s, n);
+    uint8x16_t t0 = vld1q_u8(s + n - 32), t1 = vld1q_u8(s + n - 16);
+    for (std::size_t off = 0; off + 32 < n; off += 32) {
+        uint8x16_t a = vld1q_u8(s + off), b = vld1q_u8(s + off + 16);
+        vst1q_u8(d + off, a);
+        vst1q_u8(d + off + 16, b);
+    }
+    vst1q_u8(d + n - 32, t0);
+    vst1q_u8(d + n - 16, t1);
+}
+
+inline void fill(uchar *d, uchar value, std::size_t n) noexcept {
+    if (n <= 32) return fill_small(d, value, n);
+    const uint8x16_t v = vdupq_n_u8(value);
+    for (std::size_t off = 0; off + 32 < n; off += 32) {
+        vst1q_u8(d + off, v);
+        vst1q_u8(d + off + 16, v);
+    }
+    vst1q_u8(d + n - 32, v);
+    vst1q_u8(d + n - 16, v);
+}
+
+[[nodiscard]] inline const uchar *find_byte(const uchar *p, uchar value, std::size_t n) noexcept {
+    const uchar *end = p + n;
+    if (n < 16) {
+        for (; p < end; ++p)
+            if (*p == value) return p;
+        return nullptr;
+    }
+    const uint8x16_t v = vdupq_n_u8(value);
+    for (; end - p >= 16; p += 16) {
+        if (uint64_t m = nibble_mask(vceqq_u8(vld1q_u8(p), v))) return p + std::countr_zero(m) / 4;
+    }
+    if (p < end) {
+        const uchar *last = end - 16;
+        uint64_t m = nibble_mask(vceqq_u8(vld1q_u8(last), v)) & (~uint64_t{0} << (4 * (p - last)));
+        if (m) return last + std::countr_zero(m) / 4;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline int compare(const uchar *a, const uchar *b, std::size_t n) noexcept {
+    if (n < 16) return compare_small(a, b, n);
+    auto order = [&](std::size_t i) { return a[i] < b[i] ? -1 : 1; };
+    std::size_t off = 0;
+    for (; off + 16 <= n; off += 16) {
+        if (uint64_t m = ~nibble_mask(vceqq_u8(vld1q_u8(a + off), vld1q_u8(b + off))))
+            return order(off + std::countr_zero(m) / 4);
+    }
+    if (off < n) {
+        off = n - 16;
+        if (uint64_t m = ~nibble_mask(vceqq_u8(vld1q_u8(a + off), vld1q_u8(b + off))))
+            return order(off + std::countr_zero(m) / 4);
+    }
+    return 0;
+}
+
+} // namespace neon
+#endif
+
+} // namespace saburou::platform::v2::bytes::detail
@@ -0,0 +1,290 @@
+#pragma once
+
+/**
+ * @file soa_kernels.hpp
+ * @brief Record-to-column (AoS to SoA) split and merge loops: scalar, AVX2, AVX-512 VBMI and NEON.
+ *
+ * Every loop is instantiated for one record layout (size, field offsets, widths and byte orders, all
+ * compile-time constants), so the per-record work is a fixed sequence of loads and stores with no field
+ * table to interpret. The SIMD loops are written with simd<T, N>: a block of records is loaded as one
+ * vector of "units" (the largest power of two dividing every field size, offset and the record size) and
+ * each field's column is cut out of it with a single compile-time shuffle; merging spreads each column back
+ * and blends. Byte-order conversion is one more shuffle per field. Blocks hold as many whole records as fit
+ * in one register, so the SIMD loops need records of at most half a register; larger records, and the last
+ * few records of any span, go through the scalar loop.
+ */
+
+#include <saburou/platform/v2/cpu/features.hpp>
+#include <saburou/platform/v2/simd.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace saburou::platform::v2::bytes::detail {
+
+/** @brief Unsigned integer of @p Size bytes (1, 2, 4 or 8). */
+template <std::size_t Size>
+using soa_uint_t =
+    std::conditional_t<Size == 1, uint8_t,
+                       std::conditional_t<Size == 2, uint16_t, std::conditional_t<Size == 4, uint32_t, uint64_t>>>;
+
+/** @brief True if field @p F is stored in the opposite byte order of the host. */
+template <class F> inline constexpr bool soa_swaps = F::order != std::endian::native && F::size > 1;
+
+/** @brief Copies one @p Size byte value, reversing its bytes if @p Swap. */
+template <std::size_t Size, bool Swap>
+SABUROU_PLATFORM_V2_SIMD_INLINE void soa_copy(unsigned char *dst, const unsigned char *src) noexcept {
+    if constexpr (!Swap) {
+        std::memcpy(dst, src, Size);
+    } else if constexpr (Size == 2 || Size == 4 || Size == 8) {
+        soa_uint_t<Size> v;
+        std::memcpy(&v, src, Size);
+        v = std::byteswap(v);
+        std::memcpy(dst, &v, Size);
+    } else {
+        for (std::size_t j = 0; j < Size; ++j) dst[j] = src[Size - 1 - j];
+    }
+}
+
+/** @brief Shuffle unit of a layout: largest power of two (up to 8) dividing every size and offset. */
+template <std::size_t S, class... F> [[nodiscard]] consteval std::size_t soa_unit() noexcept {
+    std::size_t all = (S | ... | (F::size | F::offset));
+    std::size_t unit = all & (~all + 1); // lowest set bit
+    return unit > 8 ? 8 : unit;
+}
+
+/** @brief True if every field is 1, 2, 4 or 8 bytes wide, which the SIMD loops require. */
+template <class... F> inline constexpr bool soa_simd_fields = ((std::has_single_bit(F::size) && F::size <= 8) && ...);
+
+/** @brief True if every byte of the record belongs to some field. */
+template <std::size_t S, class... F> [[nodiscard]] consteval bool soa_covers() noexcept {
+    std::array<bool, S> covered{};
+    ((std::fill_n(covered.begin() + F::offset, F::size, true)), ...);
+    return std::find(covered.begin(), covered.end(), false) == covered.end();
+}
+
+/** @brief Records per @p V byte block in the SIMD loops (0 if fewer than two fit). */
+template <std::size_t V, std::size_t S> inline constexpr std::size_t soa_block_records =
+    V / S >= 2 ? std::bit_floor(V / S) : 0;
+
+namespace soa_scalar {
+
+/** @brief Splits records [@p first, @p n) of @p in into the columns. */
+template <std::size_t S, class... F>
+inline void split_range(const unsigned char *in, std::size_t first, std::size_t n,
+                        unsigned char *const *cols) noexcept {
+    for (std::size_t i = first; i < n; ++i) {
+        const unsigned char *rec = in + i * S;
+        std::size_t f = 0;
+        (soa_copy<F::size, soa_swaps<F>>(cols[f++] + i * F::size, rec + F::offset), ...);
+    }
+}
+
+/** @brief Writes records [@p first, @p n) of @p out from the columns. Bytes no field covers are untouched. */
+template <std::size_t S, class... F>
+inline void merge_range(const unsigned char *const *cols, std::size_t first, std::size_t n,
+                        unsigned char *out) noexcept {
+    for (std::size_t i = first; i < n; ++i) {
+        unsigned char *rec = out + i * S;
+        std::size_t f = 0;
+        (soa_copy<F::size, soa_swaps<F>>(rec + F::offset, cols[f++] + i * F::size), ...);
+    }
+}
+
+template <std::size_t S, class... F>
+inline void split(const unsigned char *in, std::size_t n, unsigned char *const *cols) noexcept {
+    split_range<S, F...>(in, 0, n, cols);
+}
+
+template <std::size_t S, class... F>
+inline void merge(const unsigned char *const *cols, std::size_t n, unsigned char *out) noexcept {
+    merge_range<S, F...>(cols, 0, n, out);
+}
+
+} // namespace soa_scalar
+
+#if SABUROU_PLATFORM_V2_SIMD_X86 || SABUROU_PLATFORM_V2_SIMD_NEON
+namespace soa_simd {
+
+/**
+ * @brief Lanes of field F for the L records of a block: record r, unit t of the value is lane
+ * r * (S / G) + F::offset / G + t.
+ */
+template <std::size_t S, std::size_t G, class F, class U, std::size_t P, std::size_t... T>
+SABUROU_PLATFORM_V2_SIMD_INLINE auto gather_field(const simd<U, P> &block, std::index_sequence<T...>) noexcept {
+    constexpr std::size_t k = F::size / G;
+    return shuffle<((T / k) * (S / G) + F::offset / G + T % k)...>(block);
+}
+
+/** @brief Inverse of gather_field(): lane p of the block takes its unit from the column (lane 0 if unused). */
+template <std::size_t S, std::size_t G, std::size_t L, class F, class U, std::size_t C, std::size_t... Q>
+SABUROU_PLATFORM_V2_SIMD_INLINE simd<U, sizeof...(Q)> spread_field(const simd<U, C> &col,
+                                                                   std::index_sequence<Q...>) noexcept {
+    constexpr std::size_t k = F::size / G, o = F::offset / G, s = S / G;
+    return shuffle<(Q / s < L && Q % s >= o && Q % s < o + k ? Q / s * k + Q % s - o : 0)...>(col);
+}
+
+/** @brief Mask lanes (all ones or zero) of the P lane block that field F covers; a constant, not a loop. */
+template <std::size_t S, std::size_t G, std::size_t L, class F, std::size_t P>
+inline constexpr auto field_lanes = [] {
+    constexpr std::size_t k = F::size / G, o = F::offset / G, s = S / G;
+    std::array<v2::detail::simd_lane_int_t<G>, P> lanes{};
+    for (std::size_t r = 0; r < L; ++r)
+        for (std::size_t t = 0; t < k; ++t) lanes[r * s + o + t] = -1;
+    return lanes;
+}();
+
+/** @brief Column of field F as whole values, byte-swapped if the field is stored in the other order. */
+template <class F, class U, std::size_t C>
+SABUROU_PLATFORM_V2_SIMD_INLINE simd<U, C> fix_order(const simd<U, C> &units) noexcept {
+    if constexpr (soa_swaps<F>) {
+        using values_t = simd<soa_uint_t<F::size>, C * sizeof(U) / F::size>;
+        using units_t = typename simd<U, C>::storage_type;
+        values_t values(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(typename values_t::storage_type, units.storage()));
+        return simd<U, C>(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(units_t, byte_swap(values).storage()));
+    } else {
+        return units;
+    }
+}
+
+template <std::size_t S, std::size_t G, std::size_t L, class F, class U, std::size_t P>
+SABUROU_PLATFORM_V2_SIMD_INLINE void split_field(const simd<U, P> &block, unsigned char *col) noexcept {
+    constexpr std::size_t c = L * F::size / G;
+    auto units = fix_order<F>(gather_field<S, G, F>(block, std::make_index_sequence<c>{}));
+    units.copy_to(reinterpret_cast<U *>(col), element_aligned);
+}
+
+/**
+ * @brief @p v repeated up to P lanes. Compilers widen a short vector through the stack (a failed store
+ * forward per field and block); doubling it with concat() stays in registers.
+ */
+template <std::size_t P, class U, std::size_t C>
+SABUROU_PLATFORM_V2_SIMD_INLINE simd<U, P> widen(const simd<U, C> &v) noexcept {
+    if constexpr (C == P) return v;
+    else return widen<P>(concat(v, v));
+}
+
+template <std::size_t S, std::size_t G, std::size_t L, class F, class U, std::size_t P>
+SABUROU_PLATFORM_V2_SIMD_INLINE void merge_field(simd<U, P> &block, const unsigned char *col) noexcept {
+    constexpr std::size_t c = L * F::size / G;
+    auto units = fix_order<F>(simd<U, c>(reinterpret_cast<const U *>(col), element_aligned));
+    auto spread = spread_field<S, G, L, F>(widen<P>(units), std::make_index_sequence<P>{});
+    using mask_t = simd_mask<U, P>;
+    const mask_t mask(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(typename mask_t::storage_type, (field_lanes<S, G, L, F, P>)));
+    block = select(mask, spread, block);
+}
+
+/**
+ * @brief Splits whole blocks of L records with @p V byte vectors; returns the records done.
+ * * A block load reads V bytes, more than the L * S it uses, so the loop stops while that stays in bounds.
+ */
+template <std::size_t V, std::size_t S, class... F>
+SABUROU_PLATFORM_V2_SIMD_INLINE std::size_t split_blocks(const unsigned char *in, std::size_t n,
+                                                         unsigned char *const *cols) noexcept {
+    constexpr std::size_t g = soa_unit<S, F...>(), l = soa_block_records<V, S>;
+    using U = soa_uint_t<g>;
+    std::size_t i = 0;
+    for (; i + l <= n && i * S + V <= n * S; i += l) {
+        const simd<U, V / g> block(reinterpret_cast<const U *>(in + i * S), element_aligned);
+        std::size_t f = 0;
+        (split_field<S, g, l, F>(block, cols[f++] + i * F::size), ...);
+    }
+    return i;
+}
+
+/**
+ * @brief Merges whole blocks of L records; returns the records done.
+ * * Each block is read and stored as a full V bytes (a partial store would go through the stack): bytes past
+ * the L records get back what was just read there, or, when the fields cover the whole record and nothing
+ * is read, are rewritten by the next block or the scalar tail. Blocks less than 7/8 full lose to the
+ * scalar loop (measured), so those layouts merge entirely in scalar.
+ */
+template <std::size_t V, std::size_t S, class... F>
+SABUROU_PLATFORM_V2_SIMD_INLINE std::size_t merge_blocks(const unsigned char *const *cols, std::size_t n,
+                                                         unsigned char *out) noexcept {
+    constexpr std::size_t g = soa_unit<S, F...>(), l = soa_block_records<V, S>;
+    using U = soa_uint_t<g>;
+    std::size_t i = 0;
+    if constexpr (l * S * 8 < V * 7) return i;
+    for (; i + l <= n && i * S + V <= n * S; i += l) {
+        simd<U, V / g> block;
+        if constexpr (!soa_covers<S, F...>()) {
+            block.copy_from(reinterpret_cast<const U *>(out + i * S), element_aligned);
+        }
+        std::size_t f = 0;
+        (merge_field<S, g, l, F>(block, cols[f++] + i * F::size), ...);
+        block.copy_to(reinterpret_cast<U *>(out + i * S), element_aligned);
+    }
+    return i;
+}
+
+} // namespace soa_simd
+#endif
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+namespace soa_avx2 {
+
+template <std::size_t S, class... F>
+SABUROU_PLATFORM_V2_TARGET("avx2")
+inline void split(const unsigned char *in, std::size_t n, unsigned char *const *cols) noexcept {
+    std::size_t done = soa_simd::split_blocks<32, S, F...>(in, n, cols);
+    soa_scalar::split_range<S, F...>(in, done, n, cols);
+}
+
+template <std::size_t S, class... F>
+SABUROU_PLATFORM_V2_TARGET("avx2")
+inline void merge(const unsigned char *const *cols, std::size_t n, unsigned char *out) noexcept {
+    std::size_t done = soa_simd::merge_blocks<32, S, F...>(cols, n, out);
+    soa_scalar::merge_range<S, F...>(cols, done, n, out);
+}
+
+} // namespace soa_avx2
+
+namespace soa_avx512 {
+
+#define SABUROU_PLATFORM_V2_TARGET_SOA_AVX512 SABUROU_PLATFORM_V2_TARGET("avx2,avx512f,avx512bw,avx512vl,avx512vbmi")
+
+template <std::size_t S, class... F>
+SABUROU_PLATFORM_V2_TARGET_SOA_AVX512
+inline void split(const unsigned char *in, std::size_t n, unsigned char *const *cols) noexcept {
+    std::size_t done = soa_simd::split_blocks<64, S, F...>(in, n, cols);
+    soa_scalar::split_range<S, F...>(in, done, n, cols);
+}
+
+template <std::size_t S, class... F>
+SABUROU_PLATFORM_V2_TARGET_SOA_AVX512
+inline void merge(const unsigned char *const *cols, std::size_t n, unsigned char *out) noexcept {
+    std::size_t done = soa_simd::merge_blocks<64, S, F...>(cols, n, out);
+    soa_scalar::merge_range<S, F...>(cols, done, n, out);
+}
+
+#undef SABUROU_PLATFORM_V2_TARGET_SOA_AVX512
+
+} // namespace soa_avx512
+#endif
+
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+namespace soa_neon {
+
+template <std::size_t S, class... F>
+inline void split(const unsigned char *in, std::size_t n, unsigned char *const *cols) noexcept {
+    std::size_t done = soa_simd::split_blocks<16, S, F...>(in, n, cols);
+    soa_scalar::split_range<S, F...>(in, done, n, cols);
+}
+
+template <std::size_t S, class... F>
+inline void merge(const unsigned char *const *cols, std::size_t n, unsigned char *out) noexcept {
+    std::size_t done = soa_simd::merge_blocks<16, S, F...>(cols, n, out);
+    soa_scalar::merge_range<S, F...>(cols, done, n, out);
+}
+
+} // namespace soa_neon
+#endif
+
+} // namespace saburou::platform::v2::bytes::detail
@@ -0,0 +1,360 @@
+#pragma once
+
+/**
+ * @file utf8_kernels.hpp
+ * @brief UTF-8 validation, ASCII and code point counting loops: scalar, AVX2, AVX-512 and NEON.
+ *
+ * The SIMD validators use the Keiser–Lemire lookup algorithm ("Validating UTF-8 In Less Than One Instruction
+ * Per Byte", 2021). Every byte is classified together with the byte before it by three 16-entry nibble
+ * lookups (high nibble of the previous byte, its low nibble, high nibble of the current byte); ANDing them
+ * leaves a bit set exactly for the two-byte error patterns. Third and fourth bytes of long sequences are
+ * checked separately with saturating subtractions on the bytes two and three positions back.
+ *
+ * Blocks with no byte >= 0x80 skip the lookups and only check that the previous block did not end inside a
+ * sequence. The last partial block is zero padded, and a zero byte after an unfinished sequence is an error,
+ * so truncated input needs no extra pass.
+ */
+
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+#include <immintrin.h>
+#endif
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace saburou::platform::v2::bytes::detail {
+
+// Error classes of a (previous byte, current byte) pair. A pair is invalid when all three lookups agree on a bit.
+inline constexpr uint8_t utf8_too_short = 1 << 0;      // 11______ 0_______, 11______ 11______
+inline constexpr uint8_t utf8_too_long = 1 << 1;       // 0_______ 10______
+inline constexpr uint8_t utf8_overlong_3 = 1 << 2;     // 11100000 100_____
+inline constexpr uint8_t utf8_too_large = 1 << 3;      // 11110100 1001____ and above
+inline constexpr uint8_t utf8_surrogate = 1 << 4;      // 11101101 101_____
+inline constexpr uint8_t utf8_overlong_2 = 1 << 5;     // 1100000_ 10______
+inline constexpr uint8_t utf8_too_large_1000 = 1 << 6; // 11110101 1000____ and above
+inline constexpr uint8_t utf8_overlong_4 = 1 << 6;     // 11110000 1000____
+inline constexpr uint8_t utf8_two_conts = 1 << 7;      // 10______ 10______
+inline constexpr uint8_t utf8_carry = utf8_too_short | utf8_too_long | utf8_two_conts;
+
+/** @brief Lookup on the high nibble of the previous byte. */
+inline constexpr std::array<uint8_t, 16> utf8_prev_high = [] {
+    std::array<uint8_t, 16> t{};
+    for (unsigned i = 0; i < 8; ++i) t[i] = utf8_too_long;    // ASCII
+    for (unsigned i = 8; i < 12; ++i) t[i] = utf8_two_conts;  // continuation
+    t[12] = utf8_too_short | utf8_overlong_2;                  // C0..CF
+    t[13] = utf8_too_short;                                    // D0..DF
+    t[14] = utf8_too_short | utf8_overlong_3 | utf8_surrogate; // E0..EF
+    t[15] = utf8_too_short | utf8_too_large | utf8_too_large_1000 | utf8_overlong_4;
+    return t;
+}();
+
+/** @brief Lookup on the low nibble of the previous byte. */
+inline constexpr std::array<uint8_t, 16> utf8_prev_low = [] {
+    std::array<uint8_t, 16> t{};
+    t[0] = utf8_carry | utf8_overlong_3 | utf8_overlong_2 | utf8_overlong_4;
+    t[1] = utf8_carry | utf8_overlong_2;
+    t[2] = t[3] = utf8_carry;
+    t[4] = utf8_carry | utf8_too_large;
+    for (unsigned i = 5; i < 16; ++i) t[i] = utf8_carry | utf8_too_large | utf8_too_large_1000;
+    t[13] |= utf8_surrogate;
+    return t;
+}();
+
+/** @brief Lookup on the high nibble of the current byte. */
+inline constexpr std::array<uint8_t, 16> utf8_cur_high = [] {
+    std::array<uint8_t, 16> t{};
+    constexpr uint8_t cont = utf8_too_long | utf8_overlong_2 | utf8_two_conts;
+    for (unsigned i = 0; i < 8; ++i) t[i] = utf8_too_short;
+    t[8] = cont | utf8_overlong_3 | utf8_too_large_1000 | utf8_overlong_4;
+    t[9] = cont | utf8_overlong_3 | utf8_too_large;
+    t[10] = t[11] = cont | utf8_surrogate | utf8_too_large;
+    for (unsigned i = 12; i < 16; ++i) t[i] = utf8_too_short;
+    return t;
+}();
+
+/**
+ * @brief Largest byte allowed in each of the last 64 positions of a block that ends a sequence: a 4-byte
+ * lead may not start in the last three positions, a 3-byte lead in the last two, any lead in the last one.
+ * Narrower vectors load the tail of the array.
+ */
+inline constexpr std::array<uint8_t, 64> utf8_complete_max = [] {
+    std::array<uint8_t, 64> t{};
+    t.fill(0xFF);
+    t[61] = 0xF0 - 1;
+    t[62] = 0xE0 - 1;
+    t[63] = 0xC0 - 1;
+    return t;
+}();
+
+namespace utf8_scalar {
+
+inline constexpr uint64_t high_bits = 0x8080808080808080ull;
+
+[[nodiscard]] inline bool validate(const unsigned char *p, std::size_t n) noexcept {
+    std::size_t i = 0;
+    while (i < n) {
+        if (n - i >= 8) {
+            uint64_t w;
+            std::memcpy(&w, p + i, 8);
+            if ((w & high_bits) == 0) {
+                i += 8;
+                continue;
+            }
+        }
+        unsigned c = p[i];
+        if (c < 0x80) {
+            ++i;
+            continue;
+        }
+        // Unicode Table 3-7: the second byte range depends on the lead, later bytes are plain 80..BF.
+        std::size_t len;
+        unsigned lo = 0x80, hi = 0xBF;
+        if (c >= 0xC2 && c <= 0xDF) {
+            len = 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            len = 3;
+            if (c == 0xE0) lo = 0xA0;
+            if (c == 0xED) hi = 0x9F;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            len = 4;
+            if (c == 0xF0) lo = 0x90;
+            if (c == 0xF4) hi = 0x8F;
+        } else {
+            return false;
+        }
+        if (n - i < len || p[i + 1] < lo || p[i + 1] > hi) return false;
+        for (std::size_t k = 2; k < len; ++k)
+            if ((p[i + k] & 0xC0) != 0x80) return false;
+        i += len;
+    }
+    return true;
+}
+
+[[nodiscard]] inline bool is_ascii(const unsigned char *p, std::size_t n) noexcept {
+    std::size_t i = 0;
+    uint64_t acc = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        acc |= w;
+    }
+    for (; i < n; ++i) acc |= p[i];
+    return (acc & high_bits) == 0;
+}
+
+/** @brief Bytes that are not continuation bytes (10xxxxxx), i.e. code points of valid UTF-8. */
+[[nodiscard]] inline std::size_t count_codepoints(const unsigned char *p, std::size_t n) noexcept {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) count += static_cast<signed char>(p[i]) > -65;
+    return count;
+}
+
+} // namespace utf8_scalar
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+namespace utf8_avx2 {
+
+SABUROU_PLATFORM_V2_TARGET("avx2") inline __m256i table(const std::array<uint8_t, 16> &t) noexcept {
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(t.data())));
+}
+
+/** @brief @p in shifted right by @p N bytes, with the last @p N bytes of @p prev shifted in. */
+template <int N> SABUROU_PLATFORM_V2_TARGET("avx2") inline __m256i shift_in(__m256i in, __m256i prev) noexcept {
+    return _mm256_alignr_epi8(in, _mm256_permute2x128_si256(prev, in, 0x21), 16 - N);
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx2") inline __m256i errors(__m256i in, __m256i prev) noexcept {
+    const __m256i low4 = _mm256_set1_epi8(0x0F);
+    __m256i prev1 = shift_in<1>(in, prev);
+    __m256i a = _mm256_shuffle_epi8(table(utf8_prev_high), _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low4));
+    __m256i b = _mm256_shuffle_epi8(table(utf8_prev_low), _mm256_and_si256(prev1, low4));
+    __m256i c = _mm256_shuffle_epi8(table(utf8_cur_high), _mm256_and_si256(_mm256_srli_epi16(in, 4), low4));
+    __m256i special = _mm256_and_si256(_mm256_and_si256(a, b), c);
+    // 0x80 where the byte two (three) back is a 3-byte (4-byte) lead, i.e. where a continuation must follow.
+    __m256i third = _mm256_subs_epu8(shift_in<2>(in, prev), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(shift_in<3>(in, prev), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(must23, special);
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx2") inline bool validate(const unsigned char *p, std::size_t n) noexcept {
+    const __m256i complete_max = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(utf8_complete_max.data() + 32));
+    __m256i prev = _mm256_setzero_si256(), error = prev, incomplete = prev;
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        if (_mm256_movemask_epi8(in) == 0) {
+            error = _mm256_or_si256(error, incomplete);
+            incomplete = _mm256_setzero_si256();
+        } else {
+            error = _mm256_or_si256(error, errors(in, prev));
+            incomplete = _mm256_subs_epu8(in, complete_max);
+        }
+        prev = in;
+    }
+    alignas(32) unsigned char last[32] = {};
+    if (i < n) std::memcpy(last, p + i, n - i);
+    error = _mm256_or_si256(error, errors(_mm256_load_si256(reinterpret_cast<const __m256i *>(last)), prev));
+    return _mm256_testz_si256(error, error);
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx2") inline bool is_ascii(const unsigned char *p, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i + 32));
+        if (_mm256_movemask_epi8(_mm256_or_si256(a, b))) return false;
+    }
+    return utf8_scalar::is_ascii(p + i, n - i);
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx2,popcnt")
+inline std::size_t count_codepoints(const unsigned char *p, std::size_t n) noexcept {
+    const __m256i cont_max = _mm256_set1_epi8(-65);
+    std::size_t count = 0, i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        count += std::popcount(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, cont_max))));
+    }
+    return count + utf8_scalar::count_codepoints(p + i, n - i);
+}
+
+} // namespace utf8_avx2
+
+namespace utf8_avx512 {
+
+#define SABUROU_PLATFORM_V2_TARGET_UTF8_AVX512 SABUROU_PLATFORM_V2_TARGET("avx512f,avx512bw,popcnt")
+
+SABUROU_PLATFORM_V2_TARGET_UTF8_AVX512 inline __m512i table(const std::array<uint8_t, 16> &t) noexcept {
+    return _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_loadu_si128(reinterpret_cast<const __m128i *>(t.data())));
+}
+
+template <int N> SABUROU_PLATFORM_V2_TARGET_UTF8_AVX512 inline __m512i shift_in(__m512i in, __m512i prev) noexcept {
+    // 128-bit lanes {prev.3, in.0, in.1, in.2}, so each lane of @p in sees the lane before it.
+    const __m512i lanes = _mm512_set_epi64(5, 4, 3, 2, 1, 0, 15, 14);
+    return _mm512_alignr_epi8(in, _mm512_permutex2var_epi64(in, lanes, prev), 16 - N);
+}
+
+SABUROU_PLATFORM_V2_TARGET_UTF8_AVX512 inline __m512i errors(__m512i in, __m512i prev) noexcept {
+    const __m512i low4 = _mm512_set1_epi8(0x0F);
+    __m512i prev1 = shift_in<1>(in, prev);
+    __m512i a = _mm512_shuffle_epi8(table(utf8_prev_high), _mm512_and_si512(_mm512_srli_epi16(prev1, 4), low4));
+    __m512i b = _mm512_shuffle_epi8(table(utf8_prev_low), _mm512_and_si512(prev1, low4));
+    __m512i c = _mm512_shuffle_epi8(table(utf8_cur_high), _mm512_and_si512(_mm512_srli_epi16(in, 4), low4));
+    __m512i third = _mm512_subs_epu8(shift_in<2>(in, prev), _mm512_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m512i fourth = _mm512_subs_epu8(shift_in<3>(in, prev), _mm512_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    // (a & b & c) ^ ((third | fourth) & 0x80) in two ternary-logic steps.
+    __m512i special = _mm512_ternarylogic_epi32(a, b, c, 0x80);
+    __m512i must23 = _mm512_ternarylogic_epi32(third, fourth, _mm512_set1_epi8(static_cast<char>(0x80)), 0xA8);
+    return _mm512_xor_si512(must23, special);
+}
+
+SABUROU_PLATFORM_V2_TARGET_UTF8_AVX512 inline bool validate(const unsigned char *p, std::size_t n) noexcept {
+    const __m512i complete_max = _mm512_loadu_si512(utf8_complete_max.data());
+    __m512i prev = _mm512_setzero_si512(), error = prev, incomplete = prev;
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i in = _mm512_loadu_si512(p + i);
+        if (_mm512_movepi8_mask(in) == 0) {
+            error = _mm512_or_si512(error, incomplete);
+            incomplete = _mm512_setzero_si512();
+        } else {
+            error = _mm512_or_si512(error, errors(in, prev));
+            incomplete = _mm512_subs_epu8(in, complete_max);
+        }
+        prev = in;
+    }
+    // The masked load zero fills the padding and never touches bytes past the end.
+    __m512i last = _mm512_maskz_loadu_epi8((1ull << (n - i)) - 1, p + i);
+    error = _mm512_or_si512(error, errors(last, prev));
+    return _mm512_test_epi8_mask(error, error) == 0;
+}
+
+SABUROU_PLATFORM_V2_TARGET_UTF8_AVX512 inline bool is_ascii(const unsigned char *p, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 128 <= n; i += 128) {
+        __m512i v = _mm512_or_si512(_mm512_loadu_si512(p + i), _mm512_loadu_si512(p + i + 64));
+        if (_mm512_movepi8_mask(v)) return false;
+    }
+    return utf8_scalar::is_ascii(p + i, n - i);
+}
+
+SABUROU_PLATFORM_V2_TARGET_UTF8_AVX512
+inline std::size_t count_codepoints(const unsigned char *p, std::size_t n) noexcept {
+    const __m512i cont_max = _mm512_set1_epi8(-65);
+    std::size_t count = 0, i = 0;
+    for (; i + 64 <= n; i += 64)
+        count += std::popcount(_mm512_cmpgt_epi8_mask(_mm512_loadu_si512(p + i), cont_max));
+    return count + utf8_scalar::count_codepoints(p + i, n - i);
+}
+
+#undef SABUROU_PLATFORM_V2_TARGET_UTF8_AVX512
+
+} // namespace utf8_avx512
+#endif
+
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+namespace utf8_neon {
+
+inline uint8x16_t errors(uint8x16_t in, uint8x16_t prev) noexcept {
+    uint8x16_t prev1 = vextq_u8(prev, in, 15);
+    uint8x16_t a = vqtbl1q_u8(vld1q_u8(utf8_prev_high.data()), vshrq_n_u8(prev1, 4));
+    uint8x16_t b = vqtbl1q_u8(vld1q_u8(utf8_prev_low.data()), vandq_u8(prev1, vdupq_n_u8(0x0F)));
+    uint8x16_t c = vqtbl1q_u8(vld1q_u8(utf8_cur_high.data()), vshrq_n_u8(in, 4));
+    uint8x16_t special = vandq_u8(vandq_u8(a, b), c);
+    uint8x16_t third = vqsubq_u8(vextq_u8(prev, in, 14), vdupq_n_u8(0xE0 - 0x80));
+    uint8x16_t fourth = vqsubq_u8(vextq_u8(prev, in, 13), vdupq_n_u8(0xF0 - 0x80));
+    uint8x16_t must23 = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+    return veorq_u8(must23, special);
+}
+
+inline bool validate(const unsigned char *p, std::size_t n) noexcept {
+    const uint8x16_t complete_max = vld1q_u8(utf8_complete_max.data() + 48);
+    uint8x16_t prev = vdupq_n_u8(0), error = prev, incomplete = prev;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t in = vld1q_u8(p + i);
+        if (vmaxvq_u8(in) < 0x80) {
+            error = vorrq_u8(error, incomplete);
+            incomplete = vdupq_n_u8(0);
+        } else {
+            error = vorrq_u8(error, errors(in, prev));
+            incomplete = vqsubq_u8(in, complete_max);
+        }
+        prev = in;
+    }
+    unsigned char last[16] = {};
+    if (i < n) std::memcpy(last, p + i, n - i);
+    error = vorrq_u8(error, errors(vld1q_u8(last), prev));
+    return vmaxvq_u8(error) == 0;
+}
+
+inline bool is_ascii(const unsigned char *p, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+        if (vmaxvq_u8(vorrq_u8(vld1q_u8(p + i), vld1q_u8(p + i + 16))) >= 0x80) return false;
+    return utf8_scalar::is_ascii(p + i, n - i);
+}
+
+inline std::size_t count_codepoints(const unsigned char *p, std::size_t n) noexcept {
+    const int8x16_t cont_max = vdupq_n_s8(-65);
+    std::size_t count = 0, i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t lead = vcgtq_s8(vreinterpretq_s8_u8(vld1q_u8(p + i)), cont_max);
+        count += vaddvq_u8(vshrq_n_u8(lead, 7));
+    }
+    return count + utf8_scalar::count_codepoints(p + i, n - i);
+}
+
+} // namespace utf8_neon
+#endif
+
+} // namespace saburou::platform::v2::bytes::detail
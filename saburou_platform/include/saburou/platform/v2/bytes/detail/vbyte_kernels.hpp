@@ -0,0 +1,191 @@
+#pragma once
+
+/**
+ * @file vbyte_kernels.hpp
+ * @brief Decoders for byte-aligned 4-integer groups (Stream VByte, Group Varint): one 2-bit length code per
+ * value in a control byte, values stored little-endian in 1..4 bytes.
+ *
+ * The SIMD kernels expand a whole group with one byte shuffle (pshufb on SSSE3, TBL on NEON) driven by a
+ * 256-entry table indexed by the control byte. They read 16 bytes per group, so callers stop them once fewer
+ * than 16 input bytes remain and finish with the scalar decoder.
+ */
+
+#include <saburou/platform/v2/bytes/endian/little.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+#include <immintrin.h>
+#endif
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace saburou::platform::v2::bytes::detail {
+
+/** @brief Length code of @p v: bytes needed minus one. */
+[[nodiscard]] constexpr unsigned vbyte_code(uint32_t v) noexcept {
+    return static_cast<unsigned>(v > 0xFF) + static_cast<unsigned>(v > 0xFFFF) + static_cast<unsigned>(v > 0xFFFFFF);
+}
+
+/** @brief Data bytes of the four values described by each control byte. */
+inline constexpr std::array<uint8_t, 256> vbyte_lengths = [] {
+    std::array<uint8_t, 256> t{};
+    for (unsigned c = 0; c < 256; ++c) {
+        t[c] = static_cast<uint8_t>(4 + (c & 3) + ((c >> 2) & 3) + ((c >> 4) & 3) + (c >> 6));
+    }
+    return t;
+}();
+
+/** @brief Shuffle moving each value's bytes to its 32-bit lane; 0xFF lanes are zeroed. */
+struct alignas(16) vbyte_shuffle_t {
+    uint8_t lane[16];
+};
+
+inline constexpr std::array<vbyte_shuffle_t, 256> vbyte_shuffles = [] {
+    std::array<vbyte_shuffle_t, 256> t{};
+    for (unsigned c = 0; c < 256; ++c) {
+        uint8_t src = 0;
+        for (unsigned i = 0; i < 4; ++i) {
+            unsigned len = ((c >> (2 * i)) & 3) + 1;
+            for (unsigned b = 0; b < 4; ++b) t[c].lane[4 * i + b] = b < len ? src++ : 0xFF;
+        }
+    }
+    return t;
+}();
+
+/** @brief Reads one value of @p code + 1 bytes. */
+[[nodiscard]] inline uint32_t vbyte_get(const unsigned char *p, unsigned code) noexcept {
+    uint32_t v = 0;
+    std::memcpy(&v, p, code + 1);
+    return endian::from_little(v);
+}
+
+/** @brief Writes @p v in @p code + 1 bytes. */
+inline void vbyte_put(unsigned char *p, uint32_t v, unsigned code) noexcept {
+    v = endian::to_little(v);
+    std::memcpy(p, &v, code + 1);
+}
+
+/** @brief Scalar decode of the first @p count (1..4) values of a group; returns the bytes read. */
+inline std::size_t vbyte_decode_group(unsigned control, const unsigned char *data, uint32_t *out,
+                                      std::size_t count) noexcept {
+    std::size_t used = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        unsigned code = (control >> (2 * i)) & 3;
+        out[i] = vbyte_get(data + used, code);
+        used += code + 1;
+    }
+    return used;
+}
+
+/** @brief Like vbyte_decode_group() for a full group, reading 4 bytes per value: needs 16 readable bytes. */
+inline std::size_t vbyte_decode_group_wide(unsigned control, const unsigned char *data, uint32_t *out) noexcept {
+    std::size_t used = 0;
+    for (std::size_t i = 0; i < 4; ++i) {
+        unsigned code = (control >> (2 * i)) & 3;
+        uint32_t v;
+        std::memcpy(&v, data + used, 4);
+        out[i] = endian::from_little(v) & (0xFFFFFFFFu >> (8 * (3 - code)));
+        used += code + 1;
+    }
+    return used;
+}
+
+/**
+ * @brief Position of a group decoder: @p groups full groups left, controls at @p control (Stream VByte) or
+ * inline before each group's data (Group Varint).
+ */
+struct vbyte_cursor_t {
+    const unsigned char *control;
+    const unsigned char *data;
+    uint32_t *out;
+    std::size_t groups;
+};
+
+namespace vbyte_scalar {
+
+inline void stream_decode(vbyte_cursor_t &c, const unsigned char *data_end) noexcept {
+    for (; c.groups && data_end - c.data >= 16; --c.groups, ++c.control, c.out += 4)
+        c.data += vbyte_decode_group_wide(*c.control, c.data, c.out);
+    for (; c.groups; --c.groups, ++c.control, c.out += 4) c.data += vbyte_decode_group(*c.control, c.data, c.out, 4);
+}
+
+inline void group_decode(vbyte_cursor_t &c, const unsigned char *data_end) noexcept {
+    for (; c.groups && data_end - c.data >= 17; --c.groups, c.out += 4)
+        c.data += 1 + vbyte_decode_group_wide(*c.data, c.data + 1, c.out);
+}
+
+} // namespace vbyte_scalar
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+namespace vbyte_ssse3 {
+
+SABUROU_PLATFORM_V2_TARGET("ssse3")
+inline void expand(unsigned control, const unsigned char *data, uint32_t *out) noexcept {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i *>(vbyte_shuffles[control].lane));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_shuffle_epi8(v, shuffle));
+}
+
+SABUROU_PLATFORM_V2_TARGET("ssse3")
+inline void stream_decode(vbyte_cursor_t &c, const unsigned char *data_end) noexcept {
+    const unsigned char *control = c.control, *data = c.data;
+    uint32_t *out = c.out;
+    std::size_t groups = c.groups;
+    for (; groups && data_end - data >= 16; --groups, out += 4) {
+        unsigned k = *control++;
+        expand(k, data, out);
+        data += vbyte_lengths[k];
+    }
+    c = {control, data, out, groups};
+}
+
+SABUROU_PLATFORM_V2_TARGET("ssse3")
+inline void group_decode(vbyte_cursor_t &c, const unsigned char *data_end) noexcept {
+    const unsigned char *data = c.data;
+    uint32_t *out = c.out;
+    std::size_t groups = c.groups;
+    for (; groups && data_end - data >= 17; --groups, out += 4) {
+        unsigned k = *data;
+        expand(k, data + 1, out);
+        data += 1 + vbyte_lengths[k];
+    }
+    c = {c.control, data, out, groups};
+}
+
+} // namespace vbyte_ssse3
+#endif
+
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+namespace vbyte_neon {
+
+inline void expand(unsigned control, const unsigned char *data, uint32_t *out) noexcept {
+    uint8x16_t v = vqtbl1q_u8(vld1q_u8(data), vld1q_u8(vbyte_shuffles[control].lane));
+    vst1q_u32(out, vreinterpretq_u32_u8(v));
+}
+
+inline void stream_decode(vbyte_cursor_t &c, const unsigned char *data_end) noexcept {
+    for (; c.groups && data_end - c.data >= 16; --c.groups, c.out += 4) {
+        unsigned k = *c.control++;
+        expand(k, c.data, c.out);
+        c.data += vbyte_lengths[k];
+    }
+}
+
+inline void group_decode(vbyte_cursor_t &c, const unsigned char *data_end) noexcept {
+    for (; c.groups && data_end - c.data >= 17; --c.groups, c.out += 4) {
+        unsigned k = *c.data;
+        expand(k, c.data + 1, c.out);
+        c.data += 1 + vbyte_lengths[k];
+    }
+}
+
+} // namespace vbyte_neon
+#endif
+
+} // namespace saburou::platform::v2::bytes::detail
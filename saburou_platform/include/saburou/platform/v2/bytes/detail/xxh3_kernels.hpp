@@ -0,0 +1,314 @@
+#pragma once
+
+/**
+ * @file xxh3_kernels.hpp
+ * @brief XXH3 building blocks: constants, default secret, 64/128-bit mixers, and the stripe accumulate and
+ * scramble loops in scalar, SSE2, AVX2, AVX-512 and NEON versions.
+ *
+ * Every multi-byte read goes through endian::from_little, so the scalar kernels give the same accumulator
+ * state on big-endian hosts. The SIMD kernels only exist on little-endian targets.
+ */
+
+#include <saburou/platform/v2/bytes/endian/little.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+#include <saburou/platform/v2/detect.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+#include <immintrin.h>
+#endif
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace saburou::platform::v2::bytes::detail {
+
+inline constexpr uint32_t xxh_prime32_1 = 0x9E3779B1u;
+inline constexpr uint32_t xxh_prime32_2 = 0x85EBCA77u;
+inline constexpr uint32_t xxh_prime32_3 = 0xC2B2AE3Du;
+inline constexpr uint64_t xxh_prime64_1 = 0x9E3779B185EBCA87ull;
+inline constexpr uint64_t xxh_prime64_2 = 0xC2B2AE3D27D4EB4Full;
+inline constexpr uint64_t xxh_prime64_3 = 0x165667B19E3779F9ull;
+inline constexpr uint64_t xxh_prime64_4 = 0x85EBCA77C2B2AE63ull;
+inline constexpr uint64_t xxh_prime64_5 = 0x27D4EB2F165667C5ull;
+inline constexpr uint64_t xxh_prime_mx1 = 0x165667919E3779F9ull;
+inline constexpr uint64_t xxh_prime_mx2 = 0x9FB21C651E98DF25ull;
+
+inline constexpr std::size_t xxh3_stripe_len = 64;      ///< Bytes per accumulate step
+inline constexpr std::size_t xxh3_secret_size = 192;    ///< Default secret length
+inline constexpr std::size_t xxh3_secret_consume = 8;   ///< Secret advance per stripe
+inline constexpr std::size_t xxh3_stripes_per_block = (xxh3_secret_size - xxh3_stripe_len) / xxh3_secret_consume;
+inline constexpr std::size_t xxh3_block_len = xxh3_stripe_len * xxh3_stripes_per_block;
+inline constexpr std::size_t xxh3_midsize_max = 240;    ///< Longest input hashed without accumulators
+
+/** @brief The reference implementation's default secret. */
+alignas(64) inline constexpr unsigned char xxh3_default_secret[xxh3_secret_size] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+/** @brief Accumulator seeds for the long-input loop. */
+inline constexpr uint64_t xxh3_init_acc[8] = {xxh_prime32_3, xxh_prime64_1, xxh_prime64_2, xxh_prime64_3,
+                                              xxh_prime64_4, xxh_prime32_2, xxh_prime64_5, xxh_prime32_1};
+
+// -- Scalar helpers --
+
+[[nodiscard]] inline uint32_t xxh_read32(const unsigned char *p) noexcept {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return endian::from_little(v);
+}
+
+[[nodiscard]] inline uint64_t xxh_read64(const unsigned char *p) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return endian::from_little(v);
+}
+
+inline void xxh_write64(unsigned char *p, uint64_t v) noexcept {
+    v = endian::to_little(v);
+    std::memcpy(p, &v, 8);
+}
+
+/** @brief Full 64x64 -> 128-bit product. */
+struct xxh_u128_t {
+    uint64_t low = 0;
+    uint64_t high = 0;
+};
+
+[[nodiscard]] inline xxh_u128_t xxh_mul128(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 u128_t; // __extension__ keeps -Wpedantic quiet
+    u128_t p = static_cast<u128_t>(a) * b;
+    return {static_cast<uint64_t>(p), static_cast<uint64_t>(p >> 64)};
+#else
+    uint64_t lo_lo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+    uint64_t hi_lo = (a >> 32) * (b & 0xFFFFFFFF);
+    uint64_t lo_hi = (a & 0xFFFFFFFF) * (b >> 32);
+    uint64_t hi_hi = (a >> 32) * (b >> 32);
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    return {(cross << 32) | (lo_lo & 0xFFFFFFFF), (hi_lo >> 32) + (cross >> 32) + hi_hi};
+#endif
+}
+
+[[nodiscard]] inline uint64_t xxh_mul128_fold64(uint64_t a, uint64_t b) noexcept {
+    xxh_u128_t p = xxh_mul128(a, b);
+    return p.low ^ p.high;
+}
+
+[[nodiscard]] constexpr uint64_t xxh64_avalanche(uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= xxh_prime64_2;
+    h ^= h >> 29;
+    h *= xxh_prime64_3;
+    return h ^ (h >> 32);
+}
+
+[[nodiscard]] constexpr uint64_t xxh3_avalanche(uint64_t h) noexcept {
+    h ^= h >> 37;
+    h *= xxh_prime_mx1;
+    return h ^ (h >> 32);
+}
+
+/** @brief Stronger finalizer used by the 4..8 byte path. */
+[[nodiscard]] constexpr uint64_t xxh3_rrmxmx(uint64_t h, uint64_t len) noexcept {
+    h ^= ((h << 49) | (h >> 15)) ^ ((h << 24) | (h >> 40));
+    h *= xxh_prime_mx2;
+    h ^= (h >> 35) + len;
+    h *= xxh_prime_mx2;
+    return h ^ (h >> 28);
+}
+
+[[nodiscard]] inline uint64_t xxh3_mix16(const unsigned char *p, const unsigned char *secret, uint64_t seed) noexcept {
+    return xxh_mul128_fold64(xxh_read64(p) ^ (xxh_read64(secret) + seed),
+                             xxh_read64(p + 8) ^ (xxh_read64(secret + 8) - seed));
+}
+
+/** @brief Secret derived from a non-zero seed for the long-input loop. */
+inline void xxh3_derive_secret(unsigned char *out, uint64_t seed) noexcept {
+    for (std::size_t i = 0; i < xxh3_secret_size; i += 16) {
+        xxh_write64(out + i, xxh_read64(xxh3_default_secret + i) + seed);
+        xxh_write64(out + i + 8, xxh_read64(xxh3_default_secret + i + 8) - seed);
+    }
+}
+
+// -- Stripe kernels: accumulate @p stripes stripes of 64 bytes, advancing the secret 8 bytes per stripe. --
+
+namespace xxh3_scalar {
+
+inline void accumulate(uint64_t *acc, const unsigned char *p, const unsigned char *secret,
+                       std::size_t stripes) noexcept {
+    for (; stripes; --stripes, p += xxh3_stripe_len, secret += xxh3_secret_consume) {
+        for (std::size_t i = 0; i < 8; ++i) {
+            uint64_t data = xxh_read64(p + 8 * i);
+            uint64_t key = data ^ xxh_read64(secret + 8 * i);
+            acc[i ^ 1] += data;
+            acc[i] += (key & 0xFFFFFFFF) * (key >> 32);
+        }
+    }
+}
+
+inline void scramble(uint64_t *acc, const unsigned char *secret) noexcept {
+    for (std::size_t i = 0; i < 8; ++i) {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= xxh_read64(secret + 8 * i);
+        acc[i] = a * xxh_prime32_1;
+    }
+}
+
+} // namespace xxh3_scalar
+
+#if SABUROU_PLATFORM_V2_SIMD_X86
+namespace xxh3_sse2 {
+
+SABUROU_PLATFORM_V2_TARGET("sse2")
+inline void accumulate(uint64_t *acc, const unsigned char *p, const unsigned char *secret,
+                       std::size_t stripes) noexcept {
+    __m128i a[4];
+    for (int i = 0; i < 4; ++i) a[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc) + i);
+    for (; stripes; --stripes, p += xxh3_stripe_len, secret += xxh3_secret_consume) {
+        for (int i = 0; i < 4; ++i) {
+            __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p) + i);
+            __m128i key = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret) + i));
+            __m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+            __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            a[i] = _mm_add_epi64(a[i], _mm_add_epi64(product, swapped));
+        }
+    }
+    for (int i = 0; i < 4; ++i) _mm_storeu_si128(reinterpret_cast<__m128i *>(acc) + i, a[i]);
+}
+
+SABUROU_PLATFORM_V2_TARGET("sse2")
+inline void scramble(uint64_t *acc, const unsigned char *secret) noexcept {
+    const __m128i prime = _mm_set1_epi32(static_cast<int>(xxh_prime32_1));
+    for (int i = 0; i < 4; ++i) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc) + i);
+        a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+        a = _mm_xor_si128(a, _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret) + i));
+        __m128i lo = _mm_mul_epu32(a, prime);
+        __m128i hi = _mm_mul_epu32(_mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(acc) + i, _mm_add_epi64(lo, _mm_slli_epi64(hi, 32)));
+    }
+}
+
+} // namespace xxh3_sse2
+
+namespace xxh3_avx2 {
+
+SABUROU_PLATFORM_V2_TARGET("avx2")
+inline void accumulate(uint64_t *acc, const unsigned char *p, const unsigned char *secret,
+                       std::size_t stripes) noexcept {
+    __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc));
+    __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc) + 1);
+    for (; stripes; --stripes, p += xxh3_stripe_len, secret += xxh3_secret_consume) {
+        __m256i d0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        __m256i d1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p) + 1);
+        __m256i k0 = _mm256_xor_si256(d0, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(secret)));
+        __m256i k1 = _mm256_xor_si256(d1, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(secret) + 1));
+        __m256i m0 = _mm256_mul_epu32(k0, _mm256_srli_epi64(k0, 32));
+        __m256i m1 = _mm256_mul_epu32(k1, _mm256_srli_epi64(k1, 32));
+        a0 = _mm256_add_epi64(a0, _mm256_add_epi64(m0, _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2))));
+        a1 = _mm256_add_epi64(a1, _mm256_add_epi64(m1, _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc), a0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc) + 1, a1);
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx2")
+inline void scramble(uint64_t *acc, const unsigned char *secret) noexcept {
+    const __m256i prime = _mm256_set1_epi32(static_cast<int>(xxh_prime32_1));
+    for (int i = 0; i < 2; ++i) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc) + i);
+        a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+        a = _mm256_xor_si256(a, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(secret) + i));
+        __m256i lo = _mm256_mul_epu32(a, prime);
+        __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc) + i, _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32)));
+    }
+}
+
+} // namespace xxh3_avx2
+
+namespace xxh3_avx512 {
+
+// The unmasked 512-bit shift/multiply intrinsics trip GCC 12's -Wuninitialized through _mm512_undefined_*();
+// the zero-masked forms with a full mask compile to the same instructions.
+
+SABUROU_PLATFORM_V2_TARGET("avx512f")
+inline __m512i mul32(__m512i a, __m512i b) noexcept { return _mm512_maskz_mul_epu32(0xFF, a, b); }
+
+SABUROU_PLATFORM_V2_TARGET("avx512f")
+inline __m512i high32(__m512i a) noexcept { return _mm512_maskz_srli_epi64(0xFF, a, 32); }
+
+SABUROU_PLATFORM_V2_TARGET("avx512f")
+inline void accumulate(uint64_t *acc, const unsigned char *p, const unsigned char *secret,
+                       std::size_t stripes) noexcept {
+    __m512i a = _mm512_loadu_si512(acc);
+    for (; stripes; --stripes, p += xxh3_stripe_len, secret += xxh3_secret_consume) {
+        __m512i d = _mm512_loadu_si512(p);
+        __m512i k = _mm512_xor_si512(d, _mm512_loadu_si512(secret));
+        __m512i swapped = _mm512_maskz_shuffle_epi32(0xFFFF, d, _MM_PERM_BADC);
+        a = _mm512_add_epi64(a, _mm512_add_epi64(mul32(k, high32(k)), swapped));
+    }
+    _mm512_storeu_si512(acc, a);
+}
+
+SABUROU_PLATFORM_V2_TARGET("avx512f")
+inline void scramble(uint64_t *acc, const unsigned char *secret) noexcept {
+    __m512i a = _mm512_loadu_si512(acc);
+    a = _mm512_ternarylogic_epi64(a, _mm512_maskz_srli_epi64(0xFF, a, 47), _mm512_loadu_si512(secret), 0x96);
+    const __m512i prime = _mm512_set1_epi32(static_cast<int>(xxh_prime32_1));
+    __m512i hi = _mm512_maskz_slli_epi64(0xFF, mul32(high32(a), prime), 32);
+    _mm512_storeu_si512(acc, _mm512_add_epi64(mul32(a, prime), hi));
+}
+
+} // namespace xxh3_avx512
+#endif
+
+#if SABUROU_PLATFORM_V2_SIMD_NEON
+namespace xxh3_neon {
+
+inline void accumulate(uint64_t *acc, const unsigned char *p, const unsigned char *secret,
+                       std::size_t stripes) noexcept {
+    uint64x2_t a[4];
+    for (int i = 0; i < 4; ++i) a[i] = vld1q_u64(acc + 2 * i);
+    for (; stripes; --stripes, p += xxh3_stripe_len, secret += xxh3_secret_consume) {
+        for (int i = 0; i < 4; ++i) {
+            uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(p + 16 * i));
+            uint64x2_t key = veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+            a[i] = vaddq_u64(a[i], vextq_u64(data, data, 1));
+            a[i] = vmlal_u32(a[i], vmovn_u64(key), vshrn_n_u64(key, 32));
+        }
+    }
+    for (int i = 0; i < 4; ++i) vst1q_u64(acc + 2 * i, a[i]);
+}
+
+inline void scramble(uint64_t *acc, const unsigned char *secret) noexcept {
+    const uint32x2_t prime = vdup_n_u32(xxh_prime32_1);
+    for (int i = 0; i < 4; ++i) {
+        uint64x2_t a = vld1q_u64(acc + 2 * i);
+        a = veorq_u64(a, vshrq_n_u64(a, 47));
+        a = veorq_u64(a, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+        uint64x2_t hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(a, 32), prime), 32);
+        vst1q_u64(acc + 2 * i, vmlal_u32(hi, vmovn_u64(a), prime));
+    }
+}
+
+} // namespace xxh3_neon
+#endif
+
+} // namespace saburou::platform::v2::bytes::detail
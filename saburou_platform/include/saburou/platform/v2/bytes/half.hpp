@@ -0,0 +1,244 @@
+#pragma once
+
+/**
+ * @file half.hpp
+ * @brief 16-bit floating point storage types (IEEE fp16 and bfloat16) and bulk conversion to and from fp32.
+ *
+ * fp16_t and bf16_t only hold bits: arithmetic happens in float after widening. As plain 16-bit structs they
+ * satisfy ByteSwappable, so byte_swap(), endian::to_big() and mapped_file::load_big() work on them directly
+ * (std::float16_t would not: floating types lack unique object representations).
+ *
+ * Narrowing rounds to nearest, ties to even, and overflows to infinity; NaNs stay NaN. The bulk functions use
+ * AVX-512 (VCVTPH2PS/VCVTPS2PH, VCVTNEPS2BF16 with AVX512-BF16), F16C/AVX2 or NEON FCVTL/FCVTN, picked at run
+ * time, and agree bit for bit with the scalar functions. Bulk bf16 narrowing can opt into
+ * subnormal_mode_t::flush_to_zero, which lets AVX512-BF16 CPUs use VCVTNEPS2BF16; that instruction narrows
+ * fp32 subnormals to signed zero.
+ *
+ * @code
+ * std::vector<float> row(dim);
+ * bytes::load_fp16(file.bytes(offset, 2 * dim), row, std::endian::big); // big-endian fp16 on disk
+ * bytes::to_bf16(row, packed);
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/byte_swap.hpp>
+#include <saburou/platform/v2/bytes/detail/half_kernels.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+
+namespace saburou::platform::v2::bytes {
+
+/** @brief IEEE 754 binary16: 1 sign, 5 exponent, 10 mantissa bits. */
+struct fp16_t {
+    uint16_t bits = 0;
+
+    /** @brief Bitwise comparison (+0 != -0, NaN == NaN with the same payload). */
+    friend constexpr bool operator==(fp16_t, fp16_t) noexcept = default;
+};
+
+/** @brief bfloat16: the upper half of an fp32 (1 sign, 8 exponent, 7 mantissa bits). */
+struct bf16_t {
+    uint16_t bits = 0;
+
+    /** @brief Bitwise comparison (+0 != -0, NaN == NaN with the same payload). */
+    friend constexpr bool operator==(bf16_t, bf16_t) noexcept = default;
+};
+
+/**
+ * @brief How bulk bf16 narrowing treats fp32 subnormals (below 1.2e-38).
+ */
+enum class subnormal_mode_t : uint8_t {
+    preserve,     // Round to the nearest bf16 subnormal, exactly as to_bf16(float)
+    flush_to_zero // May narrow them to signed zero, for the faster AVX512-BF16 conversion
+};
+
+/**
+ * @brief Converts a subnormal_mode_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(subnormal_mode_t m) {
+    switch (m) {
+    case subnormal_mode_t::preserve:      return "preserve";
+    case subnormal_mode_t::flush_to_zero: return "flush_to_zero";
+    default:                              return "unknown";
+    }
+}
+
+static_assert(ByteSwappable<fp16_t> && sizeof(fp16_t) == 2);
+static_assert(ByteSwappable<bf16_t> && sizeof(bf16_t) == 2);
+
+[[nodiscard]] constexpr float to_fp32(fp16_t h) noexcept { return detail::fp16_bits_to_float(h.bits); }
+[[nodiscard]] constexpr float to_fp32(bf16_t b) noexcept { return detail::bf16_bits_to_float(b.bits); }
+[[nodiscard]] constexpr fp16_t to_fp16(float f) noexcept { return {detail::float_to_fp16_bits(f)}; }
+[[nodiscard]] constexpr bf16_t to_bf16(float f) noexcept { return {detail::float_to_bf16_bits(f)}; }
+
+namespace detail {
+
+/** @brief Conversion loops selected once per process; index 0 reads/writes host order, 1 byte-swapped. */
+struct half_kernels_t {
+    using widen_fn = void (*)(const unsigned char *, std::size_t, float *) noexcept;
+    using narrow_fn = void (*)(const float *, std::size_t, unsigned char *) noexcept;
+    widen_fn fp16_widen[2];
+    narrow_fn fp16_narrow[2];
+    widen_fn bf16_widen[2];
+    narrow_fn bf16_narrow[2];
+    narrow_fn bf16_narrow_ftz[2]; ///< subnormal_mode_t::flush_to_zero
+};
+
+[[nodiscard]] inline half_kernels_t select_half_kernels(const cpu::features_t &f) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_X86
+    if (f.avx512f && f.avx512bw && f.avx2 && f.f16c) {
+        namespace k = half_avx512;
+        half_kernels_t t{{k::fp16_widen<false>, k::fp16_widen<true>},
+                         {k::fp16_narrow<false>, k::fp16_narrow<true>},
+                         {k::bf16_widen<false>, k::bf16_widen<true>},
+                         {half_avx2::bf16_narrow<false>, half_avx2::bf16_narrow<true>},
+                         {half_avx2::bf16_narrow<false>, half_avx2::bf16_narrow<true>}};
+        if (f.avx512bf16) t.bf16_narrow_ftz[0] = k::bf16_narrow<false>, t.bf16_narrow_ftz[1] = k::bf16_narrow<true>;
+        return t;
+    }
+    if (f.avx2 && f.f16c) {
+        namespace k = half_avx2;
+        return {{k::fp16_widen<false>, k::fp16_widen<true>},
+                {k::fp16_narrow<false>, k::fp16_narrow<true>},
+                {k::bf16_widen<false>, k::bf16_widen<true>},
+                {k::bf16_narrow<false>, k::bf16_narrow<true>},
+                {k::bf16_narrow<false>, k::bf16_narrow<true>}};
+    }
+#elif SABUROU_PLATFORM_V2_SIMD_NEON
+    if (f.neon) {
+        namespace k = half_neon;
+        return {{k::fp16_widen<false>, k::fp16_widen<true>},
+                {k::fp16_narrow<false>, k::fp16_narrow<true>},
+                {k::bf16_widen<false>, k::bf16_widen<true>},
+                {k::bf16_narrow<false>, k::bf16_narrow<true>},
+                {k::bf16_narrow<false>, k::bf16_narrow<true>}};
+    }
+#endif
+    (void)f;
+    namespace k = half_scalar;
+    return {{k::fp16_widen<false>, k::fp16_widen<true>},
+            {k::fp16_narrow<false>, k::fp16_narrow<true>},
+            {k::bf16_widen<false>, k::bf16_widen<true>},
+            {k::bf16_narrow<false>, k::bf16_narrow<true>},
+            {k::bf16_narrow<false>, k::bf16_narrow<true>}};
+}
+
+[[nodiscard]] inline const half_kernels_t &half_kernels() noexcept {
+    static const half_kernels_t k = select_half_kernels(cpu::features());
+    return k;
+}
+
+/** @brief bf16 narrowing kernels for @p mode. */
+[[nodiscard]] inline const half_kernels_t::narrow_fn *bf16_narrow(subnormal_mode_t mode) noexcept {
+    const half_kernels_t &k = half_kernels();
+    return mode == subnormal_mode_t::flush_to_zero ? k.bf16_narrow_ftz : k.bf16_narrow;
+}
+
+/** @brief Kernel index for data stored in byte order @p order. */
+[[nodiscard]] constexpr int half_swap(std::endian order) noexcept { return order == std::endian::native ? 0 : 1; }
+
+template <class T> [[nodiscard]] inline const unsigned char *half_bytes(const T *p) noexcept {
+    return reinterpret_cast<const unsigned char *>(p);
+}
+
+template <class T> [[nodiscard]] inline unsigned char *half_bytes(T *p) noexcept {
+    return reinterpret_cast<unsigned char *>(p);
+}
+
+} // namespace detail
+
+/** @brief Widens @p in to fp32. @pre out.size() >= in.size(). */
+inline void to_fp32(std::span<const fp16_t> in, std::span<float> out) noexcept {
+    detail::half_kernels().fp16_widen[0](detail::half_bytes(in.data()), in.size(), out.data());
+}
+
+/** @brief Widens @p in to fp32 (exact). @pre out.size() >= in.size(). */
+inline void to_fp32(std::span<const bf16_t> in, std::span<float> out) noexcept {
+    detail::half_kernels().bf16_widen[0](detail::half_bytes(in.data()), in.size(), out.data());
+}
+
+/** @brief Narrows @p in to fp16, rounding to nearest even. @pre out.size() >= in.size(). */
+inline void to_fp16(std::span<const float> in, std::span<fp16_t> out) noexcept {
+    detail::half_kernels().fp16_narrow[0](in.data(), in.size(), detail::half_bytes(out.data()));
+}
+
+/** @brief Narrows @p in to bf16, rounding to nearest even. @pre out.size() >= in.size(). */
+inline void to_bf16(std::span<const float> in, std::span<bf16_t> out,
+                    subnormal_mode_t mode = subnormal_mode_t::preserve) noexcept {
+    detail::bf16_narrow(mode)[0](in.data(), in.size(), detail::half_bytes(out.data()));
+}
+
+/**
+ * @brief Widens the fp16 values stored in @p in with byte order @p order (no alignment needed).
+ * @pre in.size() is even and out.size() >= in.size() / 2.
+ */
+inline void load_fp16(std::span<const std::byte> in, std::span<float> out, std::endian order) noexcept {
+    detail::half_kernels().fp16_widen[detail::half_swap(order)](detail::half_bytes(in.data()), in.size() / 2,
+                                                                 out.data());
+}
+
+/** @brief bf16 counterpart of load_fp16(). @pre in.size() is even and out.size() >= in.size() / 2. */
+inline void load_bf16(std::span<const std::byte> in, std::span<float> out, std::endian order) noexcept {
+    detail::half_kernels().bf16_widen[detail::half_swap(order)](detail::half_bytes(in.data()), in.size() / 2,
+                                                                 out.data());
+}
+
+/** @brief Narrows @p in to fp16 stored with byte order @p order. @pre out.size() >= 2 * in.size(). */
+inline void store_fp16(std::span<const float> in, std::span<std::byte> out, std::endian order) noexcept {
+    detail::half_kernels().fp16_narrow[detail::half_swap(order)](in.data(), in.size(), detail::half_bytes(out.data()));
+}
+
+/** @brief Narrows @p in to bf16 stored with byte order @p order. @pre out.size() >= 2 * in.size(). */
+inline void store_bf16(std::span<const float> in, std::span<std::byte> out, std::endian order,
+                       subnormal_mode_t mode = subnormal_mode_t::preserve) noexcept {
+    detail::bf16_narrow(mode)[detail::half_swap(order)](in.data(), in.size(), detail::half_bytes(out.data()));
+}
+
+} // namespace saburou::platform::v2::bytes
+
+/**
+ * @brief std::formatter specialization for fp16_t: formats the widened value with the float format specifiers.
+ */
+template <> struct std::formatter<saburou::platform::v2::bytes::fp16_t> : std::formatter<float> {
+    auto format(saburou::platform::v2::bytes::fp16_t h, std::format_context &ctx) const {
+        return std::formatter<float>::format(saburou::platform::v2::bytes::to_fp32(h), ctx);
+    }
+};
+
+/**
+ * @brief std::formatter specialization for bf16_t: formats the widened value with the float format specifiers.
+ */
+template <> struct std::formatter<saburou::platform::v2::bytes::bf16_t> : std::formatter<float> {
+    auto format(saburou::platform::v2::bytes::bf16_t b, std::format_context &ctx) const {
+        return std::formatter<float>::format(saburou::platform::v2::bytes::to_fp32(b), ctx);
+    }
+};
+
+/**
+ * @brief std::formatter specialization for subnormal_mode_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "subnormal_mode_t::preserve").
+ */
+template <> struct std::formatter<saburou::platform::v2::bytes::subnormal_mode_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for subnormal_mode_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::bytes::subnormal_mode_t &m, std::format_context &ctx) const {
+        const char *name = saburou::platform::v2::bytes::to_code_name(m);
+        return repr ? std::format_to(ctx.out(), "subnormal_mode_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file hex.hpp
+ * @brief Hexadecimal encoding of byte strings into caller buffers, with AVX2/NEON kernels.
+ *
+ * to_hex() writes two digits per byte, high nibble first. from_hex() accepts either case (mixed too) and
+ * nothing else: no prefix, separators or whitespace. Errors follow varint.hpp: @c no_buffer_space for a too
+ * small output, @c message_size for an odd number of digits, @c illegal_byte_sequence for a non-digit.
+ *
+ * @code
+ * char id[bytes::hex_encoded_size(16)];
+ * auto n = bytes::to_hex(std::as_bytes(std::span{uuid}), id);
+ * log("request {}", std::string_view{id, *n});
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/detail/hex_kernels.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+namespace saburou::platform::v2::bytes {
+
+/**
+ * @brief Letter case of the digits a-f written by to_hex().
+ */
+enum class hex_case_t : uint8_t {
+    lower, // 0-9a-f
+    upper  // 0-9A-F
+};
+
+/**
+ * @brief Converts a hex_case_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(hex_case_t c) {
+    switch (c) {
+    case hex_case_t::lower: return "lower";
+    case hex_case_t::upper: return "upper";
+    default:                return "unknown";
+    }
+}
+
+namespace detail {
+
+/** @brief Hex loops selected once per process. */
+struct hex_kernels_t {
+    std::size_t (*encode)(const unsigned char *, std::size_t, char *, bool) noexcept;
+    std::size_t (*decode)(const char *, std::size_t, unsigned char *) noexcept;
+};
+
+[[nodiscard]] inline hex_kernels_t select_hex_kernels(const cpu::features_t &f) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_X86
+    if (f.avx2) return {hex_avx2::encode, hex_avx2::decode};
+#elif SABUROU_PLATFORM_V2_SIMD_NEON
+    if (f.neon) return {hex_neon::encode, hex_neon::decode};
+#endif
+    (void)f;
+    return {hex_scalar::encode, hex_scalar::decode};
+}
+
+[[nodiscard]] inline const hex_kernels_t &hex_kernels() noexcept {
+    static const hex_kernels_t k = select_hex_kernels(cpu::features());
+    return k;
+}
+
+} // namespace detail
+
+/** @brief Characters to_hex() writes for @p n bytes. */
+[[nodiscard]] constexpr std::size_t hex_encoded_size(std::size_t n) noexcept { return 2 * n; }
+
+/**
+ * @brief Writes the hex digits of @p in to @p out.
+ * @return Characters written (2 * in.size()), or @c no_buffer_space.
+ */
+[[nodiscard]] inline std::expected<std::size_t, std::error_code>
+to_hex(std::span<const std::byte> in, std::span<char> out, hex_case_t letters = hex_case_t::lower) noexcept {
+    std::size_t n = in.size();
+    if (out.size() < hex_encoded_size(n)) return std::unexpected(std::make_error_code(std::errc::no_buffer_space));
+    const auto *p = reinterpret_cast<const unsigned char *>(in.data());
+    bool upper = letters == hex_case_t::upper;
+    std::size_t done = detail::hex_kernels().encode(p, n, out.data(), upper);
+    detail::hex_scalar::encode(p + done, n - done, out.data() + 2 * done, upper);
+    return hex_encoded_size(n);
+}
+
+/**
+ * @brief Decodes the hex digits of @p in into @p out.
+ * @return Bytes written (in.size() / 2); @c message_size for an odd length, @c illegal_byte_sequence for a
+ * character that is not a hex digit (with @p out partially written), @c no_buffer_space.
+ */
+[[nodiscard]] inline std::expected<std::size_t, std::error_code> from_hex(std::string_view in,
+                                                                         std::span<std::byte> out) noexcept {
+    std::size_t n = in.size();
+    if (n % 2) return std::unexpected(std::make_error_code(std::errc::message_size));
+    if (out.size() < n / 2) return std::unexpected(std::make_error_code(std::errc::no_buffer_space));
+    auto *o = reinterpret_cast<unsigned char *>(out.data());
+    std::size_t done = detail::hex_kernels().decode(in.data(), n, o);
+    done += detail::hex_scalar::decode(in.data() + done, n - done, o + done / 2);
+    if (done != n) return std::unexpected(std::make_error_code(std::errc::illegal_byte_sequence));
+    return n / 2;
+}
+
+} // namespace saburou::platform::v2::bytes
+
+/**
+ * @brief std::formatter specialization for hex_case_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "hex_case_t::upper").
+ */
+template <> struct std::formatter<saburou::platform::v2::bytes::hex_case_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::bytes::hex_case_t &c, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::bytes::to_code_name(c);
+        return repr ? std::format_to(ctx.out(), "hex_case_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
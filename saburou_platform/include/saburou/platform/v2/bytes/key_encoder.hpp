@@ -0,0 +1,200 @@
+#pragma once
+
+/**
+ * @file key_encoder.hpp
+ * @brief Order-preserving binary keys: composite sort keys whose memcmp order is the logical order of
+ * their fields, for radix sorting and for byte-wise comparison in indexes.
+ *
+ * Each field is encoded so that comparing the bytes compares the values:
+ * - Unsigned integers: big-endian (to_big). Signed integers: big-endian with the sign bit flipped.
+ *   char and wchar_t, whose signedness depends on the target, are encoded as unsigned, like strings.
+ * - Floats: big-endian IEEE bits with the sign bit flipped for positives and all bits flipped for negatives,
+ *   giving the IEEE total order (-NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < +NaN).
+ * - Strings, escaped: 0x00 becomes 0x00 0xFF and the string ends with 0x00 0x01, so a string sorts right
+ *   before its extensions and any later field does not change the order. This is the general choice.
+ * - Strings, length-prefixed: a 32-bit big-endian length, then the bytes. Shorter strings sort first
+ *   (shortlex order); cheaper to produce and skip, and it agrees with lexicographic order when the lengths
+ *   are equal.
+ *
+ * A field appended with key_order_t::descending has all its bytes complemented, which reverses its order.
+ *
+ * @code
+ * bytes::key_encoder key;
+ * key.append(int32_t{-5}).append_string("tokyo").append(3.5, bytes::key_order_t::descending);
+ * std::span<const std::byte> k = key.view(); // compare with memcmp, sort with msd_radix_sort()
+ * key.clear();                               // reuse the buffer for the next row
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/endian/big.hpp>
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace saburou::platform::v2::bytes {
+
+/**
+ * @brief Direction of one key field.
+ */
+enum class key_order_t : uint8_t {
+    ascending, // Smaller values first
+    descending // Larger values first (bytes complemented)
+};
+
+/**
+ * @brief Converts a key_order_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(key_order_t o) {
+    switch (o) {
+    case key_order_t::ascending:  return "ascending";
+    case key_order_t::descending: return "descending";
+    default:                      return "unknown";
+    }
+}
+
+/** @brief Scalar types key_encoder::append() accepts: integers up to 64 bits, bool, and IEEE float/double. */
+template <class T>
+concept KeyScalar = (std::integral<T> && sizeof(T) <= 8) ||
+                    (std::floating_point<T> && std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8));
+
+/**
+ * @brief Builds one order-preserving key field by field into an owned buffer.
+ * * The buffer keeps its capacity across clear(), so one encoder can produce the keys of many rows.
+ */
+class key_encoder {
+public:
+    key_encoder() = default;
+
+    /** @brief Reserves @p capacity bytes up front. */
+    explicit key_encoder(std::size_t capacity) { buf_.reserve(capacity); }
+
+    /** @brief Appends an integer, bool or floating-point field. char and wchar_t encode as unsigned on every target. */
+    template <KeyScalar T> key_encoder &append(T value, key_order_t order = key_order_t::ascending) {
+        using U = std::conditional_t<sizeof(T) == 1, uint8_t,
+                  std::conditional_t<sizeof(T) == 2, uint16_t,
+                  std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+        constexpr U sign = U{1} << (std::numeric_limits<U>::digits - 1);
+        U bits;
+        if constexpr (std::floating_point<T>) {
+            bits = std::bit_cast<U>(value);
+            bits = (bits & sign) ? static_cast<U>(~bits) : static_cast<U>(bits ^ sign);
+        } else if constexpr (std::is_signed_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, wchar_t>) {
+            bits = static_cast<U>(static_cast<U>(value) ^ sign);
+        } else {
+            bits = static_cast<U>(value);
+        }
+        if (order == key_order_t::descending) bits = static_cast<U>(~bits);
+        U big = endian::to_big(bits);
+        std::memcpy(grow(sizeof(U)), &big, sizeof(U));
+        return *this;
+    }
+
+    /** @brief Appends an escaped string field (see the file comment). */
+    key_encoder &append_string(std::string_view s, key_order_t order = key_order_t::ascending) {
+        return append_escaped(reinterpret_cast<const unsigned char *>(s.data()), s.size(), order);
+    }
+
+    /** @brief Appends an escaped byte-string field. */
+    key_encoder &append_string(std::span<const std::byte> s, key_order_t order = key_order_t::ascending) {
+        return append_escaped(reinterpret_cast<const unsigned char *>(s.data()), s.size(), order);
+    }
+
+    /**
+     * @brief Appends a length-prefixed string field (shortlex order, see the file comment).
+     * @pre s.size() <= UINT32_MAX
+     */
+    key_encoder &append_prefixed(std::string_view s, key_order_t order = key_order_t::ascending) {
+        std::size_t start = buf_.size();
+        append(static_cast<uint32_t>(s.size()));
+        std::memcpy(grow(s.size()), s.data(), s.size());
+        if (order == key_order_t::descending) complement(start);
+        return *this;
+    }
+
+    /** @brief Appends bytes verbatim, e.g. a key prefix encoded earlier. */
+    key_encoder &append_raw(std::span<const std::byte> s) {
+        std::memcpy(grow(s.size()), s.data(), s.size());
+        return *this;
+    }
+
+    /** @brief The key built so far. Invalidated by the next append. */
+    [[nodiscard]] std::span<const std::byte> view() const noexcept { return buf_; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return buf_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return buf_.empty(); }
+
+    /** @brief Drops the key, keeping the capacity. */
+    void clear() noexcept { buf_.clear(); }
+
+    /** @brief Moves the key out, leaving the encoder empty. */
+    [[nodiscard]] std::vector<std::byte> release() noexcept { return std::exchange(buf_, {}); }
+
+private:
+    unsigned char *grow(std::size_t n) {
+        std::size_t at = buf_.size();
+        buf_.resize(at + n);
+        return reinterpret_cast<unsigned char *>(buf_.data()) + at;
+    }
+
+    void complement(std::size_t from) noexcept {
+        for (std::size_t i = from; i < buf_.size(); ++i) buf_[i] = ~buf_[i];
+    }
+
+    key_encoder &append_escaped(const unsigned char *p, std::size_t n, key_order_t order) {
+        std::size_t start = buf_.size();
+        // Runs without a zero byte are copied whole; each zero takes two bytes.
+        while (n) {
+            const auto *zero = static_cast<const unsigned char *>(std::memchr(p, 0, n));
+            std::size_t run = zero ? static_cast<std::size_t>(zero - p) : n;
+            unsigned char *out = grow(run + (zero ? 2 : 0));
+            std::memcpy(out, p, run);
+            if (zero) {
+                out[run] = 0x00;
+                out[run + 1] = 0xFF;
+                ++run;
+            }
+            p += run;
+            n -= run;
+        }
+        unsigned char *end = grow(2);
+        end[0] = 0x00;
+        end[1] = 0x01;
+        if (order == key_order_t::descending) complement(start);
+        return *this;
+    }
+
+    std::vector<std::byte> buf_;
+};
+
+} // namespace saburou::platform::v2::bytes
+
+/**
+ * @brief std::formatter specialization for key_order_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "key_order_t::descending").
+ */
+template <> struct std::formatter<saburou::platform::v2::bytes::key_order_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::bytes::key_order_t &o, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::bytes::to_code_name(o);
+        return repr ? std::format_to(ctx.out(), "key_order_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
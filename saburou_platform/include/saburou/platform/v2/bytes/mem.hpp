@@ -0,0 +1,178 @@
+#pragma once
+
+/**
+ * @file mem.hpp
+ * @brief memcpy/memset/memchr/memcmp replacements for libcs without vectorized string routines.
+ *
+ * On glibc, Apple, Windows and bionic the libc versions are already tuned per CPU, so these calls
+ * forward to them. On musl, newlib, uClibc and similar they dispatch once, at first use, to AVX2/SSE2
+ * (x86) or NEON (AArch64) kernels. Define SABUROU_PLATFORM_V2_BYTES_USE_LIBC to 0 or 1 to override.
+ *
+ * @code
+ * bytes::copy(dst, src, n);
+ * if (auto *nl = bytes::find_byte(buf, '\n', len)) ...
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/detail/mem_kernels.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+#include <saburou/platform/v2/detect.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+
+#if !defined(SABUROU_PLATFORM_V2_BYTES_USE_LIBC)
+#if SABUROU_PLATFORM_V2_LIBC_MUSL || SABUROU_PLATFORM_V2_LIBC_PROBABLY_MUSL || SABUROU_PLATFORM_V2_LIBC_NEWLIB ||  \
+    SABUROU_PLATFORM_V2_LIBC_UCLIBC || SABUROU_PLATFORM_V2_LIBC_DIETLIBC || SABUROU_PLATFORM_V2_LIBC_KLIBC
+#define SABUROU_PLATFORM_V2_BYTES_USE_LIBC 0
+#else
+#define SABUROU_PLATFORM_V2_BYTES_USE_LIBC 1
+#endif
+#endif
+
+namespace saburou::platform::v2::bytes {
+
+/**
+ * @brief Implementation behind copy(), fill(), find_byte() and compare().
+ */
+enum class mem_backend_t : uint8_t {
+    libc, // The C library's own routines
+    sse2, // SSE2 search/compare; copy and fill stay on libc
+    avx2, // AVX2 kernels, non-temporal stores for copies and fills beyond the last-level cache
+    neon  // AArch64 Advanced SIMD kernels
+};
+
+/**
+ * @brief Converts a mem_backend_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(mem_backend_t b) {
+    switch (b) {
+    case mem_backend_t::libc: return "libc";
+    case mem_backend_t::sse2: return "sse2";
+    case mem_backend_t::avx2: return "avx2";
+    case mem_backend_t::neon: return "neon";
+    default:                  return "unknown";
+    }
+}
+
+namespace detail {
+
+/** @brief Kernel table selected once per process. */
+struct mem_kernels_t {
+    mem_backend_t backend = mem_backend_t::libc;
+    void (*copy)(uchar *, const uchar *, std::size_t) noexcept;
+    void (*fill)(uchar *, uchar, std::size_t) noexcept;
+    const uchar *(*find_byte)(const uchar *, uchar, std::size_t) noexcept;
+    int (*compare)(const uchar *, const uchar *, std::size_t) noexcept;
+};
+
+inline void libc_copy(uchar *d, const uchar *s, std::size_t n) noexcept { std::memcpy(d, s, n); }
+inline void libc_fill(uchar *d, uchar v, std::size_t n) noexcept { std::memset(d, v, n); }
+inline const uchar *libc_find_byte(const uchar *p, uchar v, std::size_t n) noexcept {
+    return static_cast<const uchar *>(std::memchr(p, v, n));
+}
+inline int libc_compare(const uchar *a, const uchar *b, std::size_t n) noexcept { return std::memcmp(a, b, n); }
+
+/** @brief Best kernel table for @p f. */
+[[nodiscard]] inline mem_kernels_t select_mem_kernels(const cpu::features_t &f) noexcept {
+    mem_kernels_t k{mem_backend_t::libc, libc_copy, libc_fill, libc_find_byte, libc_compare};
+#if SABUROU_PLATFORM_V2_SIMD_X86
+    if (f.avx2) return {mem_backend_t::avx2, avx2::copy, avx2::fill, avx2::find_byte, avx2::compare};
+    if (f.sse2) {
+        k.backend = mem_backend_t::sse2;
+        k.find_byte = sse2::find_byte;
+        k.compare = sse2::compare;
+    }
+#elif SABUROU_PLATFORM_V2_SIMD_NEON
+    if (f.neon) return {mem_backend_t::neon, neon::copy, neon::fill, neon::find_byte, neon::compare};
+#endif
+    (void)f;
+    return k;
+}
+
+[[nodiscard]] inline const mem_kernels_t &mem_kernels() noexcept {
+    static const mem_kernels_t k = select_mem_kernels(cpu::features());
+    return k;
+}
+
+} // namespace detail
+
+/** @brief Implementation the functions below use in this process. */
+[[nodiscard]] inline mem_backend_t mem_backend() noexcept {
+#if SABUROU_PLATFORM_V2_BYTES_USE_LIBC
+    return mem_backend_t::libc;
+#else
+    return detail::mem_kernels().backend;
+#endif
+}
+
+/**
+ * @brief Copies @p n bytes (memcpy semantics: the ranges must not overlap).
+ * * Copies larger than 3/4 of the last-level cache use non-temporal stores on the AVX2 path.
+ */
+inline void copy(void *dst, const void *src, std::size_t n) noexcept {
+#if SABUROU_PLATFORM_V2_BYTES_USE_LIBC
+    std::memcpy(dst, src, n);
+#else
+    detail::mem_kernels().copy(static_cast<detail::uchar *>(dst), static_cast<const detail::uchar *>(src), n);
+#endif
+}
+
+/** @brief Sets @p n bytes to @p value (memset semantics). */
+inline void fill(void *dst, uint8_t value, std::size_t n) noexcept {
+#if SABUROU_PLATFORM_V2_BYTES_USE_LIBC
+    std::memset(dst, value, n);
+#else
+    detail::mem_kernels().fill(static_cast<detail::uchar *>(dst), value, n);
+#endif
+}
+
+/**
+ * @brief Finds the first byte equal to @p value (memchr semantics).
+ * @return Pointer to it, or nullptr if none of the @p n bytes matches.
+ */
+[[nodiscard]] inline const void *find_byte(const void *p, uint8_t value, std::size_t n) noexcept {
+#if SABUROU_PLATFORM_V2_BYTES_USE_LIBC
+    return std::memchr(p, value, n);
+#else
+    return detail::mem_kernels().find_byte(static_cast<const detail::uchar *>(p), value, n);
+#endif
+}
+
+/**
+ * @brief Lexicographic comparison of @p n unsigned bytes (memcmp semantics).
+ * @return Negative, zero or positive; only the sign is meaningful.
+ */
+[[nodiscard]] inline int compare(const void *a, const void *b, std::size_t n) noexcept {
+#if SABUROU_PLATFORM_V2_BYTES_USE_LIBC
+    return std::memcmp(a, b, n);
+#else
+    return detail::mem_kernels().compare(static_cast<const detail::uchar *>(a), static_cast<const detail::uchar *>(b),
+                                         n);
+#endif
+}
+
+} // namespace saburou::platform::v2::bytes
+
+/**
+ * @brief std::formatter specialization for mem_backend_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "mem_backend_t::avx2").
+ */
+template <> struct std::formatter<saburou::platform::v2::bytes::mem_backend_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::bytes::mem_backend_t &b, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::bytes::to_code_name(b);
+        return repr ? std::format_to(ctx.out(), "mem_backend_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
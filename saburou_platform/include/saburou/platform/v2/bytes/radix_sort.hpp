@@ -0,0 +1,302 @@
+#pragma once
+
+/**
+ * @file radix_sort.hpp
+ * @brief Multi-threaded radix sorts in memcmp order, for batches of keys built with key_encoder.
+ *
+ * - lsd_radix_sort(): fixed-size records (for instance an encoded key followed by a row id), sorted stably
+ *   by their leading key bytes, least significant byte first. Each pass counts bytes per thread, turns the
+ *   counts into per-thread output offsets and scatters in parallel. Passes whose byte is the same in every
+ *   record are skipped, so the constant high bytes of small integers cost one counting sweep.
+ * - msd_radix_sort(): variable-length keys, sorted as views (the key bytes do not move), most significant
+ *   byte first; a key sorts before its extensions. Shared leading bytes are skipped, the first differing byte
+ *   splits the batch into up to 256 buckets, and threads take buckets largest first; small buckets finish
+ *   with a comparison sort.
+ *
+ * Both take @c threads = 0 for one thread per online CPU and use fewer when the batch is small. They
+ * allocate a scratch copy of the input and let std::bad_alloc propagate; when a worker thread cannot be
+ * started they sort on the calling thread instead.
+ *
+ * @code
+ * // 16-byte records: 8-byte encoded key, then an 8-byte row id.
+ * bytes::lsd_radix_sort(std::as_writable_bytes(std::span{records}), 16, 8);
+ * bytes::msd_radix_sort(std::span{key_views});
+ * @endcode
+ */
+
+#include <saburou/platform/v2/cpu/topology.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace saburou::platform::v2::bytes {
+
+namespace detail {
+
+/** @brief Records or keys below which one more thread does not pay off. */
+inline constexpr std::size_t radix_parallel_grain = std::size_t{1} << 16;
+
+/** @brief Ranges below which msd_radix_sort() switches to a comparison sort. */
+inline constexpr std::size_t radix_small_range = 64;
+
+[[nodiscard]] inline unsigned radix_threads(std::size_t n, unsigned requested) {
+    std::size_t t = requested ? requested : cpu::online_count();
+    return static_cast<unsigned>(std::clamp<std::size_t>(n / radix_parallel_grain, 1, t));
+}
+
+/**
+ * @brief Runs fn(0 .. threads-1), fn(0) on the calling thread.
+ * * Workers are all started before any of them runs fn, so callers may synchronize them with a barrier.
+ * @return False, with fn not run at all, if a worker could not be started.
+ */
+template <class Fn> [[nodiscard]] bool radix_run(unsigned threads, Fn &&fn) {
+    enum : int { waiting, running, cancelled };
+    std::atomic<int> gate{waiting};
+    std::vector<std::jthread> workers;
+    auto release = [&gate](int state) {
+        gate.store(state, std::memory_order_release);
+        gate.notify_all();
+    };
+    try {
+        workers.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t) {
+            workers.emplace_back([&fn, &gate, t] {
+                gate.wait(waiting, std::memory_order_acquire);
+                if (gate.load(std::memory_order_acquire) == running) fn(t);
+            });
+        }
+    } catch (...) { // std::system_error or std::bad_alloc: the started workers exit and are joined
+        release(cancelled);
+        return false;
+    }
+    release(running);
+    fn(0);
+    return true;
+}
+
+using radix_counts_t = std::array<std::size_t, 256>;
+
+/** @brief Moves records [begin, end) of @p src to their slots in @p dst; Size 0 means @p rec bytes. */
+template <std::size_t Size>
+void radix_scatter(const unsigned char *src, unsigned char *dst, std::size_t begin, std::size_t end,
+                   std::size_t rec, std::size_t digit, radix_counts_t &offsets) noexcept {
+    const std::size_t size = Size ? Size : rec;
+    for (std::size_t i = begin; i < end; ++i) {
+        const unsigned char *r = src + i * size;
+        std::memcpy(dst + offsets[r[digit]]++ * size, r, size);
+    }
+}
+
+inline void radix_scatter_any(const unsigned char *src, unsigned char *dst, std::size_t begin, std::size_t end,
+                              std::size_t rec, std::size_t digit, radix_counts_t &offsets) noexcept {
+    switch (rec) {
+    case 4:  return radix_scatter<4>(src, dst, begin, end, rec, digit, offsets);
+    case 8:  return radix_scatter<8>(src, dst, begin, end, rec, digit, offsets);
+    case 12: return radix_scatter<12>(src, dst, begin, end, rec, digit, offsets);
+    case 16: return radix_scatter<16>(src, dst, begin, end, rec, digit, offsets);
+    case 24: return radix_scatter<24>(src, dst, begin, end, rec, digit, offsets);
+    case 32: return radix_scatter<32>(src, dst, begin, end, rec, digit, offsets);
+    default: return radix_scatter<0>(src, dst, begin, end, rec, digit, offsets);
+    }
+}
+
+/** @brief State of one lsd_radix_sort() shared by its threads. */
+struct radix_lsd_t {
+    unsigned char *src, *dst;
+    std::size_t count, rec, digit;
+    std::size_t passes_left;
+    unsigned threads;
+    bool skip = false;
+    std::vector<radix_counts_t> counts; ///< Per thread: byte histogram, then output offsets.
+
+    [[nodiscard]] std::size_t chunk_begin(unsigned t) const noexcept { return count * t / threads; }
+
+    void histogram(unsigned t) noexcept {
+        radix_counts_t &c = counts[t];
+        c.fill(0);
+        for (std::size_t i = chunk_begin(t), end = chunk_begin(t + 1); i < end; ++i) ++c[src[i * rec + digit]];
+    }
+
+    /** @brief Turns the histograms into offsets: thread t writes byte b after all smaller bytes and after
+     * the b-records of threads before it, which keeps the sort stable. */
+    void offsets() noexcept {
+        std::size_t pos = 0;
+        skip = false;
+        for (unsigned b = 0; b < 256; ++b) {
+            std::size_t total = 0;
+            for (unsigned t = 0; t < threads; ++t) {
+                std::size_t n = counts[t][b];
+                counts[t][b] = pos + total;
+                total += n;
+            }
+            skip |= total == count;
+            pos += total;
+        }
+    }
+
+    void scatter(unsigned t) noexcept {
+        if (!skip) radix_scatter_any(src, dst, chunk_begin(t), chunk_begin(t + 1), rec, digit, counts[t]);
+    }
+
+    /** @brief Moves to the next, more significant byte. */
+    void next() noexcept {
+        if (!skip) std::swap(src, dst);
+        --digit;
+        --passes_left;
+    }
+};
+
+/** @brief Compares two keys from byte @p depth on, memcmp-style with shorter keys first. */
+[[nodiscard]] inline bool radix_key_less(std::span<const std::byte> a, std::span<const std::byte> b,
+                                         std::size_t depth) noexcept {
+    std::size_t n = std::min(a.size(), b.size()) - depth;
+    int c = n ? std::memcmp(a.data() + depth, b.data() + depth, n) : 0;
+    return c < 0 || (c == 0 && a.size() < b.size());
+}
+
+/** @brief Byte of @p key at @p depth plus one, or 0 past its end (end-of-key sorts first). */
+[[nodiscard]] inline unsigned radix_key_byte(std::span<const std::byte> key, std::size_t depth) noexcept {
+    return depth < key.size() ? static_cast<unsigned>(key[depth]) + 1 : 0;
+}
+
+using radix_key_t = std::span<const std::byte>;
+using radix_buckets_t = std::array<std::size_t, 258>;
+
+/**
+ * @brief Advances @p depth past bytes every key of @p keys shares and distributes the keys by the first
+ * byte that differs; @p start receives the bucket boundaries.
+ * @return False if all keys are equal from @p depth on (nothing left to sort).
+ */
+inline bool radix_partition(std::span<radix_key_t> keys, radix_key_t *tmp, std::size_t &depth,
+                            radix_buckets_t &start) noexcept {
+    for (;; ++depth) {
+        start.fill(0);
+        for (const auto &k : keys) ++start[radix_key_byte(k, depth) + 1];
+        auto full = std::find(start.begin() + 1, start.end(), keys.size());
+        if (full == start.end()) break;
+        if (full == start.begin() + 1) return false; // Every key ends here.
+    }
+    for (std::size_t b = 1; b < start.size(); ++b) start[b] += start[b - 1];
+    radix_buckets_t next = start;
+    for (const auto &k : keys) tmp[next[radix_key_byte(k, depth)]++] = k;
+    std::copy(tmp, tmp + keys.size(), keys.begin());
+    return true;
+}
+
+/**
+ * @brief Sorts @p keys from byte @p depth on. Recurses into every bucket but the largest and loops on that
+ * one, so the recursion depth stays below log2(keys.size()) however long the shared prefixes are.
+ */
+inline void radix_msd(std::span<radix_key_t> keys, radix_key_t *tmp, std::size_t depth) noexcept {
+    while (keys.size() >= radix_small_range) {
+        radix_buckets_t start;
+        if (!radix_partition(keys, tmp, depth, start)) return;
+        // Bucket 0 holds the keys that end at depth: all equal.
+        unsigned largest = 1;
+        for (unsigned b = 2; b < 257; ++b) {
+            if (start[b + 1] - start[b] > start[largest + 1] - start[largest]) largest = b;
+        }
+        for (unsigned b = 1; b < 257; ++b) {
+            std::size_t n = start[b + 1] - start[b];
+            if (b != largest && n > 1) radix_msd(keys.subspan(start[b], n), tmp + start[b], depth + 1);
+        }
+        keys = keys.subspan(start[largest], start[largest + 1] - start[largest]);
+        tmp += start[largest];
+        ++depth;
+    }
+    std::sort(keys.begin(), keys.end(),
+              [depth](const radix_key_t &a, const radix_key_t &b) { return radix_key_less(a, b, depth); });
+}
+
+} // namespace detail
+
+/**
+ * @brief Sorts fixed-size records stably by their first @p key_size bytes, compared as by memcmp.
+ * @param records The records, back to back.
+ * @param record_size Bytes per record.
+ * @param key_size Leading bytes of each record that form its key.
+ * @param threads Worker threads, 0 for one per online CPU.
+ * @pre record_size > 0, key_size <= record_size and records.size() is a multiple of record_size.
+ */
+inline void lsd_radix_sort(std::span<std::byte> records, std::size_t record_size, std::size_t key_size,
+                           unsigned threads = 0) {
+    std::size_t count = records.size() / record_size;
+    if (count < 2 || key_size == 0) return;
+    auto scratch = std::make_unique_for_overwrite<unsigned char[]>(records.size());
+    auto *data = reinterpret_cast<unsigned char *>(records.data());
+
+    unsigned n_threads = detail::radix_threads(count, threads);
+    detail::radix_lsd_t s{data, scratch.get(), count, record_size, key_size - 1, key_size, n_threads,
+                          false, std::vector<detail::radix_counts_t>(n_threads)};
+    bool sorted = false;
+    if (s.threads > 1) {
+        // Two barrier phases per byte: histograms -> offsets, scatters -> next byte.
+        bool scattered = false;
+        std::barrier sync(s.threads, [&]() noexcept {
+            if (scattered) s.next();
+            else s.offsets();
+            scattered = !scattered;
+        });
+        sorted = detail::radix_run(s.threads, [&](unsigned t) {
+            while (s.passes_left) {
+                s.histogram(t);
+                sync.arrive_and_wait();
+                s.scatter(t);
+                sync.arrive_and_wait();
+            }
+        });
+    }
+    if (!sorted) {
+        s.threads = 1;
+        while (s.passes_left) {
+            s.histogram(0);
+            s.offsets();
+            s.scatter(0);
+            s.next();
+        }
+    }
+    if (s.src != data) std::memcpy(data, s.src, records.size());
+}
+
+/**
+ * @brief Sorts key views in memcmp order, a key before its extensions. Only the views move.
+ * @param keys The keys, e.g. views of key_encoder output.
+ * @param threads Worker threads, 0 for one per online CPU.
+ */
+inline void msd_radix_sort(std::span<std::span<const std::byte>> keys, unsigned threads = 0) {
+    if (keys.size() < 2) return;
+    auto tmp = std::make_unique_for_overwrite<detail::radix_key_t[]>(keys.size());
+    unsigned n_threads = detail::radix_threads(keys.size(), threads);
+    if (n_threads == 1) {
+        detail::radix_msd(keys, tmp.get(), 0);
+        return;
+    }
+
+    std::size_t depth = 0;
+    detail::radix_buckets_t start;
+    if (!detail::radix_partition(keys, tmp.get(), depth, start)) return;
+    std::array<unsigned, 256> order;
+    for (unsigned b = 0; b < 256; ++b) order[b] = b + 1;
+    std::sort(order.begin(), order.end(),
+              [&](unsigned a, unsigned b) { return start[a + 1] - start[a] > start[b + 1] - start[b]; });
+    std::atomic<unsigned> next{0};
+    auto drain = [&](unsigned) {
+        for (unsigned i; (i = next.fetch_add(1, std::memory_order_relaxed)) < 256;) {
+            unsigned b = order[i];
+            std::size_t n = start[b + 1] - start[b];
+            if (n > 1) detail::radix_msd(keys.subspan(start[b], n), tmp.get() + start[b], depth + 1);
+        }
+    };
+    if (!detail::radix_run(n_threads, drain)) drain(0);
+}
+
+} // namespace saburou::platform::v2::bytes
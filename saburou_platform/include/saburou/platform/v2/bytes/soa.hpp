@@ -0,0 +1,176 @@
+#pragma once
+
+/**
+ * @file soa.hpp
+ * @brief Record/column transposition: split an array of fixed-size records (AoS) into one column per field
+ * (SoA) and merge columns back, with per-field byte-order conversion.
+ *
+ * A layout lists the record size and, for each field, its type, byte offset and stored byte order. All of
+ * it is known at compile time, so each layout gets its own loops: records of up to 32 bytes whose fields are
+ * 1, 2, 4 or 8 bytes wide go through SIMD shuffles (AVX-512 VBMI, AVX2 for records up to 16 bytes, NEON up
+ * to 8), everything else through a scalar loop with fixed offsets. Records are raw bytes, so packed wire
+ * structs and unaligned file buffers work as they are; fields may leave gaps, which merge() leaves alone.
+ *
+ * @code
+ * struct [[gnu::packed]] tick { uint64_t ts; uint32_t id; float px; uint16_t qty; }; // 18 bytes, big-endian
+ * using tick_layout = bytes::soa_layout<sizeof(tick),
+ *                                       bytes::soa_field<uint64_t, offsetof(tick, ts), std::endian::big>,
+ *                                       bytes::soa_field<uint32_t, offsetof(tick, id), std::endian::big>,
+ *                                       bytes::soa_field<float, offsetof(tick, px), std::endian::big>,
+ *                                       bytes::soa_field<uint16_t, offsetof(tick, qty), std::endian::big>>;
+ * tick_layout::split(payload, ts, id, px, qty); // payload: span<const byte>, columns: span<T> each
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/detail/soa_kernels.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <type_traits>
+
+namespace saburou::platform::v2::bytes {
+
+/**
+ * @brief Loop family a layout's split()/merge() run on.
+ */
+enum class soa_backend_t : uint8_t {
+    scalar, // Fixed-offset copy per field and record
+    avx2,   // 32-byte blocks of records
+    avx512, // 64-byte blocks with VPERMB (AVX-512 VBMI)
+    neon    // 16-byte blocks with TBL
+};
+
+/**
+ * @brief Converts a soa_backend_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(soa_backend_t b) {
+    switch (b) {
+    case soa_backend_t::scalar: return "scalar";
+    case soa_backend_t::avx2:   return "avx2";
+    case soa_backend_t::avx512: return "avx512";
+    case soa_backend_t::neon:   return "neon";
+    default:                    return "unknown";
+    }
+}
+
+/**
+ * @brief One field of a record: a T stored at byte @p Offset in byte order @p Order.
+ * * With a non-native @p Order the bytes of each value are reversed on the way to or from its column
+ * (floats included), so columns always hold host-order values.
+ */
+template <class T, std::size_t Offset, std::endian Order = std::endian::native>
+    requires std::is_trivially_copyable_v<T>
+struct soa_field {
+    using value_type = T;
+    static constexpr std::size_t offset = Offset;
+    static constexpr std::size_t size = sizeof(T);
+    static constexpr std::endian order = Order;
+};
+
+namespace detail {
+
+template <class F> inline constexpr bool is_soa_field = false;
+template <class T, std::size_t O, std::endian E> inline constexpr bool is_soa_field<soa_field<T, O, E>> = true;
+
+/** @brief Loops selected once per process for one layout. */
+struct soa_kernels_t {
+    soa_backend_t backend = soa_backend_t::scalar;
+    void (*split)(const unsigned char *, std::size_t, unsigned char *const *) noexcept;
+    void (*merge)(const unsigned char *const *, std::size_t, unsigned char *) noexcept;
+};
+
+template <std::size_t S, class... F>
+[[nodiscard]] inline soa_kernels_t select_soa_kernels(const cpu::features_t &f) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_X86
+    if constexpr (soa_simd_fields<F...> && soa_block_records<64, S> != 0) {
+        if (f.has_avx512_core() && f.avx512vbmi && f.avx2) {
+            return {soa_backend_t::avx512, soa_avx512::split<S, F...>, soa_avx512::merge<S, F...>};
+        }
+    }
+    if constexpr (soa_simd_fields<F...> && soa_block_records<32, S> != 0) {
+        if (f.avx2) return {soa_backend_t::avx2, soa_avx2::split<S, F...>, soa_avx2::merge<S, F...>};
+    }
+#elif SABUROU_PLATFORM_V2_SIMD_NEON
+    if constexpr (soa_simd_fields<F...> && soa_block_records<16, S> != 0) {
+        if (f.neon) return {soa_backend_t::neon, soa_neon::split<S, F...>, soa_neon::merge<S, F...>};
+    }
+#endif
+    (void)f;
+    return {soa_backend_t::scalar, soa_scalar::split<S, F...>, soa_scalar::merge<S, F...>};
+}
+
+template <std::size_t S, class... F> [[nodiscard]] inline const soa_kernels_t &soa_kernels() noexcept {
+    static const soa_kernels_t k = select_soa_kernels<S, F...>(cpu::features());
+    return k;
+}
+
+} // namespace detail
+
+/**
+ * @brief Compile-time description of a record: its size and its fields (soa_field), in column order.
+ * @tparam RecordSize Bytes per record, including any padding or fields not listed.
+ * @tparam Fields soa_field types, each lying entirely within the record. Fields may be listed in any order;
+ * if two overlap, merge() writes the later one last.
+ */
+template <std::size_t RecordSize, class... Fields>
+    requires(RecordSize > 0 && sizeof...(Fields) > 0 && (detail::is_soa_field<Fields> && ...) &&
+             ((Fields::offset + Fields::size <= RecordSize) && ...))
+struct soa_layout {
+    static constexpr std::size_t record_size = RecordSize;
+    static constexpr std::size_t field_count = sizeof...(Fields);
+
+    /**
+     * @brief Copies each field of every record in @p records into its column.
+     * @pre records.size() is a multiple of record_size and every column holds at least
+     * records.size() / record_size values.
+     */
+    static void split(std::span<const std::byte> records, std::span<typename Fields::value_type>... columns) noexcept {
+        unsigned char *const cols[] = {reinterpret_cast<unsigned char *>(columns.data())...};
+        kernels().split(reinterpret_cast<const unsigned char *>(records.data()), records.size() / RecordSize, cols);
+    }
+
+    /**
+     * @brief Writes every record of @p records from the columns; bytes outside the fields keep their value.
+     * @pre records.size() is a multiple of record_size and every column holds at least
+     * records.size() / record_size values.
+     */
+    static void merge(std::span<std::byte> records, std::span<const typename Fields::value_type>... columns) noexcept {
+        const unsigned char *const cols[] = {reinterpret_cast<const unsigned char *>(columns.data())...};
+        kernels().merge(cols, records.size() / RecordSize, reinterpret_cast<unsigned char *>(records.data()));
+    }
+
+    /** @brief Loop family split() and merge() use for this layout in this process. */
+    [[nodiscard]] static soa_backend_t backend() noexcept { return kernels().backend; }
+
+private:
+    [[nodiscard]] static const detail::soa_kernels_t &kernels() noexcept {
+        return detail::soa_kernels<RecordSize, Fields...>();
+    }
+};
+
+} // namespace saburou::platform::v2::bytes
+
+/**
+ * @brief std::formatter specialization for soa_backend_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "soa_backend_t::avx2").
+ */
+template <> struct std::formatter<saburou::platform::v2::bytes::soa_backend_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::bytes::soa_backend_t &b, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::bytes::to_code_name(b);
+        return repr ? std::format_to(ctx.out(), "soa_backend_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
@@ -0,0 +1,213 @@
+#pragma once
+
+/**
+ * @file stream_vbyte.hpp
+ * @brief Stream VByte and Group Varint codecs for 32-bit integers, with pshufb/NEON TBL decoders.
+ *
+ * Both formats store each value little-endian in 1..4 bytes and describe four values per control byte
+ * (2-bit length codes, first value in the low bits). Stream VByte puts all control bytes first and the data
+ * after them; Group Varint writes each control byte just before its group's data. Decoding is one table
+ * lookup and one byte shuffle per four values on SSSE3 or AArch64, scalar elsewhere and on big-endian
+ * hosts; the encoded bytes are the same everywhere.
+ *
+ * The decoders need the value count, which the formats do not store. Errors follow varint.hpp:
+ * @c message_size for truncated input, @c no_buffer_space for a too small output.
+ *
+ * @code
+ * std::vector<std::byte> buf(bytes::stream_vbyte_max_size(ids.size()));
+ * auto n = bytes::stream_vbyte_encode(ids, buf);
+ * auto used = bytes::stream_vbyte_decode(std::span{buf}.first(*n), out);
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/detail/vbyte_kernels.hpp>
+#include <saburou/platform/v2/bytes/endian/little.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <system_error>
+
+namespace saburou::platform::v2::bytes {
+
+namespace detail {
+
+using vbyte_decode_fn = void (*)(vbyte_cursor_t &, const unsigned char *) noexcept;
+
+/** @brief Group decoders selected once per process. */
+struct vbyte_kernels_t {
+    vbyte_decode_fn stream_decode;
+    vbyte_decode_fn group_decode;
+};
+
+[[nodiscard]] inline vbyte_kernels_t select_vbyte_kernels(const cpu::features_t &f) noexcept {
+    if constexpr (endian::is_little) {
+#if SABUROU_PLATFORM_V2_SIMD_X86
+        if (f.ssse3) return {vbyte_ssse3::stream_decode, vbyte_ssse3::group_decode};
+#elif SABUROU_PLATFORM_V2_SIMD_NEON
+        if (f.neon) return {vbyte_neon::stream_decode, vbyte_neon::group_decode};
+#endif
+    }
+    (void)f;
+    return {vbyte_scalar::stream_decode, vbyte_scalar::group_decode};
+}
+
+[[nodiscard]] inline const vbyte_kernels_t &vbyte_kernels() noexcept {
+    static const vbyte_kernels_t k = select_vbyte_kernels(cpu::features());
+    return k;
+}
+
+/** @brief Data bytes of @p values, without control bytes. */
+[[nodiscard]] inline std::size_t vbyte_data_size(std::span<const uint32_t> values) noexcept {
+    std::size_t n = values.size();
+    for (uint32_t v : values) n += vbyte_code(v);
+    return n;
+}
+
+/** @brief Control byte of up to four values. */
+[[nodiscard]] inline unsigned vbyte_control(const uint32_t *v, std::size_t count) noexcept {
+    unsigned control = 0;
+    for (std::size_t i = 0; i < count; ++i) control |= vbyte_code(v[i]) << (2 * i);
+    return control;
+}
+
+/**
+ * @brief Writes the data bytes of up to four values; returns their length.
+ * * With @p wide, each value is stored as 4 bytes and overwritten by the next: @p out needs 16 bytes of room.
+ */
+inline std::size_t vbyte_encode_group(const uint32_t *v, std::size_t count, unsigned char *out, bool wide) noexcept {
+    std::size_t used = 0;
+    if (wide) {
+        for (std::size_t i = 0; i < count; ++i) {
+            vbyte_put(out + used, v[i], 3);
+            used += vbyte_code(v[i]) + 1;
+        }
+        return used;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        unsigned code = vbyte_code(v[i]);
+        vbyte_put(out + used, v[i], code);
+        used += code + 1;
+    }
+    return used;
+}
+
+/** @brief Data bytes the control byte describes for its first @p count values. */
+[[nodiscard]] inline std::size_t vbyte_group_size(unsigned control, std::size_t count) noexcept {
+    if (count == 4) return vbyte_lengths[control];
+    std::size_t n = count;
+    for (std::size_t i = 0; i < count; ++i) n += (control >> (2 * i)) & 3;
+    return n;
+}
+
+[[nodiscard]] inline std::unexpected<std::error_code> vbyte_error(std::errc e) noexcept {
+    return std::unexpected(std::make_error_code(e));
+}
+
+} // namespace detail
+
+/** @brief Worst-case Stream VByte size of @p count values. */
+[[nodiscard]] constexpr std::size_t stream_vbyte_max_size(std::size_t count) noexcept {
+    return (count + 3) / 4 + 4 * count;
+}
+
+/** @brief Exact Stream VByte size of @p values. */
+[[nodiscard]] inline std::size_t stream_vbyte_size(std::span<const uint32_t> values) noexcept {
+    return (values.size() + 3) / 4 + detail::vbyte_data_size(values);
+}
+
+/**
+ * @brief Encodes @p values as Stream VByte: (size + 3) / 4 control bytes, then the data.
+ * @return Bytes written, or @c no_buffer_space if @p out is shorter than stream_vbyte_size(values).
+ */
+[[nodiscard]] inline std::expected<std::size_t, std::error_code>
+stream_vbyte_encode(std::span<const uint32_t> values, std::span<std::byte> out) noexcept {
+    std::size_t total = stream_vbyte_size(values);
+    if (out.size() < total) return detail::vbyte_error(std::errc::no_buffer_space);
+    auto *control = reinterpret_cast<unsigned char *>(out.data());
+    unsigned char *data = control + (values.size() + 3) / 4, *end = control + total;
+    for (std::size_t i = 0; i < values.size(); i += 4) {
+        std::size_t count = std::min<std::size_t>(4, values.size() - i);
+        *control++ = static_cast<unsigned char>(detail::vbyte_control(values.data() + i, count));
+        data += detail::vbyte_encode_group(values.data() + i, count, data, end - data >= 16);
+    }
+    return total;
+}
+
+/**
+ * @brief Decodes @p values.size() values from Stream VByte @p in.
+ * @return Bytes consumed, or @c message_size if @p in is shorter than the controls say.
+ */
+[[nodiscard]] inline std::expected<std::size_t, std::error_code>
+stream_vbyte_decode(std::span<const std::byte> in, std::span<uint32_t> values) noexcept {
+    std::size_t count = values.size(), groups = count / 4, tail = count % 4;
+    std::size_t control_size = (count + 3) / 4;
+    if (in.size() < control_size) return detail::vbyte_error(std::errc::message_size);
+    const auto *control = reinterpret_cast<const unsigned char *>(in.data());
+    std::size_t data_size = tail ? detail::vbyte_group_size(control[groups], tail) : 0;
+    for (std::size_t g = 0; g < groups; ++g) data_size += detail::vbyte_lengths[control[g]];
+    if (in.size() - control_size < data_size) return detail::vbyte_error(std::errc::message_size);
+
+    const unsigned char *data_end = control + control_size + data_size;
+    detail::vbyte_cursor_t c{control, control + control_size, values.data(), groups};
+    detail::vbyte_kernels().stream_decode(c, data_end);
+    detail::vbyte_scalar::stream_decode(c, data_end);
+    if (tail) detail::vbyte_decode_group(*c.control, c.data, c.out, tail);
+    return control_size + data_size;
+}
+
+/** @brief Worst-case Group Varint size of @p count values. */
+[[nodiscard]] constexpr std::size_t group_varint_max_size(std::size_t count) noexcept {
+    return stream_vbyte_max_size(count);
+}
+
+/** @brief Exact Group Varint size of @p values (the same as Stream VByte). */
+[[nodiscard]] inline std::size_t group_varint_size(std::span<const uint32_t> values) noexcept {
+    return stream_vbyte_size(values);
+}
+
+/**
+ * @brief Encodes @p values as Group Varint: each control byte followed by its up to four values.
+ * @return Bytes written, or @c no_buffer_space if @p out is shorter than group_varint_size(values).
+ */
+[[nodiscard]] inline std::expected<std::size_t, std::error_code>
+group_varint_encode(std::span<const uint32_t> values, std::span<std::byte> out) noexcept {
+    std::size_t total = group_varint_size(values);
+    if (out.size() < total) return detail::vbyte_error(std::errc::no_buffer_space);
+    auto *p = reinterpret_cast<unsigned char *>(out.data());
+    unsigned char *end = p + total;
+    for (std::size_t i = 0; i < values.size(); i += 4) {
+        std::size_t count = std::min<std::size_t>(4, values.size() - i);
+        *p = static_cast<unsigned char>(detail::vbyte_control(values.data() + i, count));
+        p += 1 + detail::vbyte_encode_group(values.data() + i, count, p + 1, end - p >= 17);
+    }
+    return total;
+}
+
+/**
+ * @brief Decodes @p values.size() values from Group Varint @p in.
+ * @return Bytes consumed, or @c message_size if @p in ends inside a group.
+ */
+[[nodiscard]] inline std::expected<std::size_t, std::error_code>
+group_varint_decode(std::span<const std::byte> in, std::span<uint32_t> values) noexcept {
+    const auto *begin = reinterpret_cast<const unsigned char *>(in.data());
+    const unsigned char *end = begin + in.size();
+    detail::vbyte_cursor_t c{nullptr, begin, values.data(), values.size() / 4};
+    detail::vbyte_kernels().group_decode(c, end);
+    // The SIMD loop stops 17 bytes before the end; the rest is bounds-checked group by group.
+    std::size_t left = values.size() - (c.out - values.data());
+    while (left) {
+        std::size_t count = std::min<std::size_t>(4, left);
+        if (c.data == end || static_cast<std::size_t>(end - c.data) < 1 + detail::vbyte_group_size(*c.data, count))
+            return detail::vbyte_error(std::errc::message_size);
+        c.data += 1 + detail::vbyte_decode_group(*c.data, c.data + 1, c.out, count);
+        c.out += count;
+        left -= count;
+    }
+    return static_cast<std::size_t>(c.data - begin);
+}
+
+} // namespace saburou::platform::v2::bytes
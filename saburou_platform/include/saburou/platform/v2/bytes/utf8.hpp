@@ -0,0 +1,85 @@
+#pragma once
+
+/**
+ * @file utf8.hpp
+ * @brief UTF-8 validation, ASCII check and code point counting with AVX-512, AVX2 and NEON kernels.
+ *
+ * validate_utf8() follows the Unicode definition (Table 3-7): no overlong forms, no surrogates
+ * (U+D800..U+DFFF), nothing above U+10FFFF, no truncated sequences. ASCII runs cost about as much as a
+ * plain scan, so validating mostly-ASCII payloads before parsing them is cheap.
+ *
+ * @code
+ * if (!bytes::validate_utf8(body)) return reject(400);
+ * std::size_t chars = bytes::is_ascii(body) ? body.size() : bytes::count_utf8_codepoints(body);
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/detail/utf8_kernels.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace saburou::platform::v2::bytes {
+
+namespace detail {
+
+/** @brief UTF-8 loops selected once per process. */
+struct utf8_kernels_t {
+    bool (*validate)(const unsigned char *, std::size_t) noexcept;
+    bool (*is_ascii)(const unsigned char *, std::size_t) noexcept;
+    std::size_t (*count_codepoints)(const unsigned char *, std::size_t) noexcept;
+};
+
+[[nodiscard]] inline utf8_kernels_t select_utf8_kernels(const cpu::features_t &f) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_X86
+    if (f.avx512bw) return {utf8_avx512::validate, utf8_avx512::is_ascii, utf8_avx512::count_codepoints};
+    if (f.avx2) return {utf8_avx2::validate, utf8_avx2::is_ascii, utf8_avx2::count_codepoints};
+#elif SABUROU_PLATFORM_V2_SIMD_NEON
+    if (f.neon) return {utf8_neon::validate, utf8_neon::is_ascii, utf8_neon::count_codepoints};
+#endif
+    (void)f;
+    return {utf8_scalar::validate, utf8_scalar::is_ascii, utf8_scalar::count_codepoints};
+}
+
+[[nodiscard]] inline const utf8_kernels_t &utf8_kernels() noexcept {
+    static const utf8_kernels_t k = select_utf8_kernels(cpu::features());
+    return k;
+}
+
+[[nodiscard]] inline const unsigned char *utf8_bytes(std::span<const std::byte> s) noexcept {
+    return reinterpret_cast<const unsigned char *>(s.data());
+}
+
+} // namespace detail
+
+/** @brief True if @p s is well-formed UTF-8. */
+[[nodiscard]] inline bool validate_utf8(std::span<const std::byte> s) noexcept {
+    return detail::utf8_kernels().validate(detail::utf8_bytes(s), s.size());
+}
+
+[[nodiscard]] inline bool validate_utf8(std::string_view s) noexcept {
+    return validate_utf8(std::as_bytes(std::span{s}));
+}
+
+/** @brief True if every byte of @p s is below 0x80. */
+[[nodiscard]] inline bool is_ascii(std::span<const std::byte> s) noexcept {
+    return detail::utf8_kernels().is_ascii(detail::utf8_bytes(s), s.size());
+}
+
+[[nodiscard]] inline bool is_ascii(std::string_view s) noexcept { return is_ascii(std::as_bytes(std::span{s})); }
+
+/**
+ * @brief Number of code points in @p s.
+ * @pre @p s is valid UTF-8 (otherwise the result counts the bytes that are not continuation bytes).
+ */
+[[nodiscard]] inline std::size_t count_utf8_codepoints(std::span<const std::byte> s) noexcept {
+    return detail::utf8_kernels().count_codepoints(detail::utf8_bytes(s), s.size());
+}
+
+[[nodiscard]] inline std::size_t count_utf8_codepoints(std::string_view s) noexcept {
+    return count_utf8_codepoints(std::as_bytes(std::span{s}));
+}
+
+} // namespace saburou::platform::v2::bytes
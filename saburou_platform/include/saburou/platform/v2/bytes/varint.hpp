@@ -0,0 +1,204 @@
+#pragma once
+
+/**
+ * @file varint.hpp
+ * @brief LEB128 variable-length integers (the protobuf/DWARF unsigned varint), with ZigZag for signed values.
+ *
+ * Seven value bits per byte, least significant group first, high bit set on every byte but the last. Signed
+ * types are ZigZag-mapped first (0, -1, 1, -2 ... -> 0, 1, 2, 3 ...), as protobuf sint32/sint64 do, so small
+ * magnitudes stay short. The byte format does not depend on the host byte order.
+ *
+ * Decoders report @c std::errc::message_size when the input ends inside a value and
+ * @c std::errc::illegal_byte_sequence when a value does not fit the requested type. Encoders report
+ * @c std::errc::no_buffer_space when the output is too small.
+ *
+ * @code
+ * std::byte buf[bytes::leb128_max_size<uint64_t>];
+ * auto n = bytes::leb128_encode(uint64_t{300}, buf);            // 2 bytes: AC 02
+ * uint64_t v;
+ * auto used = bytes::leb128_decode(std::span{buf}.first(*n), v);
+ * auto read = bytes::leb128_decode_bulk<uint32_t>(postings, ids); // whole posting list
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/endian/little.hpp>
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+namespace saburou::platform::v2::bytes {
+
+/** @brief Integer types the LEB128 codec accepts (bool excluded). */
+template <class T>
+concept Leb128Integer = std::integral<T> && !std::same_as<std::remove_cv_t<T>, bool>;
+
+/** @brief Longest encoding of a T: 10 bytes for 64-bit types, 5 for 32-bit ones. */
+template <Leb128Integer T>
+inline constexpr std::size_t leb128_max_size = (std::numeric_limits<std::make_unsigned_t<T>>::digits + 6) / 7;
+
+/** @brief ZigZag mapping of a signed value: 0, -1, 1, -2 ... become 0, 1, 2, 3 ... */
+template <std::signed_integral T> [[nodiscard]] constexpr std::make_unsigned_t<T> zigzag_encode(T value) noexcept {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<U>(static_cast<U>(value) << 1) ^ static_cast<U>(value >> (std::numeric_limits<U>::digits - 1));
+}
+
+/** @brief Inverse of zigzag_encode(). */
+template <std::unsigned_integral U> [[nodiscard]] constexpr std::make_signed_t<U> zigzag_decode(U value) noexcept {
+    return static_cast<std::make_signed_t<U>>(static_cast<U>(value >> 1) ^ static_cast<U>(0 - (value & 1)));
+}
+
+namespace detail {
+
+template <Leb128Integer T> using leb128_unsigned_t = std::make_unsigned_t<std::remove_cv_t<T>>;
+
+template <Leb128Integer T> [[nodiscard]] constexpr leb128_unsigned_t<T> leb128_to_unsigned(T value) noexcept {
+    if constexpr (std::is_signed_v<T>) return zigzag_encode(value);
+    else return value;
+}
+
+template <Leb128Integer T> [[nodiscard]] constexpr T leb128_from_unsigned(leb128_unsigned_t<T> value) noexcept {
+    if constexpr (std::is_signed_v<T>) return zigzag_decode(value);
+    else return value;
+}
+
+/** @brief Writes @p v, which must have leb128_size(v) bytes of room at @p out. */
+template <std::unsigned_integral U> inline std::size_t leb128_put(U v, unsigned char *out) noexcept {
+    std::size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = static_cast<unsigned char>(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = static_cast<unsigned char>(v);
+    return n;
+}
+
+/** @brief Byte-at-a-time decoder; returns the length, 0 if truncated, or max + 1 if the value overflows U. */
+template <std::unsigned_integral U>
+[[nodiscard]] inline std::size_t leb128_get_slow(const unsigned char *p, std::size_t n, U &out) noexcept {
+    constexpr std::size_t max = leb128_max_size<U>;
+    constexpr unsigned last_bits = std::numeric_limits<U>::digits - 7 * (max - 1);
+    uint64_t v = 0;
+    for (std::size_t i = 0; i < n && i < max; ++i) {
+        unsigned char b = p[i];
+        v |= uint64_t{b & 0x7Fu} << (7 * i);
+        if (b & 0x80) continue;
+        if (i == max - 1 && (b >> last_bits) != 0) return max + 1;
+        out = static_cast<U>(v);
+        return i + 1;
+    }
+    return n < max ? 0 : max + 1;
+}
+
+/**
+ * @brief Word-at-a-time decoder for inputs with 8 readable bytes: the terminator is found with one
+ * countr_zero and the 7-bit groups are compacted with three mask-and-shift steps, without a per-byte loop.
+ */
+template <std::unsigned_integral U>
+[[nodiscard]] inline std::size_t leb128_get_fast(const unsigned char *p, std::size_t n, U &out) noexcept {
+    uint64_t w;
+    std::memcpy(&w, p, 8);
+    w = endian::from_little(w);
+    uint64_t stop = ~w & 0x8080808080808080ull;
+    std::size_t len = static_cast<std::size_t>(std::countr_zero(stop)) / 8 + 1;
+    if (!stop || len > leb128_max_size<U>) return leb128_get_slow(p, n, out);
+    uint64_t x = w & (stop ^ (stop - 1)) & 0x7F7F7F7F7F7F7F7Full;
+    x = (x & 0x007F007F007F007Full) | ((x & 0x7F007F007F007F00ull) >> 1);
+    x = (x & 0x00003FFF00003FFFull) | ((x & 0x3FFF00003FFF0000ull) >> 2);
+    x = (x & 0x000000000FFFFFFFull) | ((x & 0x0FFFFFFF00000000ull) >> 4);
+    if constexpr (std::numeric_limits<U>::digits < 56) {
+        if (x > std::numeric_limits<U>::max()) return leb128_max_size<U> + 1;
+    }
+    out = static_cast<U>(x);
+    return len;
+}
+
+template <std::unsigned_integral U>
+[[nodiscard]] inline std::size_t leb128_get(const unsigned char *p, std::size_t n, U &out) noexcept {
+    return n >= 8 ? leb128_get_fast(p, n, out) : leb128_get_slow(p, n, out);
+}
+
+[[nodiscard]] inline std::error_code leb128_error(std::size_t got) noexcept {
+    return std::make_error_code(got == 0 ? std::errc::message_size : std::errc::illegal_byte_sequence);
+}
+
+} // namespace detail
+
+/** @brief Bytes the encoding of @p value takes. */
+template <Leb128Integer T> [[nodiscard]] constexpr std::size_t leb128_size(T value) noexcept {
+    auto v = detail::leb128_to_unsigned(value);
+    return v ? (static_cast<std::size_t>(std::bit_width(v)) + 6) / 7 : 1;
+}
+
+/**
+ * @brief Encodes one value (ZigZag first if signed).
+ * @return Bytes written, or @c no_buffer_space if @p out holds fewer than leb128_size(value) bytes.
+ */
+template <Leb128Integer T>
+[[nodiscard]] inline std::expected<std::size_t, std::error_code> leb128_encode(T value,
+                                                                              std::span<std::byte> out) noexcept {
+    if (out.size() < leb128_size(value)) return std::unexpected(std::make_error_code(std::errc::no_buffer_space));
+    return detail::leb128_put(detail::leb128_to_unsigned(value), reinterpret_cast<unsigned char *>(out.data()));
+}
+
+/**
+ * @brief Decodes one value from the front of @p in.
+ * @return Bytes consumed; @c message_size if @p in ends inside the value, @c illegal_byte_sequence if the
+ * value does not fit T. Non-minimal encodings (e.g. 0x80 0x00) are accepted, as protobuf does.
+ */
+template <Leb128Integer T>
+[[nodiscard]] inline std::expected<std::size_t, std::error_code> leb128_decode(std::span<const std::byte> in,
+                                                                              T &value) noexcept {
+    detail::leb128_unsigned_t<T> v{};
+    std::size_t got = detail::leb128_get(reinterpret_cast<const unsigned char *>(in.data()), in.size(), v);
+    if (got == 0 || got > leb128_max_size<T>) return std::unexpected(detail::leb128_error(got));
+    value = detail::leb128_from_unsigned<T>(v);
+    return got;
+}
+
+/**
+ * @brief Encodes every value of @p values back to back.
+ * @return Bytes written, or @c no_buffer_space (with @p out partially written) if it runs out of room.
+ */
+template <Leb128Integer T>
+[[nodiscard]] inline std::expected<std::size_t, std::error_code> leb128_encode_bulk(std::span<const T> values,
+                                                                                   std::span<std::byte> out) noexcept {
+    auto *o = reinterpret_cast<unsigned char *>(out.data());
+    std::size_t pos = 0;
+    for (T value : values) {
+        auto v = detail::leb128_to_unsigned(value);
+        // Without a bounds check per byte while a worst-case encoding still fits.
+        if (out.size() - pos < leb128_max_size<T> && out.size() - pos < leb128_size(value))
+            return std::unexpected(std::make_error_code(std::errc::no_buffer_space));
+        pos += detail::leb128_put(v, o + pos);
+    }
+    return pos;
+}
+
+/**
+ * @brief Decodes exactly @p values.size() values from the front of @p in.
+ * @return Bytes consumed, or the error of the first value that fails (see leb128_decode()).
+ */
+template <Leb128Integer T>
+[[nodiscard]] inline std::expected<std::size_t, std::error_code> leb128_decode_bulk(std::span<const std::byte> in,
+                                                                                   std::span<T> values) noexcept {
+    const auto *p = reinterpret_cast<const unsigned char *>(in.data());
+    std::size_t pos = 0, n = in.size();
+    for (T &value : values) {
+        detail::leb128_unsigned_t<T> v{};
+        std::size_t got = detail::leb128_get(p + pos, n - pos, v);
+        if (got == 0 || got > leb128_max_size<T>) return std::unexpected(detail::leb128_error(got));
+        value = detail::leb128_from_unsigned<T>(v);
+        pos += got;
+    }
+    return pos;
+}
+
+} // namespace saburou::platform::v2::bytes
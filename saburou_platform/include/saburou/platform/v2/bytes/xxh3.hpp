@@ -0,0 +1,406 @@
+#pragma once
+
+/**
+ * @file xxh3.hpp
+ * @brief XXH3 64- and 128-bit non-cryptographic hashes, one-shot and streaming, with dispatched SIMD loops.
+ *
+ * Results are bit-identical to the reference xxHash 0.8 (XXH3_64bits_withSeed, XXH3_128bits_withSeed) and
+ * to each other across hosts: input words are read with endian::from_little, so a big-endian replica
+ * computes the same integers. To store or send a hash, write it with endian::to_little.
+ *
+ * @code
+ * uint64_t shard = bytes::xxh3_64(key.data(), key.size()) % shards;
+ *
+ * bytes::xxh3_state h(seed);
+ * for (auto chunk : chunks) h.update(chunk);
+ * bytes::hash128_t digest = h.digest128();
+ * @endcode
+ */
+
+#include <saburou/platform/v2/bytes/detail/xxh3_kernels.hpp>
+#include <saburou/platform/v2/bytes/endian/little.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <span>
+
+namespace saburou::platform::v2::bytes {
+
+/**
+ * @brief 128-bit hash value, as two 64-bit halves.
+ */
+struct hash128_t {
+    uint64_t low = 0;  ///< Low 64 bits
+    uint64_t high = 0; ///< High 64 bits
+
+    [[nodiscard]] constexpr bool operator==(const hash128_t &) const noexcept = default;
+};
+
+namespace detail {
+
+using xxh3_accumulate_fn = void (*)(uint64_t *, const unsigned char *, const unsigned char *, std::size_t) noexcept;
+using xxh3_scramble_fn = void (*)(uint64_t *, const unsigned char *) noexcept;
+
+/** @brief Stripe loops selected once per process. */
+struct xxh3_kernels_t {
+    xxh3_accumulate_fn accumulate;
+    xxh3_scramble_fn scramble;
+};
+
+[[nodiscard]] inline xxh3_kernels_t select_xxh3_kernels(const cpu::features_t &f) noexcept {
+    if constexpr (endian::is_little) {
+#if SABUROU_PLATFORM_V2_SIMD_X86
+        if (f.avx512f) return {xxh3_avx512::accumulate, xxh3_avx512::scramble};
+        if (f.avx2) return {xxh3_avx2::accumulate, xxh3_avx2::scramble};
+        if (f.sse2) return {xxh3_sse2::accumulate, xxh3_sse2::scramble};
+#elif SABUROU_PLATFORM_V2_SIMD_NEON
+        if (f.neon) return {xxh3_neon::accumulate, xxh3_neon::scramble};
+#endif
+    }
+    (void)f;
+    return {xxh3_scalar::accumulate, xxh3_scalar::scramble};
+}
+
+[[nodiscard]] inline const xxh3_kernels_t &xxh3_kernels() noexcept {
+    static const xxh3_kernels_t k = select_xxh3_kernels(cpu::features());
+    return k;
+}
+
+// -- Inputs of 0..240 bytes: no accumulators, the secret is read at fixed offsets. --
+
+[[nodiscard]] inline uint64_t xxh3_64_short(const unsigned char *p, std::size_t len, uint64_t seed) noexcept {
+    const unsigned char *s = xxh3_default_secret;
+    if (len > 128) {
+        uint64_t acc = len * xxh_prime64_1;
+        for (std::size_t i = 0; i < 8; ++i) acc += xxh3_mix16(p + 16 * i, s + 16 * i, seed);
+        acc = xxh3_avalanche(acc);
+        for (std::size_t i = 8; i < len / 16; ++i) acc += xxh3_mix16(p + 16 * i, s + 16 * (i - 8) + 3, seed);
+        return xxh3_avalanche(acc + xxh3_mix16(p + len - 16, s + 136 - 17, seed));
+    }
+    if (len > 16) {
+        uint64_t acc = len * xxh_prime64_1;
+        if (len > 32) {
+            if (len > 64) {
+                if (len > 96) {
+                    acc += xxh3_mix16(p + 48, s + 96, seed);
+                    acc += xxh3_mix16(p + len - 64, s + 112, seed);
+                }
+                acc += xxh3_mix16(p + 32, s + 64, seed);
+                acc += xxh3_mix16(p + len - 48, s + 80, seed);
+            }
+            acc += xxh3_mix16(p + 16, s + 32, seed);
+            acc += xxh3_mix16(p + len - 32, s + 48, seed);
+        }
+        acc += xxh3_mix16(p, s, seed);
+        acc += xxh3_mix16(p + len - 16, s + 16, seed);
+        return xxh3_avalanche(acc);
+    }
+    if (len > 8) {
+        uint64_t lo = xxh_read64(p) ^ ((xxh_read64(s + 24) ^ xxh_read64(s + 32)) + seed);
+        uint64_t hi = xxh_read64(p + len - 8) ^ ((xxh_read64(s + 40) ^ xxh_read64(s + 48)) - seed);
+        return xxh3_avalanche(len + byte_swap(lo) + hi + xxh_mul128_fold64(lo, hi));
+    }
+    if (len >= 4) {
+        seed ^= uint64_t{byte_swap(static_cast<uint32_t>(seed))} << 32;
+        uint64_t input = xxh_read32(p + len - 4) + (uint64_t{xxh_read32(p)} << 32);
+        return xxh3_rrmxmx(input ^ ((xxh_read64(s + 8) ^ xxh_read64(s + 16)) - seed), len);
+    }
+    if (len > 0) {
+        uint32_t combined = (uint32_t{p[0]} << 16) | (uint32_t{p[len >> 1]} << 24) | p[len - 1] |
+                            static_cast<uint32_t>(len << 8);
+        return xxh64_avalanche(combined ^ ((xxh_read32(s) ^ xxh_read32(s + 4)) + seed));
+    }
+    return xxh64_avalanche(seed ^ xxh_read64(s + 56) ^ xxh_read64(s + 64));
+}
+
+/** @brief Two 16-byte mixes feeding both halves of the 128-bit accumulator. */
+inline void xxh3_mix32(hash128_t &acc, const unsigned char *a, const unsigned char *b, const unsigned char *s,
+                       uint64_t seed) noexcept {
+    acc.low += xxh3_mix16(a, s, seed);
+    acc.low ^= xxh_read64(b) + xxh_read64(b + 8);
+    acc.high += xxh3_mix16(b, s + 16, seed);
+    acc.high ^= xxh_read64(a) + xxh_read64(a + 8);
+}
+
+[[nodiscard]] inline hash128_t xxh3_128_finish(const hash128_t &acc, std::size_t len, uint64_t seed) noexcept {
+    uint64_t high = acc.low * xxh_prime64_1 + acc.high * xxh_prime64_4 + (len - seed) * xxh_prime64_2;
+    return {xxh3_avalanche(acc.low + acc.high), 0 - xxh3_avalanche(high)};
+}
+
+[[nodiscard]] inline hash128_t xxh3_128_short(const unsigned char *p, std::size_t len, uint64_t seed) noexcept {
+    const unsigned char *s = xxh3_default_secret;
+    if (len > 128) {
+        hash128_t acc{len * xxh_prime64_1, 0};
+        for (std::size_t i = 0; i < 4; ++i) xxh3_mix32(acc, p + 32 * i, p + 32 * i + 16, s + 32 * i, seed);
+        acc = {xxh3_avalanche(acc.low), xxh3_avalanche(acc.high)};
+        for (std::size_t i = 4; i < len / 32; ++i)
+            xxh3_mix32(acc, p + 32 * i, p + 32 * i + 16, s + 3 + 32 * (i - 4), seed);
+        xxh3_mix32(acc, p + len - 16, p + len - 32, s + 136 - 17 - 16, 0 - seed);
+        return xxh3_128_finish(acc, len, seed);
+    }
+    if (len > 16) {
+        hash128_t acc{len * xxh_prime64_1, 0};
+        if (len > 32) {
+            if (len > 64) {
+                if (len > 96) xxh3_mix32(acc, p + 48, p + len - 64, s + 96, seed);
+                xxh3_mix32(acc, p + 32, p + len - 48, s + 64, seed);
+            }
+            xxh3_mix32(acc, p + 16, p + len - 32, s + 32, seed);
+        }
+        xxh3_mix32(acc, p, p + len - 16, s, seed);
+        return xxh3_128_finish(acc, len, seed);
+    }
+    if (len > 8) {
+        uint64_t lo = xxh_read64(p), hi = xxh_read64(p + len - 8);
+        xxh_u128_t m = xxh_mul128(lo ^ hi ^ ((xxh_read64(s + 32) ^ xxh_read64(s + 40)) - seed), xxh_prime64_1);
+        m.low += uint64_t{len - 1} << 54;
+        hi ^= (xxh_read64(s + 48) ^ xxh_read64(s + 56)) + seed;
+        m.high += hi + (hi & 0xFFFFFFFF) * (xxh_prime32_2 - 1);
+        m.low ^= byte_swap(m.high);
+        xxh_u128_t h = xxh_mul128(m.low, xxh_prime64_2);
+        h.high += m.high * xxh_prime64_2;
+        return {xxh3_avalanche(h.low), xxh3_avalanche(h.high)};
+    }
+    if (len >= 4) {
+        seed ^= uint64_t{byte_swap(static_cast<uint32_t>(seed))} << 32;
+        uint64_t input = xxh_read32(p) + (uint64_t{xxh_read32(p + len - 4)} << 32);
+        uint64_t keyed = input ^ ((xxh_read64(s + 16) ^ xxh_read64(s + 24)) + seed);
+        xxh_u128_t m = xxh_mul128(keyed, xxh_prime64_1 + (len << 2));
+        m.high += m.low << 1;
+        m.low ^= m.high >> 3;
+        m.low ^= m.low >> 35;
+        m.low *= xxh_prime_mx2;
+        m.low ^= m.low >> 28;
+        return {m.low, xxh3_avalanche(m.high)};
+    }
+    if (len > 0) {
+        uint32_t lo = (uint32_t{p[0]} << 16) | (uint32_t{p[len >> 1]} << 24) | p[len - 1] |
+                      static_cast<uint32_t>(len << 8);
+        uint32_t hi = std::rotl(byte_swap(lo), 13);
+        return {xxh64_avalanche(lo ^ ((xxh_read32(s) ^ xxh_read32(s + 4)) + seed)),
+                xxh64_avalanche(hi ^ ((xxh_read32(s + 8) ^ xxh_read32(s + 12)) - seed))};
+    }
+    return {xxh64_avalanche(seed ^ xxh_read64(s + 64) ^ xxh_read64(s + 72)),
+            xxh64_avalanche(seed ^ xxh_read64(s + 80) ^ xxh_read64(s + 88))};
+}
+
+// -- Inputs above 240 bytes: eight accumulators over 64-byte stripes, scrambled every 1 KiB block. --
+
+/** @brief Accumulates @p stripes stripes, scrambling whenever a block of the secret is used up. */
+inline void xxh3_consume(uint64_t *acc, std::size_t &stripes_so_far, const unsigned char *p, std::size_t stripes,
+                         const unsigned char *secret) noexcept {
+    const xxh3_kernels_t &k = xxh3_kernels();
+    while (stripes) {
+        std::size_t take = std::min(stripes, xxh3_stripes_per_block - stripes_so_far);
+        k.accumulate(acc, p, secret + stripes_so_far * xxh3_secret_consume, take);
+        p += take * xxh3_stripe_len;
+        stripes -= take;
+        stripes_so_far += take;
+        if (stripes_so_far == xxh3_stripes_per_block) {
+            k.scramble(acc, secret + xxh3_secret_size - xxh3_stripe_len);
+            stripes_so_far = 0;
+        }
+    }
+}
+
+/** @brief The final, partially overlapping stripe ending at the last input byte. */
+inline void xxh3_last_stripe(uint64_t *acc, const unsigned char *stripe, const unsigned char *secret) noexcept {
+    xxh3_kernels().accumulate(acc, stripe, secret + xxh3_secret_size - xxh3_stripe_len - 7, 1);
+}
+
+[[nodiscard]] inline uint64_t xxh3_merge(const uint64_t *acc, const unsigned char *secret, uint64_t start) noexcept {
+    for (std::size_t i = 0; i < 4; ++i) {
+        start += xxh_mul128_fold64(acc[2 * i] ^ xxh_read64(secret + 16 * i),
+                                   acc[2 * i + 1] ^ xxh_read64(secret + 16 * i + 8));
+    }
+    return xxh3_avalanche(start);
+}
+
+[[nodiscard]] inline uint64_t xxh3_64_merge(const uint64_t *acc, const unsigned char *secret, uint64_t len) noexcept {
+    return xxh3_merge(acc, secret + 11, len * xxh_prime64_1);
+}
+
+[[nodiscard]] inline hash128_t xxh3_128_merge(const uint64_t *acc, const unsigned char *secret,
+                                              uint64_t len) noexcept {
+    return {xxh3_merge(acc, secret + 11, len * xxh_prime64_1),
+            xxh3_merge(acc, secret + xxh3_secret_size - xxh3_stripe_len - 11, ~(len * xxh_prime64_2))};
+}
+
+/** @brief Long-input loop over @p len (> 240) bytes with the secret derived from @p seed, finished by @p merge. */
+template <class Merge>
+[[nodiscard]] inline auto xxh3_long(const unsigned char *p, std::size_t len, uint64_t seed, Merge merge) noexcept {
+    alignas(64) unsigned char derived[xxh3_secret_size];
+    const unsigned char *secret = xxh3_default_secret;
+    if (seed) {
+        xxh3_derive_secret(derived, seed);
+        secret = derived;
+    }
+    alignas(64) uint64_t acc[8];
+    std::memcpy(acc, xxh3_init_acc, sizeof(acc));
+    std::size_t stripes_so_far = 0;
+    xxh3_consume(acc, stripes_so_far, p, (len - 1) / xxh3_stripe_len, secret);
+    xxh3_last_stripe(acc, p + len - xxh3_stripe_len, secret);
+    return merge(acc, secret, len);
+}
+
+} // namespace detail
+
+/**
+ * @brief XXH3 64-bit hash of @p n bytes.
+ * * Inputs above 240 bytes run the accumulator loop on AVX-512, AVX2, SSE2 or NEON, whichever the CPU has.
+ */
+[[nodiscard]] inline uint64_t xxh3_64(const void *data, std::size_t n, uint64_t seed = 0) noexcept {
+    const auto *p = static_cast<const unsigned char *>(data);
+    if (n <= detail::xxh3_midsize_max) return detail::xxh3_64_short(p, n, seed);
+    return detail::xxh3_long(p, n, seed, detail::xxh3_64_merge);
+}
+
+/** @brief XXH3 64-bit hash of a byte span. */
+[[nodiscard]] inline uint64_t xxh3_64(std::span<const std::byte> data, uint64_t seed = 0) noexcept {
+    return xxh3_64(data.data(), data.size(), seed);
+}
+
+/** @brief XXH3 128-bit hash of @p n bytes (XXH3_128bits_withSeed). */
+[[nodiscard]] inline hash128_t xxh3_128(const void *data, std::size_t n, uint64_t seed = 0) noexcept {
+    const auto *p = static_cast<const unsigned char *>(data);
+    if (n <= detail::xxh3_midsize_max) return detail::xxh3_128_short(p, n, seed);
+    return detail::xxh3_long(p, n, seed, detail::xxh3_128_merge);
+}
+
+/** @brief XXH3 128-bit hash of a byte span. */
+[[nodiscard]] inline hash128_t xxh3_128(std::span<const std::byte> data, uint64_t seed = 0) noexcept {
+    return xxh3_128(data.data(), data.size(), seed);
+}
+
+/**
+ * @brief Incremental XXH3: feeding the input in any number of pieces gives the one-shot xxh3_64/xxh3_128.
+ * * Both digests come from the same state and may be taken repeatedly while more data is appended.
+ */
+class xxh3_state {
+public:
+    explicit xxh3_state(uint64_t seed = 0) noexcept { reset(seed); }
+
+    /** @brief Starts a new hash with @p seed. */
+    void reset(uint64_t seed = 0) noexcept {
+        std::memcpy(acc_, detail::xxh3_init_acc, sizeof(acc_));
+        detail::xxh3_derive_secret(secret_, seed);
+        seed_ = seed;
+        total_ = 0;
+        buffered_ = 0;
+        stripes_so_far_ = 0;
+    }
+
+    /** @brief Appends @p n bytes. */
+    void update(const void *data, std::size_t n) noexcept {
+        const auto *p = static_cast<const unsigned char *>(data);
+        total_ += n;
+        if (n <= buffer_size - buffered_) {
+            if (n) std::memcpy(buffer_ + buffered_, p, n);
+            buffered_ += n;
+            return;
+        }
+        // Stripes are consumed only once more input follows them: the last one must stay for digest().
+        if (buffered_) {
+            std::size_t fill = buffer_size - buffered_;
+            std::memcpy(buffer_ + buffered_, p, fill);
+            p += fill;
+            n -= fill;
+            consume(buffer_, buffer_size / detail::xxh3_stripe_len);
+            buffered_ = 0;
+        }
+        if (n > buffer_size) {
+            std::size_t stripes = (n - 1) / detail::xxh3_stripe_len;
+            consume(p, stripes);
+            p += stripes * detail::xxh3_stripe_len;
+            n -= stripes * detail::xxh3_stripe_len;
+            // Keeps the preceding 64 bytes for a last stripe that overlaps them.
+            std::memcpy(buffer_ + buffer_size - detail::xxh3_stripe_len, p - detail::xxh3_stripe_len,
+                        detail::xxh3_stripe_len);
+        }
+        std::memcpy(buffer_, p, n);
+        buffered_ = n;
+    }
+
+    /** @brief Appends a byte span. */
+    void update(std::span<const std::byte> data) noexcept { update(data.data(), data.size()); }
+
+    /** @brief xxh3_64 of everything appended since the last reset(). */
+    [[nodiscard]] uint64_t digest64() const noexcept {
+        if (total_ <= detail::xxh3_midsize_max) return detail::xxh3_64_short(buffer_, total_, seed_);
+        alignas(64) uint64_t acc[8];
+        finish(acc);
+        return detail::xxh3_64_merge(acc, secret_, total_);
+    }
+
+    /** @brief xxh3_128 of everything appended since the last reset(). */
+    [[nodiscard]] hash128_t digest128() const noexcept {
+        if (total_ <= detail::xxh3_midsize_max) return detail::xxh3_128_short(buffer_, total_, seed_);
+        alignas(64) uint64_t acc[8];
+        finish(acc);
+        return detail::xxh3_128_merge(acc, secret_, total_);
+    }
+
+private:
+    static constexpr std::size_t buffer_size = 4 * detail::xxh3_stripe_len;
+
+    void consume(const unsigned char *p, std::size_t stripes) noexcept {
+        detail::xxh3_consume(acc_, stripes_so_far_, p, stripes, secret_);
+    }
+
+    /** @brief Accumulators after the buffered tail, leaving the state untouched. */
+    void finish(uint64_t *acc) const noexcept {
+        std::memcpy(acc, acc_, sizeof(acc_));
+        alignas(64) unsigned char last[detail::xxh3_stripe_len];
+        const unsigned char *stripe = last;
+        if (buffered_ >= detail::xxh3_stripe_len) {
+            std::size_t stripes_so_far = stripes_so_far_;
+            std::size_t stripes = (buffered_ - 1) / detail::xxh3_stripe_len;
+            detail::xxh3_consume(acc, stripes_so_far, buffer_, stripes, secret_);
+            stripe = buffer_ + buffered_ - detail::xxh3_stripe_len;
+        } else {
+            std::size_t catchup = detail::xxh3_stripe_len - buffered_;
+            std::memcpy(last, buffer_ + buffer_size - catchup, catchup);
+            std::memcpy(last + catchup, buffer_, buffered_);
+        }
+        detail::xxh3_last_stripe(acc, stripe, secret_);
+    }
+
+    alignas(64) uint64_t acc_[8];
+    alignas(64) unsigned char secret_[detail::xxh3_secret_size];
+    alignas(64) unsigned char buffer_[buffer_size];
+    uint64_t seed_ = 0;
+    uint64_t total_ = 0;
+    std::size_t buffered_ = 0;
+    std::size_t stripes_so_far_ = 0;
+};
+
+} // namespace saburou::platform::v2::bytes
+
+/**
+ * @brief std::formatter specialization for hash128_t.
+ * Supported format specifiers: {} or {:s} for 32 hex digits (high half first), {:r} for full technical representation.
+ */
+template <> struct std::formatter<saburou::platform::v2::bytes::hash128_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for hash128_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::bytes::hash128_t &h, std::format_context &ctx) const {
+        if (repr) return std::format_to(ctx.out(), "hash128_t(low={:#018x}, high={:#018x})", h.low, h.high);
+        return std::format_to(ctx.out(), "{:016x}{:016x}", h.high, h.low);
+    }
+};
@@ -0,0 +1,11 @@
+/**
+ * @file cpu.hpp
+ * @brief Umbrella header for CPU topology, instruction-set features, current-CPU queries and per-CPU data.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/cpu/current.hpp>  // IWYU pragma: export
+#include <saburou/platform/v2/cpu/features.hpp> // IWYU pragma: export
+#include <saburou/platform/v2/cpu/per_cpu.hpp>  // IWYU pragma: export
+#include <saburou/platform/v2/cpu/topology.hpp> // IWYU pragma: export
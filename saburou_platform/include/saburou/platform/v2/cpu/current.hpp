@@ -0,0 +1,35 @@
+/**
+ * @file current.hpp
+ * @brief Cheap query of the CPU the calling thread is running on.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/cpu/detail/rseq.hpp>
+#include <saburou/platform/v2/detect.hpp>
+
+#if SABUROU_PLATFORM_V2_OS_LINUX
+#include <sched.h>
+#endif
+
+namespace saburou::platform::v2::cpu {
+
+/**
+ * @brief Returns the id of the CPU the calling thread is currently running on.
+ * * Resolution order:
+ * 1. The rseq area registered by glibc 2.35+ (a single TLS load, no syscall).
+ * 2. sched_getcpu(), which glibc serves from the vDSO getcpu where available.
+ * 3. 0 on platforms without either.
+ * @return A CPU id. The thread may migrate immediately afterwards; treat it as a sharding hint.
+ */
+[[nodiscard]] inline unsigned current_cpu() noexcept {
+    int cpu = detail::rseq_cpu();
+    if (cpu >= 0) return static_cast<unsigned>(cpu);
+#if SABUROU_PLATFORM_V2_OS_LINUX
+    cpu = ::sched_getcpu();
+    if (cpu >= 0) return static_cast<unsigned>(cpu);
+#endif
+    return 0;
+}
+
+} // namespace saburou::platform::v2::cpu
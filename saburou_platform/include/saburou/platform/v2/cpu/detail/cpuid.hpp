@@ -0,0 +1,65 @@
+/**
+ * @file cpuid.hpp
+ * @brief Portable wrapper around the x86 CPUID instruction.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+
+#include <cstdint>
+
+#if SABUROU_PLATFORM_V2_ARCH_X86
+#if SABUROU_PLATFORM_V2_MSVC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace saburou::platform::v2::cpu::detail {
+
+/** @brief Raw CPUID output registers. */
+struct cpuid_t {
+    uint32_t eax = 0;
+    uint32_t ebx = 0;
+    uint32_t ecx = 0;
+    uint32_t edx = 0;
+};
+
+/** @brief True if the target architecture has a CPUID instruction. */
+inline constexpr bool has_cpuid = SABUROU_PLATFORM_V2_ARCH_X86;
+
+/**
+ * @brief Executes CPUID for a leaf/subleaf.
+ * @return The four output registers; all zero on non-x86 targets.
+ * @note Leaves are not range-checked; query leaf 0 (or 0x80000000) first for the maximum supported leaf.
+ */
+[[nodiscard]] inline cpuid_t cpuid(uint32_t leaf, uint32_t subleaf = 0) noexcept {
+    cpuid_t r{};
+#if SABUROU_PLATFORM_V2_ARCH_X86
+#if SABUROU_PLATFORM_V2_MSVC
+    int regs[4];
+    __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+    r = {static_cast<uint32_t>(regs[0]), static_cast<uint32_t>(regs[1]), static_cast<uint32_t>(regs[2]),
+         static_cast<uint32_t>(regs[3])};
+#else
+    __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+#else
+    (void)leaf;
+    (void)subleaf;
+#endif
+    return r;
+}
+
+/** @brief Copies the 12-byte vendor signature stored in EBX, ECX, EDX (hypervisor leaf order). */
+inline void vendor_bytes(const cpuid_t &r, char (&out)[13], bool leaf0_order = false) noexcept {
+    // Leaf 0 stores the vendor as EBX, EDX, ECX; hypervisor leaves use EBX, ECX, EDX.
+    const uint32_t regs[3] = {r.ebx, leaf0_order ? r.edx : r.ecx, leaf0_order ? r.ecx : r.edx};
+    for (int i = 0; i < 3; ++i)
+        for (int b = 0; b < 4; ++b) out[i * 4 + b] = static_cast<char>((regs[i] >> (8 * b)) & 0xFF);
+    out[12] = '\0';
+}
+
+} // namespace saburou::platform::v2::cpu::detail
@@ -0,0 +1,106 @@
+/**
+ * @file rseq.hpp
+ * @brief Access to the C library's registered rseq area and a restartable per-CPU add.
+ *
+ * glibc 2.35+ registers one struct rseq per thread and publishes its location as an offset from the
+ * thread pointer (__rseq_offset). The kernel keeps cpu_id up to date on every return to user space, so
+ * reading the current CPU is a single load. A restartable sequence additionally lets a thread modify
+ * per-CPU data without atomics: if it is preempted or migrated inside the critical section, the kernel
+ * diverts it to an abort handler and the operation is retried.
+ *
+ * SABUROU_PLATFORM_V2_CPU_RSEQ is the one test for glibc's rseq registration (<sys/rseq.h>, __rseq_offset
+ * and __rseq_size); kernel_features() includes this header for it too.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+
+#include <cstdint>
+
+#if SABUROU_PLATFORM_V2_OS_LINUX && __has_include(<sys/rseq.h>) && defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 35)
+#include <sys/rseq.h>
+#define SABUROU_PLATFORM_V2_CPU_RSEQ 1
+#endif
+#endif
+#ifndef SABUROU_PLATFORM_V2_CPU_RSEQ
+#define SABUROU_PLATFORM_V2_CPU_RSEQ 0
+#endif
+
+// The restartable add needs hand-written critical sections; only x86-64 with GNU asm goto is provided.
+#if SABUROU_PLATFORM_V2_CPU_RSEQ && SABUROU_PLATFORM_V2_ARCH_X86_64 && (SABUROU_PLATFORM_V2_GCC || SABUROU_PLATFORM_V2_CLANG)
+#define SABUROU_PLATFORM_V2_CPU_RSEQ_ADD 1
+#else
+#define SABUROU_PLATFORM_V2_CPU_RSEQ_ADD 0
+#endif
+
+namespace saburou::platform::v2::cpu::detail {
+
+#if SABUROU_PLATFORM_V2_CPU_RSEQ
+
+/** @brief The calling thread's registered rseq area, or nullptr if the C library did not register one. */
+[[nodiscard]] inline struct rseq *rseq_area() noexcept {
+    if (__rseq_size == 0) return nullptr;
+    return reinterpret_cast<struct rseq *>(static_cast<char *>(__builtin_thread_pointer()) + __rseq_offset);
+}
+
+/**
+ * @brief Reads the CPU the thread is running on from its rseq area.
+ * @return The CPU id, or -1 if rseq is not registered for this thread.
+ */
+[[nodiscard]] inline int rseq_cpu() noexcept {
+    struct rseq *area = rseq_area();
+    if (!area) return -1;
+    // Negative values are RSEQ_CPU_ID_UNINITIALIZED / RSEQ_CPU_ID_REGISTRATION_FAILED.
+    return static_cast<int>(__atomic_load_n(&area->cpu_id, __ATOMIC_RELAXED));
+}
+
+#else
+
+[[nodiscard]] inline int rseq_cpu() noexcept { return -1; }
+
+#endif
+
+#if SABUROU_PLATFORM_V2_CPU_RSEQ_ADD
+
+/**
+ * @brief Adds @p count to @p *target if, and only if, the thread is still running on @p cpu.
+ * * The load-add-store is committed by a single instruction at the end of the critical section; if the
+ * kernel preempts, migrates or signals the thread before that point it jumps to the abort label.
+ * @return True on commit, false if the sequence was aborted (caller re-reads the CPU and retries).
+ * @note The 4 bytes before the abort handler must equal the signature glibc registered (RSEQ_SIG).
+ */
+[[nodiscard]] inline bool rseq_add(uint64_t *target, uint64_t count, int cpu) noexcept {
+    __asm__ goto(
+        ".pushsection __rseq_cs, \"aw\"\n\t"
+        ".balign 32\n\t"
+        "3:\n\t"
+        ".long 0x0, 0x0\n\t"            // version, flags
+        ".quad 1f, (2f - 1f), 4f\n\t"   // start_ip, post_commit_offset, abort_ip
+        ".popsection\n\t"
+        "leaq 3b(%%rip), %%rax\n\t"
+        "movq %%rax, %%fs:8(%[offset])\n\t" // rseq->rseq_cs = &descriptor
+        "1:\n\t"
+        "cmpl %[cpu], %%fs:4(%[offset])\n\t" // rseq->cpu_id == cpu ?
+        "jnz %l[aborted]\n\t"
+        "addq %[count], %[v]\n\t"            // commit
+        "2:\n\t"
+        ".pushsection __rseq_failure, \"ax\"\n\t"
+        ".byte 0x0f, 0xb9, 0x3d\n\t"        // ud1 <sig>(%rip), %edi: keeps disassemblers in sync
+        ".long 0x53053053\n\t"               // RSEQ_SIG
+        "4:\n\t"
+        "jmp %l[aborted]\n\t"
+        ".popsection\n\t"
+        : [v] "+m"(*target)
+        : [cpu] "r"(cpu), [offset] "r"(__rseq_offset), [count] "er"(count)
+        : "memory", "cc", "rax"
+        : aborted);
+    return true;
+aborted:
+    return false;
+}
+
+#endif
+
+} // namespace saburou::platform::v2::cpu::detail
@@ -0,0 +1,211 @@
+/**
+ * @file features.hpp
+ * @brief Runtime instruction-set detection, and the target attribute used by dispatched SIMD kernels.
+ *
+ * @code
+ * SABUROU_PLATFORM_V2_TARGET("avx2") void sum_avx2(const float *p, std::size_t n);
+ * if (cpu::features().avx2) sum_avx2(p, n); else sum_scalar(p, n);
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/cpu/detail/cpuid.hpp>
+#include <saburou/platform/v2/detect.hpp>
+
+#include <cstdint>
+#include <format>
+#include <string>
+#include <utility>
+
+#if SABUROU_PLATFORM_V2_ARCH_ARM && SABUROU_PLATFORM_V2_OS_LINUX
+#include <sys/auxv.h>
+#endif
+
+/**
+ * @brief Compiles one function for an instruction set beyond the build baseline (GCC/Clang).
+ * * Callers must check cpu::features() before calling it. Expands to nothing on compilers without
+ * per-function targets, where the SIMD paths below are compiled only if the baseline enables them.
+ */
+#if SABUROU_PLATFORM_V2_GCC || SABUROU_PLATFORM_V2_CLANG
+#define SABUROU_PLATFORM_V2_TARGET(isa) __attribute__((target(isa)))
+#define SABUROU_PLATFORM_V2_HAS_TARGET_ATTRIBUTE 1
+#else
+#define SABUROU_PLATFORM_V2_TARGET(isa)
+#define SABUROU_PLATFORM_V2_HAS_TARGET_ATTRIBUTE 0
+#endif
+
+/** @brief True when x86 SIMD kernels up to AVX-512 can be compiled (GCC/Clang on x86). */
+#if SABUROU_PLATFORM_V2_ARCH_X86 && SABUROU_PLATFORM_V2_HAS_TARGET_ATTRIBUTE
+#define SABUROU_PLATFORM_V2_SIMD_X86 1
+#else
+#define SABUROU_PLATFORM_V2_SIMD_X86 0
+#endif
+
+/** @brief True when NEON kernels can be compiled (AArch64, where Advanced SIMD is part of the base ISA). */
+#if SABUROU_PLATFORM_V2_ARCH_ARM_64 && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define SABUROU_PLATFORM_V2_SIMD_NEON 1
+#else
+#define SABUROU_PLATFORM_V2_SIMD_NEON 0
+#endif
+
+namespace saburou::platform::v2::cpu {
+
+/**
+ * @brief Instruction-set extensions usable by this process.
+ * * x86 AVX/AVX-512 flags are only set when the OS also saves the wider register state (XGETBV).
+ */
+struct features_t {
+    // x86
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sse42 = false;        ///< Also implies the CRC32C instruction
+    bool pclmul = false;       ///< Carry-less multiply (PCLMULQDQ)
+    bool popcnt = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool bmi1 = false;
+    bool bmi2 = false;         ///< PDEP/PEXT (microcoded and slow on AMD before Zen 3)
+    bool fma = false;
+    bool f16c = false;         ///< fp16 <-> fp32 conversion
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool avx512vl = false;
+    bool avx512vbmi = false;   ///< VPERMB and friends
+    bool avx512vbmi2 = false;
+    bool avx512fp16 = false;
+    bool avx512bf16 = false;
+    bool vpclmulqdq = false;   ///< Carry-less multiply on 256/512-bit vectors
+    bool gfni = false;
+    // AArch64
+    bool neon = false;
+    bool arm_crc32 = false;    ///< CRC32/CRC32C instructions
+    bool arm_pmull = false;    ///< 64x64 polynomial multiply (PMULL/PMULL2)
+    bool arm_fp16 = false;     ///< Half-precision arithmetic
+    bool arm_bf16 = false;
+    bool sve = false;
+
+    /** @brief AVX-512 F + BW + VL, the subset byte-oriented kernels need. */
+    [[nodiscard]] bool has_avx512_core() const noexcept { return avx512f && avx512bw && avx512vl; }
+};
+
+namespace detail {
+
+#if SABUROU_PLATFORM_V2_ARCH_X86
+/** @brief Reads XCR0, the register-state mask the OS saves on context switch. */
+[[nodiscard]] inline uint64_t xcr0() noexcept {
+#if SABUROU_PLATFORM_V2_MSVC
+    return _xgetbv(0);
+#else
+    uint32_t eax = 0, edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (uint64_t{edx} << 32) | eax;
+#endif
+}
+#endif
+
+/** @brief Probes the running CPU; see features(). */
+[[nodiscard]] inline features_t detect_features() noexcept {
+    features_t f{};
+#if SABUROU_PLATFORM_V2_ARCH_X86
+    auto bit = [](uint32_t reg, int n) { return ((reg >> n) & 1u) != 0; };
+    uint32_t max_leaf = cpuid(0).eax;
+    cpuid_t l1 = cpuid(1);
+    f.sse2 = bit(l1.edx, 26);
+    f.pclmul = bit(l1.ecx, 1);
+    f.ssse3 = bit(l1.ecx, 9);
+    f.fma = bit(l1.ecx, 12);
+    f.sse41 = bit(l1.ecx, 19);
+    f.sse42 = bit(l1.ecx, 20);
+    f.popcnt = bit(l1.ecx, 23);
+    bool osxsave = bit(l1.ecx, 27);
+    uint64_t xcr = osxsave ? xcr0() : 0;
+    bool ymm = (xcr & 0x6) == 0x6;    // XMM + YMM state
+    bool zmm = (xcr & 0xE6) == 0xE6;  // plus opmask and both ZMM halves
+    f.avx = ymm && bit(l1.ecx, 28);
+    f.f16c = f.avx && bit(l1.ecx, 29);
+    f.fma = f.fma && f.avx;
+    if (max_leaf >= 7) {
+        cpuid_t l7 = cpuid(7, 0);
+        f.bmi1 = bit(l7.ebx, 3);
+        f.avx2 = f.avx && bit(l7.ebx, 5);
+        f.bmi2 = bit(l7.ebx, 8);
+        f.avx512f = zmm && bit(l7.ebx, 16);
+        f.avx512bw = f.avx512f && bit(l7.ebx, 30);
+        f.avx512vl = f.avx512f && bit(l7.ebx, 31);
+        f.avx512vbmi = f.avx512f && bit(l7.ecx, 1);
+        f.avx512vbmi2 = f.avx512f && bit(l7.ecx, 6);
+        f.gfni = bit(l7.ecx, 8);
+        f.vpclmulqdq = f.avx && bit(l7.ecx, 10);
+        f.avx512fp16 = f.avx512f && bit(l7.edx, 23);
+        if (l7.eax >= 1) f.avx512bf16 = f.avx512f && bit(cpuid(7, 1).eax, 5);
+    }
+#elif SABUROU_PLATFORM_V2_ARCH_ARM_64
+    f.neon = true; // Advanced SIMD is mandatory on AArch64
+#if SABUROU_PLATFORM_V2_OS_LINUX
+    unsigned long hwcap = ::getauxval(AT_HWCAP), hwcap2 = ::getauxval(AT_HWCAP2);
+    f.arm_pmull = (hwcap >> 4) & 1;   // HWCAP_PMULL
+    f.arm_crc32 = (hwcap >> 7) & 1;   // HWCAP_CRC32
+    f.arm_fp16 = (hwcap >> 10) & 1;   // HWCAP_ASIMDHP
+    f.sve = (hwcap >> 22) & 1;        // HWCAP_SVE
+    f.arm_bf16 = (hwcap2 >> 14) & 1;  // HWCAP2_BF16
+#elif SABUROU_PLATFORM_V2_OS_DARWIN
+    f.arm_pmull = f.arm_crc32 = f.arm_fp16 = true; // every Apple silicon core
+#endif
+#endif
+    return f;
+}
+
+} // namespace detail
+
+/**
+ * @brief Extensions of the CPU the process runs on, probed once.
+ */
+[[nodiscard]] inline const features_t &features() noexcept {
+    static const features_t f = detail::detect_features();
+    return f;
+}
+
+} // namespace saburou::platform::v2::cpu
+
+/**
+ * @brief std::formatter specialization for features_t.
+ * Supported format specifiers: {} or {:s} for the list of present extensions, {:r} for full technical representation.
+ */
+template <> struct std::formatter<saburou::platform::v2::cpu::features_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for features_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::cpu::features_t &f, std::format_context &ctx) const {
+        const std::pair<const char *, bool> flags[] = {
+            {"sse2", f.sse2}, {"ssse3", f.ssse3}, {"sse41", f.sse41}, {"sse42", f.sse42}, {"pclmul", f.pclmul},
+            {"popcnt", f.popcnt}, {"avx", f.avx}, {"avx2", f.avx2}, {"bmi1", f.bmi1}, {"bmi2", f.bmi2},
+            {"fma", f.fma}, {"f16c", f.f16c}, {"avx512f", f.avx512f}, {"avx512bw", f.avx512bw},
+            {"avx512vl", f.avx512vl}, {"avx512vbmi", f.avx512vbmi}, {"avx512vbmi2", f.avx512vbmi2},
+            {"avx512fp16", f.avx512fp16}, {"avx512bf16", f.avx512bf16}, {"vpclmulqdq", f.vpclmulqdq},
+            {"gfni", f.gfni}, {"neon", f.neon}, {"arm_crc32", f.arm_crc32}, {"arm_pmull", f.arm_pmull},
+            {"arm_fp16", f.arm_fp16}, {"arm_bf16", f.arm_bf16}, {"sve", f.sve},
+        };
+        std::string out = "features(";
+        bool first = true;
+        for (const auto &[name, value] : flags) {
+            if (!repr && !value) continue;
+            if (!first) out += repr ? ", " : " ";
+            first = false;
+            out += repr ? std::format("{}={}", name, value) : name;
+        }
+        out += ')';
+        return std::format_to(ctx.out(), "{}", out);
+    }
+};
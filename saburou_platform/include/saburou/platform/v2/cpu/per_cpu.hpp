@@ -0,0 +1,121 @@
+/**
+ * @file per_cpu.hpp
+ * @brief Cacheline-padded per-CPU storage and contention-free counters.
+ *
+ * @code
+ * static cpu::per_cpu_counter requests;
+ * requests.add();                 // rseq commit on x86-64 Linux, relaxed atomic elsewhere
+ * uint64_t total = requests.sum();
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/cpu/current.hpp>
+#include <saburou/platform/v2/cpu/detail/rseq.hpp>
+#include <saburou/platform/v2/cpu/topology.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace saburou::platform::v2::cpu {
+
+/**
+ * @brief One cacheline-aligned slot of T per possible CPU.
+ * * local() picks the slot of the CPU the thread is running on. Since the thread can migrate right after
+ * the lookup, T must tolerate concurrent access from other CPUs (atomics, or data only mutated through
+ * restartable sequences); the win is that such conflicts become rare instead of constant.
+ * @tparam T Slot type; default-constructed once per slot.
+ */
+template <class T> class per_cpu {
+public:
+    /**
+     * @brief Allocates the slots.
+     * @param slots Number of slots; defaults to possible_count() so every CPU id has its own line.
+     */
+    explicit per_cpu(std::size_t slots = possible_count())
+        : size_(slots ? slots : 1), slots_(std::make_unique<slot_t[]>(size_)) {}
+
+    /** @brief Number of slots. */
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /** @brief Slot of the CPU the caller is currently running on. */
+    [[nodiscard]] T &local() noexcept { return slots_[current_cpu() % size_].value; }
+
+    /** @brief Slot for a given CPU id (wrapped into range). */
+    [[nodiscard]] T &operator[](std::size_t cpu) noexcept { return slots_[cpu % size_].value; }
+    [[nodiscard]] const T &operator[](std::size_t cpu) const noexcept { return slots_[cpu % size_].value; }
+
+    /** @brief Invokes fn(slot) on every slot, in CPU id order. */
+    template <class F> void for_each(F &&fn) {
+        for (std::size_t i = 0; i < size_; ++i) fn(slots_[i].value);
+    }
+    template <class F> void for_each(F &&fn) const {
+        for (std::size_t i = 0; i < size_; ++i) fn(slots_[i].value);
+    }
+
+private:
+    struct alignas(cacheline_size) slot_t {
+        T value{};
+    };
+
+    std::size_t size_;
+    std::unique_ptr<slot_t[]> slots_;
+};
+
+/**
+ * @brief Sharded 64-bit counter with one cacheline per CPU.
+ * * add() uses an rseq critical section when the C library registered rseq (x86-64 Linux), which needs
+ * no lock prefix at all; otherwise it falls back to a relaxed fetch_add on the local CPU's line.
+ * * An rseq commit is a plain add, atomic only against other commits on the same CPU, so while rseq is
+ * registered a shard is written by rseq alone. Adds that cannot commit (thread not registered, CPU id past
+ * the shards, repeated aborts) go to a separate atomic line instead of a shard another CPU may be committing to.
+ */
+class per_cpu_counter {
+public:
+    /** @brief See per_cpu::per_cpu. With fewer slots than possible CPUs, the CPUs past them share one line. */
+    explicit per_cpu_counter(std::size_t slots = possible_count()) : slots_(slots) {}
+
+    /** @brief Adds @p n to the current CPU's shard. */
+    void add(uint64_t n = 1) noexcept {
+#if SABUROU_PLATFORM_V2_CPU_RSEQ_ADD
+        // rseq is registered for the whole process or not at all; without it every thread uses the atomics below.
+        if (detail::rseq_area()) {
+            for (int attempt = 0; attempt < 8; ++attempt) {
+                int cpu = detail::rseq_cpu();
+                // Registration failed for this thread, or its CPU has no shard of its own.
+                if (cpu < 0 || static_cast<std::size_t>(cpu) >= slots_.size()) break;
+                if (detail::rseq_add(reinterpret_cast<uint64_t *>(&slots_[static_cast<std::size_t>(cpu)]), n, cpu))
+                    return;
+            }
+            shared_.value.fetch_add(n, std::memory_order_relaxed);
+            return;
+        }
+#endif
+        slots_.local().fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /** @brief Sum of all shards. Concurrent adds may or may not be included. */
+    [[nodiscard]] uint64_t sum() const noexcept {
+        uint64_t total = shared_.value.load(std::memory_order_relaxed);
+        slots_.for_each([&](const std::atomic<uint64_t> &v) { total += v.load(std::memory_order_relaxed); });
+        return total;
+    }
+
+    /** @brief Resets every shard to zero. Not atomic with respect to concurrent adds. */
+    void reset() noexcept {
+        slots_.for_each([](std::atomic<uint64_t> &v) { v.store(0, std::memory_order_relaxed); });
+        shared_.value.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t) && std::atomic<uint64_t>::is_always_lock_free);
+    per_cpu<std::atomic<uint64_t>> slots_;
+    struct alignas(cacheline_size) {
+        std::atomic<uint64_t> value{0};
+    } shared_; ///< Adds that could not commit through rseq.
+};
+
+} // namespace saburou::platform::v2::cpu
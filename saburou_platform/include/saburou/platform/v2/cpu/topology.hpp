@@ -0,0 +1,82 @@
+/**
+ * @file topology.hpp
+ * @brief CPU count and cacheline queries used to size per-CPU data.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+
+#include <cstddef>
+#include <thread>
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+#include <unistd.h>
+#endif
+#if SABUROU_PLATFORM_V2_OS_LINUX
+#include <saburou/platform/v2/os/linux/procfs/parse.hpp>
+#include <saburou/platform/v2/os/linux/procfs/reader.hpp>
+#endif
+
+namespace saburou::platform::v2::cpu {
+
+#if SABUROU_PLATFORM_V2_GCC && SABUROU_PLATFORM_V2_MAJOR >= 12
+// GCC warns on any use of hardware_destructive_interference_size from a header (its value follows -mtune).
+// Reading it in exactly one place keeps the choice explicit without flooding every includer.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+/**
+ * @brief Cacheline size used for padding, in bytes.
+ * * Uses SABUROU_PLATFORM_V2_CACHELINE when the standard library provides it, 64 otherwise.
+ */
+inline constexpr std::size_t cacheline_size = SABUROU_PLATFORM_V2_CACHELINE ? SABUROU_PLATFORM_V2_CACHELINE : 64;
+#if SABUROU_PLATFORM_V2_GCC && SABUROU_PLATFORM_V2_MAJOR >= 12
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * @brief Number of CPU ids the kernel may ever hand out (highest possible id + 1).
+ * * On Linux this reads /sys/devices/system/cpu/possible ("0-127"), which also covers hot-pluggable
+ * CPUs; elsewhere it falls back to the configured processor count.
+ * @return At least 1. The value is computed once.
+ */
+[[nodiscard]] inline std::size_t possible_count() {
+    static const std::size_t count = [] {
+        std::size_t n = 0;
+#if SABUROU_PLATFORM_V2_OS_LINUX
+        namespace procfs = saburou::platform::v2::os::linux::procfs;
+        procfs::file_reader possible("/sys/devices/system/cpu/possible", 256);
+        std::string_view text = procfs::trim(possible.read());
+        // Ranges like "0-3,8-11": the last number is the highest id.
+        auto pos = text.find_last_of(",-");
+        std::size_t last = 0;
+        if (!text.empty() && procfs::parse_number(pos == std::string_view::npos ? text : text.substr(pos + 1), last))
+            n = last + 1;
+#endif
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+        if (n == 0) {
+            long conf = ::sysconf(_SC_NPROCESSORS_CONF);
+            if (conf > 0) n = static_cast<std::size_t>(conf);
+        }
+#endif
+        if (n == 0) n = std::thread::hardware_concurrency();
+        return n ? n : std::size_t{1};
+    }();
+    return count;
+}
+
+/**
+ * @brief Number of CPUs currently online.
+ * @return At least 1. Queried on every call, since CPUs can be hot-plugged.
+ */
+[[nodiscard]] inline std::size_t online_count() {
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+    long online = ::sysconf(_SC_NPROCESSORS_ONLN);
+    if (online > 0) return static_cast<std::size_t>(online);
+#endif
+    unsigned hc = std::thread::hardware_concurrency();
+    return hc ? hc : 1;
+}
+
+} // namespace saburou::platform::v2::cpu
@@ -0,0 +1,12 @@
+/**
+ * @file io.hpp
+ * @brief Umbrella header for file I/O: memory mapping, direct and asynchronous readers, zero-copy transfers.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/io/async_engine.hpp>  // IWYU pragma: export
+#include <saburou/platform/v2/io/direct_reader.hpp> // IWYU pragma: export
+#include <saburou/platform/v2/io/mapped_file.hpp>   // IWYU pragma: export
+#include <saburou/platform/v2/io/transfer.hpp>      // IWYU pragma: export
+#include <saburou/platform/v2/io/uring.hpp>         // IWYU pragma: export
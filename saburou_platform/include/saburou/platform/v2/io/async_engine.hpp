@@ -0,0 +1,211 @@
+/**
+ * @file async_engine.hpp
+ * @brief Batched asynchronous positional file I/O: io_uring when the kernel offers it, a pread pool otherwise.
+ *
+ * @code
+ * auto engine = io::async_engine::create();
+ * for (uint64_t i = 0; i < 64; ++i) engine->read(fd, blocks[i], i * block, i);
+ * engine->submit();                          // one io_uring_enter for the whole batch
+ * io::completion_t done[64];
+ * auto n = engine->wait(done, 64);
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+#include <saburou/platform/v2/io/uring.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <memory>
+#include <span>
+#include <system_error>
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+#include <saburou/platform/v2/io/detail/pread_pool.hpp>
+#endif
+#if SABUROU_PLATFORM_V2_OS_LINUX
+#include <saburou/platform/v2/os/linux/kernel/query.hpp>
+#endif
+
+namespace saburou::platform::v2::io {
+
+/**
+ * @brief Mechanism an async_engine uses to run requests.
+ */
+enum class backend_t : uint8_t {
+    io_uring,   // Raw-syscall io_uring ring (Linux 5.6+ with IORING_OP_READ/WRITE)
+    thread_pool // Worker threads issuing pread()/pwrite()
+};
+
+/**
+ * @brief Options for async_engine::create().
+ */
+struct engine_options_t {
+    unsigned queue_depth = 128; ///< io_uring SQ size; also the batch size that triggers an implicit submit
+    unsigned threads = 4;       ///< Workers for the thread-pool backend
+    bool allow_io_uring = true; ///< Set to false to force the thread-pool backend
+};
+
+/**
+ * @brief Converts a backend_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(backend_t b) {
+    switch (b) {
+    case backend_t::io_uring:    return "io_uring";
+    case backend_t::thread_pool: return "thread_pool";
+    default:                     return "unknown";
+    }
+}
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+
+/**
+ * @brief Queue-prepare-submit-wait I/O engine over interchangeable backends.
+ * * read()/write() only stage requests; submit() hands the whole batch over at once. Buffers must stay
+ * alive until their completion is returned by wait(). The backend is picked at creation from the cached
+ * kernel probe, so old kernels and seccomp-restricted containers silently get the thread pool.
+ * @note Not thread-safe: one engine per thread.
+ */
+class async_engine {
+public:
+    async_engine(async_engine &&) noexcept = default;
+    async_engine &operator=(async_engine &&) noexcept = default;
+    ~async_engine() = default;
+
+    /**
+     * @brief Creates an engine.
+     * @return The engine, or the error of ring setup when io_uring looked available but failed.
+     */
+    [[nodiscard]] static std::expected<async_engine, std::error_code> create(const engine_options_t &options = {}) {
+        async_engine engine;
+        engine.depth_ = options.queue_depth ? options.queue_depth : 1;
+#if SABUROU_PLATFORM_V2_OS_LINUX && SABUROU_PLATFORM_V2_HAS_IO_URING_UAPI
+        const auto &k = os::linux::kernel_features();
+        if (options.allow_io_uring && k.has_io_uring_op(detail::uring_abi::op_read) &&
+            k.has_io_uring_op(detail::uring_abi::op_write)) {
+            auto ring = uring::create(engine.depth_);
+            if (ring) {
+                engine.ring_ = std::make_unique<uring>(std::move(*ring));
+                return engine;
+            }
+            // Probed fine but refused now (e.g., RLIMIT_MEMLOCK on pre-5.12 kernels): use the pool.
+        }
+#endif
+        engine.pool_ = std::make_unique<detail::pread_pool>(options.threads);
+        return engine;
+    }
+
+    /** @brief Backend in use. */
+    [[nodiscard]] backend_t backend() const noexcept { return pool_ ? backend_t::thread_pool : backend_t::io_uring; }
+
+#if SABUROU_PLATFORM_V2_OS_LINUX && SABUROU_PLATFORM_V2_HAS_IO_URING_UAPI
+    /** @brief Underlying ring, or nullptr on the thread-pool backend (for registered buffers/files). */
+    [[nodiscard]] uring *ring() noexcept { return ring_.get(); }
+#endif
+
+    /**
+     * @brief Stages a positional read. A full batch is submitted implicitly.
+     * @return An error only if that implicit submit failed.
+     */
+    std::error_code read(int fd, std::span<std::byte> buffer, uint64_t offset, uint64_t user_data) {
+        return stage({fd, false, buffer.data(), buffer.size(), offset, user_data});
+    }
+
+    /** @brief Stages a positional write. */
+    std::error_code write(int fd, std::span<const std::byte> buffer, uint64_t offset, uint64_t user_data) {
+        return stage({fd, true, const_cast<std::byte *>(buffer.data()), buffer.size(), offset, user_data});
+    }
+
+    /** @brief Hands every staged request to the backend. @return Number submitted. */
+    std::expected<unsigned, std::error_code> submit() {
+#if SABUROU_PLATFORM_V2_OS_LINUX && SABUROU_PLATFORM_V2_HAS_IO_URING_UAPI
+        if (ring_) return ring_->submit();
+#endif
+        return pool_->flush();
+    }
+
+    /**
+     * @brief Submits staged requests, then waits for at least @p min_complete completions.
+     * @return Number of completions written to @p out. Fewer than @p min_complete only when nothing
+     * else is in flight.
+     */
+    std::expected<unsigned, std::error_code> wait(std::span<completion_t> out, unsigned min_complete = 1) {
+        if (min_complete > out.size()) min_complete = static_cast<unsigned>(out.size());
+#if SABUROU_PLATFORM_V2_OS_LINUX && SABUROU_PLATFORM_V2_HAS_IO_URING_UAPI
+        if (ring_) {
+            if (ring_->pending()) {
+                if (auto s = ring_->submit(); !s) return std::unexpected(s.error());
+            }
+            unsigned got = ring_->reap(out);
+            while (got < min_complete && in_flight_ > got) {
+                auto r = ring_->submit_and_wait(out.subspan(got), min_complete - got);
+                if (!r) return std::unexpected(r.error());
+                got += *r;
+            }
+            in_flight_ -= got;
+            return got;
+        }
+#endif
+        pool_->flush();
+        return pool_->wait(out, min_complete);
+    }
+
+private:
+    async_engine() = default; // only create() builds engines: every operation needs a backend
+
+    std::error_code stage(const detail::request_t &r) {
+#if SABUROU_PLATFORM_V2_OS_LINUX && SABUROU_PLATFORM_V2_HAS_IO_URING_UAPI
+        if (ring_) {
+            auto queue = [&] {
+                return r.write ? ring_->prep_write(r.fd, {r.data, r.length}, r.offset, r.user_data)
+                               : ring_->prep_read(r.fd, {r.data, r.length}, r.offset, r.user_data);
+            };
+            if (!queue()) {
+                if (auto s = ring_->submit(); !s) return s.error();
+                if (!queue()) return std::make_error_code(std::errc::resource_unavailable_try_again);
+            }
+            ++in_flight_;
+            return {};
+        }
+#endif
+        pool_->stage(r);
+        if (pool_->staged() >= depth_) pool_->flush();
+        return {};
+    }
+
+#if SABUROU_PLATFORM_V2_OS_LINUX && SABUROU_PLATFORM_V2_HAS_IO_URING_UAPI
+    std::unique_ptr<uring> ring_;
+    std::size_t in_flight_ = 0; // staged or submitted, not yet reaped
+#endif
+    std::unique_ptr<detail::pread_pool> pool_;
+    unsigned depth_ = 128;
+};
+
+#endif // SABUROU_PLATFORM_V2_POSIX_LIKE
+
+} // namespace saburou::platform::v2::io
+
+/**
+ * @brief std::formatter specialization for backend_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "backend_t::io_uring").
+ */
+template <> struct std::formatter<saburou::platform::v2::io::backend_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::io::backend_t &b, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::io::to_code_name(b);
+        return repr ? std::format_to(ctx.out(), "backend_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
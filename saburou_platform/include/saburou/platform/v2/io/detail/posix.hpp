@@ -0,0 +1,78 @@
+/**
+ * @file posix.hpp
+ * @brief Shared POSIX helpers for the I/O module: descriptors, errno mapping and page geometry.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+#include <saburou/platform/v2/memory/pages.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace saburou::platform::v2::io::posix {
+
+/** @brief Wraps the current errno into a std::error_code. */
+[[nodiscard]] inline std::error_code last_error() noexcept { return {errno, std::generic_category()}; }
+
+using saburou::platform::v2::memory::page_size;
+
+/** @brief Rounds @p value down to a multiple of @p align (a power of two). */
+[[nodiscard]] constexpr std::size_t align_down(std::size_t value, std::size_t align) noexcept {
+    return value & ~(align - 1);
+}
+
+/** @brief Rounds @p value up to a multiple of @p align (a power of two). */
+[[nodiscard]] constexpr std::size_t align_up(std::size_t value, std::size_t align) noexcept {
+    return (value + align - 1) & ~(align - 1);
+}
+
+/** @brief open() that retries on EINTR; O_CLOEXEC is always added. */
+[[nodiscard]] inline int open_retry(const char *path, int flags, mode_t mode = 0644) noexcept {
+    int fd;
+    do {
+        fd = ::open(path, flags | O_CLOEXEC, mode);
+    } while (fd < 0 && errno == EINTR);
+    return fd;
+}
+
+/** @brief Move-only owner of a file descriptor. */
+class unique_fd {
+public:
+    unique_fd() = default;
+    explicit unique_fd(int fd) noexcept : fd_(fd) {}
+
+    unique_fd(const unique_fd &) = delete;
+    unique_fd &operator=(const unique_fd &) = delete;
+
+    unique_fd(unique_fd &&other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+    unique_fd &operator=(unique_fd &&other) noexcept {
+        if (this != &other) reset(std::exchange(other.fd_, -1));
+        return *this;
+    }
+
+    ~unique_fd() { reset(); }
+
+    [[nodiscard]] int get() const noexcept { return fd_; }
+    [[nodiscard]] explicit operator bool() const noexcept { return fd_ >= 0; }
+
+    /** @brief Gives up ownership without closing. */
+    [[nodiscard]] int release() noexcept { return std::exchange(fd_, -1); }
+
+    /** @brief Closes the current descriptor (if any) and adopts @p fd. */
+    void reset(int fd = -1) noexcept {
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = fd;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+} // namespace saburou::platform::v2::io::posix
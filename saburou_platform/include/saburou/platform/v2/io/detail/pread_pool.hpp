@@ -0,0 +1,131 @@
+/**
+ * @file pread_pool.hpp
+ * @brief Thread-pool pread/pwrite backend used by async_engine when io_uring is unavailable.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/io/uring.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cerrno>
+#include <unistd.h>
+
+namespace saburou::platform::v2::io::detail {
+
+/** @brief One queued positional read or write. */
+struct request_t {
+    int fd = -1;
+    bool write = false;
+    std::byte *data = nullptr;
+    std::size_t length = 0;
+    uint64_t offset = 0;
+    uint64_t user_data = 0;
+};
+
+/**
+ * @brief Fixed set of workers draining a shared request queue with pread()/pwrite().
+ * * Requests are staged by the caller and handed over in batches by flush(), mirroring the io_uring
+ * prepare/submit split so async_engine can drive both backends the same way.
+ */
+class pread_pool {
+public:
+    explicit pread_pool(unsigned threads) {
+        if (threads == 0) threads = 1;
+        workers_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) workers_.emplace_back([this] { run(); });
+    }
+
+    pread_pool(const pread_pool &) = delete;
+    pread_pool &operator=(const pread_pool &) = delete;
+
+    ~pread_pool() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        work_cv_.notify_all();
+        for (auto &t : workers_) t.join();
+    }
+
+    /** @brief Stages a request; nothing runs until flush(). */
+    void stage(const request_t &r) { staged_.push_back(r); }
+
+    /** @brief Requests staged and not yet flushed. */
+    [[nodiscard]] std::size_t staged() const noexcept { return staged_.size(); }
+
+    /** @brief Hands every staged request to the workers. @return How many were handed over. */
+    unsigned flush() {
+        unsigned n = static_cast<unsigned>(staged_.size());
+        if (n == 0) return 0;
+        {
+            std::lock_guard lock(mutex_);
+            for (const auto &r : staged_) queue_.push_back(r);
+            in_flight_ += n;
+        }
+        staged_.clear();
+        if (n == 1) work_cv_.notify_one();
+        else work_cv_.notify_all();
+        return n;
+    }
+
+    /**
+     * @brief Waits for at least @p min_complete completions (or until nothing is in flight) and pops them.
+     * @return Number of completions written to @p out.
+     */
+    unsigned wait(std::span<completion_t> out, unsigned min_complete) {
+        std::unique_lock lock(mutex_);
+        done_cv_.wait(lock, [&] { return done_.size() >= min_complete || in_flight_ == 0; });
+        unsigned n = 0;
+        while (!done_.empty() && n < out.size()) {
+            out[n++] = done_.front();
+            done_.pop_front();
+        }
+        return n;
+    }
+
+private:
+    void run() {
+        for (;;) {
+            request_t r;
+            {
+                std::unique_lock lock(mutex_);
+                work_cv_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+                if (stop_ && queue_.empty()) return;
+                r = queue_.front();
+                queue_.pop_front();
+            }
+            ssize_t n;
+            do {
+                n = r.write ? ::pwrite(r.fd, r.data, r.length, static_cast<off_t>(r.offset))
+                            : ::pread(r.fd, r.data, r.length, static_cast<off_t>(r.offset));
+            } while (n < 0 && errno == EINTR);
+            completion_t c{r.user_data, n < 0 ? -errno : static_cast<int32_t>(n), 0};
+            {
+                std::lock_guard lock(mutex_);
+                done_.push_back(c);
+                --in_flight_;
+            }
+            done_cv_.notify_all();
+        }
+    }
+
+    std::vector<request_t> staged_; // caller-owned, no lock
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    std::deque<request_t> queue_;
+    std::deque<completion_t> done_;
+    std::size_t in_flight_ = 0;
+    bool stop_ = false;
+};
+
+} // namespace saburou::platform::v2::io::detail
@@ -0,0 +1,317 @@
+/**
+ * @file direct_reader.hpp
+ * @brief Sequential O_DIRECT reader with filesystem alignment discovery and double buffering.
+ *
+ * @code
+ * auto reader = io::direct_reader::open("column.bin");
+ * while (reader) {
+ *     auto block = reader->next();
+ *     if (!block || block->empty()) break; // error or end of file
+ *     scan(*block);                        // the next block is being read meanwhile
+ * }
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+#include <saburou/platform/v2/io/detail/posix.hpp>
+
+#include <sys/stat.h>
+#endif
+#if SABUROU_PLATFORM_V2_OS_LINUX
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
+
+namespace saburou::platform::v2::io {
+
+/**
+ * @brief Alignment constraints for direct I/O on one file.
+ */
+struct dio_alignment_t {
+    std::size_t memory = 0;        ///< Required buffer address alignment (0 = direct I/O unsupported)
+    std::size_t offset = 0;        ///< Required file offset and length alignment
+    std::size_t logical_block = 0; ///< Logical block size of the backing device, when known
+};
+
+/**
+ * @brief Options for direct_reader::open().
+ */
+struct direct_options_t {
+    std::size_t block_size = std::size_t{1} << 20; ///< Bytes per read; rounded up to the offset alignment
+    bool direct = true;                            ///< Try O_DIRECT first (falls back to buffered reads)
+    bool double_buffer = true;                     ///< Read the next block on a helper thread while the caller works
+};
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+
+/**
+ * @brief Discovers the direct-I/O alignment of an open descriptor.
+ * * Uses statx(STATX_DIOALIGN) (Linux 6.1+) for regular files and BLKSSZGET for block devices. When neither
+ * answers, the conservative 4096/4096 pair is returned, which satisfies every common filesystem.
+ * @return Alignments; memory == 0 when the kernel reports that the file does not support direct I/O.
+ */
+[[nodiscard]] inline dio_alignment_t probe_dio_alignment(int fd) noexcept {
+    dio_alignment_t a{};
+#if SABUROU_PLATFORM_V2_OS_LINUX
+#if defined(STATX_DIOALIGN)
+    struct statx sx{};
+    if (::statx(fd, "", AT_EMPTY_PATH, STATX_DIOALIGN | STATX_TYPE, &sx) == 0 && (sx.stx_mask & STATX_DIOALIGN)) {
+        a.memory = sx.stx_dio_mem_align;
+        a.offset = sx.stx_dio_offset_align;
+        a.logical_block = sx.stx_dio_offset_align;
+        if (!S_ISBLK(sx.stx_mode)) return a;
+    }
+#endif
+    struct stat st{};
+    if (::fstat(fd, &st) == 0 && S_ISBLK(st.st_mode)) {
+        int logical = 0;
+        if (::ioctl(fd, BLKSSZGET, &logical) == 0 && logical > 0) {
+            a.logical_block = static_cast<std::size_t>(logical);
+            if (a.memory == 0) {
+                a.memory = a.logical_block;
+                a.offset = a.logical_block;
+            }
+            return a;
+        }
+    }
+    if (a.memory != 0 || a.offset != 0) return a;
+#else
+    (void)fd;
+#endif
+    a.memory = 4096;
+    a.offset = 4096;
+    return a;
+}
+
+/**
+ * @brief Sequential block reader that bypasses the page cache when the filesystem allows it.
+ * * Files are opened with O_DIRECT into buffers aligned per probe_dio_alignment(). If O_DIRECT is refused
+ * (tmpfs, some FUSE and network filesystems) the reader reopens the file buffered and sets
+ * POSIX_FADV_SEQUENTIAL instead. With double buffering, a helper thread fills one buffer while the
+ * caller processes the other, so I/O latency overlaps with computation.
+ */
+class direct_reader {
+public:
+    direct_reader() = default;
+    direct_reader(direct_reader &&) noexcept = default;
+    direct_reader &operator=(direct_reader &&) noexcept = default;
+    ~direct_reader() = default;
+
+    /**
+     * @brief Opens a file for sequential block reads.
+     * @return The reader, or the errno of the failing open/fstat/allocation.
+     */
+    [[nodiscard]] static std::expected<direct_reader, std::error_code> open(const std::string &path,
+                                                                           const direct_options_t &options = {}) {
+        auto s = std::make_unique<state_t>();
+        int fd = -1;
+#if SABUROU_PLATFORM_V2_OS_LINUX
+        if (options.direct) {
+            fd = posix::open_retry(path.c_str(), O_RDONLY | O_DIRECT);
+            if (fd >= 0) {
+                s->fd.reset(fd);
+                s->align = probe_dio_alignment(fd);
+                s->direct = s->align.memory != 0;
+                if (!s->direct) s->fd.reset();
+            }
+        }
+#endif
+        if (!s->fd) {
+            fd = posix::open_retry(path.c_str(), O_RDONLY);
+            if (fd < 0) return std::unexpected(posix::last_error());
+            s->fd.reset(fd);
+            s->direct = false;
+            s->align = {posix::page_size(), 1, 0};
+#if SABUROU_PLATFORM_V2_OS_LINUX
+            (void)::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#elif SABUROU_PLATFORM_V2_OS_DARWIN
+            (void)::fcntl(fd, F_RDAHEAD, 1); // Darwin has no posix_fadvise
+#endif
+        }
+
+        struct stat st{};
+        if (::fstat(s->fd.get(), &st) != 0) return std::unexpected(posix::last_error());
+        s->file_size = static_cast<uint64_t>(st.st_size);
+
+        std::size_t block = options.block_size ? options.block_size : direct_options_t{}.block_size;
+        s->block_size = posix::align_up(block, s->align.offset > 1 ? s->align.offset : 1);
+        std::size_t slots = options.double_buffer ? 2 : 1;
+        for (std::size_t i = 0; i < slots; ++i) {
+            if (auto ec = s->slots[i].allocate(s->block_size, s->align.memory)) return std::unexpected(ec);
+        }
+
+        direct_reader reader;
+        reader.state_ = std::move(s);
+        if (options.double_buffer) reader.state_->start();
+        return reader;
+    }
+
+    /** @brief True if the file is open. */
+    [[nodiscard]] explicit operator bool() const noexcept { return state_ && state_->fd; }
+
+    /** @brief True if reads bypass the page cache. */
+    [[nodiscard]] bool is_direct() const noexcept { return state_ && state_->direct.load(std::memory_order_relaxed); }
+
+    /** @brief Alignment in effect (page/1 for buffered fallback). */
+    [[nodiscard]] dio_alignment_t alignment() const noexcept { return state_ ? state_->align : dio_alignment_t{}; }
+
+    /** @brief Bytes returned by each full block. */
+    [[nodiscard]] std::size_t block_size() const noexcept { return state_ ? state_->block_size : 0; }
+
+    /** @brief File size at open time. */
+    [[nodiscard]] uint64_t file_size() const noexcept { return state_ ? state_->file_size : 0; }
+
+    /**
+     * @brief Returns the next block of the file.
+     * @return A view valid until the following next() call; empty at end of file; the errno of a failed
+     * read otherwise.
+     */
+    [[nodiscard]] std::expected<std::span<const std::byte>, std::error_code> next() {
+        if (!state_ || !state_->fd) return std::unexpected(std::make_error_code(std::errc::bad_file_descriptor));
+        return state_->worker.joinable() ? state_->take() : state_->read_sync();
+    }
+
+private:
+    struct aligned_free {
+        void operator()(std::byte *p) const noexcept { std::free(p); }
+    };
+
+    struct slot_t {
+        std::unique_ptr<std::byte, aligned_free> data;
+        std::size_t length = 0; // bytes filled
+        int error = 0;          // errno of the read that filled it
+        bool ready = false;     // filled and not yet handed to the caller
+
+        std::error_code allocate(std::size_t size, std::size_t align) {
+            void *p = std::aligned_alloc(align, posix::align_up(size, align));
+            if (!p) return std::make_error_code(std::errc::not_enough_memory);
+            data.reset(static_cast<std::byte *>(p));
+            return {};
+        }
+    };
+
+    struct state_t {
+        posix::unique_fd fd;
+        dio_alignment_t align{};
+        std::atomic<bool> direct = false; // cleared by fill() on the worker, read by is_direct() on the caller
+        uint64_t file_size = 0;
+        std::size_t block_size = 0;
+        uint64_t offset = 0; // next file offset to read (worker-owned once started)
+        slot_t slots[2];
+
+        std::thread worker;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t consumer = 0; // slot the caller reads next
+        bool held = false;        // caller still holds slots[consumer ^ 1] from the previous next()
+        bool stop = false;
+
+        ~state_t() {
+            if (worker.joinable()) {
+                {
+                    std::lock_guard lock(mutex);
+                    stop = true;
+                }
+                cv.notify_all();
+                worker.join();
+            }
+        }
+
+        // Reads one block at the current offset into a slot. Short reads only happen at end of file.
+        void fill(slot_t &slot) {
+            std::size_t total = 0;
+            slot.error = 0;
+            while (total < block_size) {
+                ssize_t n = ::pread(fd.get(), slot.data.get() + total, block_size - total,
+                                    static_cast<off_t>(offset + total));
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+#if SABUROU_PLATFORM_V2_OS_LINUX
+                    // Some filesystems accept O_DIRECT at open() and reject it at read(): drop the flag and retry.
+                    if (errno == EINVAL && direct &&
+                        ::fcntl(fd.get(), F_SETFL, ::fcntl(fd.get(), F_GETFL) & ~O_DIRECT) == 0) {
+                        direct.store(false, std::memory_order_relaxed);
+                        continue;
+                    }
+#endif
+                    slot.error = errno;
+                    break;
+                }
+                if (n == 0) break;
+                total += static_cast<std::size_t>(n);
+                // O_DIRECT cannot resume at an unaligned offset: a partial read must be the tail.
+                if (direct && total % align.offset != 0) break;
+            }
+            slot.length = total;
+            offset += total;
+        }
+
+        std::expected<std::span<const std::byte>, std::error_code> read_sync() {
+            fill(slots[0]);
+            if (slots[0].error) return std::unexpected(std::error_code(slots[0].error, std::generic_category()));
+            return std::span<const std::byte>(slots[0].data.get(), slots[0].length);
+        }
+
+        void start() {
+            worker = std::thread([this] {
+                std::size_t producer = 0;
+                for (;;) {
+                    {
+                        std::unique_lock lock(mutex);
+                        cv.wait(lock, [&] { return stop || !slots[producer].ready; });
+                        if (stop) return;
+                    }
+                    fill(slots[producer]);
+                    bool done = slots[producer].error != 0 || slots[producer].length == 0;
+                    {
+                        std::lock_guard lock(mutex);
+                        slots[producer].ready = true;
+                    }
+                    cv.notify_all();
+                    if (done) return; // EOF or error: the caller keeps receiving this slot
+                    producer ^= 1;
+                }
+            });
+        }
+
+        std::expected<std::span<const std::byte>, std::error_code> take() {
+            std::unique_lock lock(mutex);
+            if (held) {
+                // Hand the previously returned buffer back to the worker.
+                slots[consumer ^ 1].ready = false;
+                held = false;
+                cv.notify_all();
+            }
+            cv.wait(lock, [&] { return slots[consumer].ready; });
+            slot_t &slot = slots[consumer];
+            if (slot.error) return std::unexpected(std::error_code(slot.error, std::generic_category()));
+            if (slot.length == 0) return std::span<const std::byte>{}; // sticky end of file
+            held = true;
+            consumer ^= 1;
+            return std::span<const std::byte>(slot.data.get(), slot.length);
+        }
+    };
+
+    std::unique_ptr<state_t> state_;
+};
+
+#endif // SABUROU_PLATFORM_V2_POSIX_LIKE
+
+} // namespace saburou::platform::v2::io
@@ -0,0 +1,257 @@
+/**
+ * @file mapped_file.hpp
+ * @brief RAII memory-mapped files with access-pattern hints, prefaulting and page locking.
+ *
+ * @code
+ * auto file = io::mapped_file::open("index.bin", {.advice = io::advice_t::sequential});
+ * if (file) uint32_t magic = file->load_big<uint32_t>(0);
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/bytes/endian.hpp>
+#include <saburou/platform/v2/detect.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+#include <saburou/platform/v2/io/detail/posix.hpp>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace saburou::platform::v2::io {
+
+/**
+ * @brief Whether a mapping can be written through.
+ */
+enum class access_t : uint8_t {
+    read_only, // PROT_READ, file opened O_RDONLY
+    read_write // PROT_READ | PROT_WRITE, MAP_SHARED: stores reach the file
+};
+
+/**
+ * @brief Expected access pattern, forwarded to madvise().
+ */
+enum class advice_t : uint8_t {
+    normal,     // MADV_NORMAL: default readahead
+    sequential, // MADV_SEQUENTIAL: aggressive readahead, pages dropped soon after use
+    random,     // MADV_RANDOM: no readahead
+    willneed,   // MADV_WILLNEED: start reading the range in the background now
+    dontneed,   // MADV_DONTNEED: drop the pages (re-read from the file on next access)
+    hugepage    // MADV_HUGEPAGE: back with transparent huge pages where the filesystem allows it
+};
+
+/**
+ * @brief Options for mapped_file::open().
+ */
+struct map_options_t {
+    access_t access = access_t::read_only; ///< Protection and open mode
+    advice_t advice = advice_t::normal;    ///< Hint applied to the whole mapping after mmap()
+    bool populate = false;                 ///< MAP_POPULATE: prefault every page during mmap() (Linux)
+    bool lock = false;                     ///< mlock() the whole mapping (subject to RLIMIT_MEMLOCK)
+};
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+
+/**
+ * @brief Move-only owner of a whole-file memory mapping.
+ * * The descriptor is closed right after mmap(); the mapping keeps the file alive. Empty files map to an
+ * empty span (mmap() rejects zero-length mappings).
+ */
+class mapped_file {
+public:
+    mapped_file() = default;
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    mapped_file(mapped_file &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+          access_(other.access_) {}
+
+    mapped_file &operator=(mapped_file &&other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            access_ = other.access_;
+        }
+        return *this;
+    }
+
+    ~mapped_file() { close(); }
+
+    /**
+     * @brief Maps an existing file in full.
+     * @param path File to map.
+     * @param options Access mode, initial advice, prefaulting and locking.
+     * @return The mapping, or the errno of the failing open/fstat/mmap/mlock call.
+     * @note A failing madvise() is ignored: hints are best-effort.
+     */
+    [[nodiscard]] static std::expected<mapped_file, std::error_code> open(const std::string &path,
+                                                                         const map_options_t &options = {}) {
+        bool writable = options.access == access_t::read_write;
+        posix::unique_fd fd(posix::open_retry(path.c_str(), writable ? O_RDWR : O_RDONLY));
+        if (!fd) return std::unexpected(posix::last_error());
+
+        struct stat st{};
+        if (::fstat(fd.get(), &st) != 0) return std::unexpected(posix::last_error());
+        return map(fd.get(), static_cast<std::size_t>(st.st_size), options);
+    }
+
+    /**
+     * @brief Creates (or truncates) a file of @p size bytes and maps it read-write.
+     * @param path File to create.
+     * @param size Length of the new file.
+     * @param options Advice, prefaulting and locking; access is forced to read_write.
+     */
+    [[nodiscard]] static std::expected<mapped_file, std::error_code> create(const std::string &path, std::size_t size,
+                                                                           map_options_t options = {}) {
+        options.access = access_t::read_write;
+        posix::unique_fd fd(posix::open_retry(path.c_str(), O_RDWR | O_CREAT | O_TRUNC));
+        if (!fd) return std::unexpected(posix::last_error());
+        if (::ftruncate(fd.get(), static_cast<off_t>(size)) != 0) return std::unexpected(posix::last_error());
+        return map(fd.get(), size, options);
+    }
+
+    /** @brief True if a non-empty file is mapped. */
+    [[nodiscard]] bool is_open() const noexcept { return data_ != nullptr; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] bool is_writable() const noexcept { return access_ == access_t::read_write; }
+
+    /** @brief The whole mapping. */
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return {data_, size_}; }
+
+    /** @brief A clamped sub-range; out-of-range requests yield a shorter (possibly empty) span. */
+    [[nodiscard]] std::span<const std::byte> bytes(std::size_t offset,
+                                                   std::size_t count = std::dynamic_extent) const noexcept {
+        if (offset >= size_) return {};
+        return {data_ + offset, count < size_ - offset ? count : size_ - offset};
+    }
+
+    /** @brief Writable view; empty for read-only mappings. */
+    [[nodiscard]] std::span<std::byte> writable_bytes() noexcept {
+        return is_writable() ? std::span<std::byte>{data_, size_} : std::span<std::byte>{};
+    }
+
+    /**
+     * @brief Loads a big-endian value at @p offset (unaligned access is fine).
+     * @pre offset + sizeof(T) <= size().
+     */
+    template <bytes::ByteSwappable T> [[nodiscard]] T load_big(std::size_t offset) const noexcept {
+        return bytes::endian::from_big(load<T>(offset));
+    }
+
+    /** @brief Loads a little-endian value at @p offset. @pre offset + sizeof(T) <= size(). */
+    template <bytes::ByteSwappable T> [[nodiscard]] T load_little(std::size_t offset) const noexcept {
+        return bytes::endian::from_little(load<T>(offset));
+    }
+
+    /**
+     * @brief Applies an access-pattern hint to a range (the whole file by default).
+     * @note The range is widened to page boundaries, as madvise() requires.
+     */
+    std::error_code advise(advice_t advice, std::size_t offset = 0, std::size_t length = std::dynamic_extent) noexcept {
+        int native = to_native(advice);
+        if (native < 0) return std::make_error_code(std::errc::not_supported);
+        return page_op(offset, length, [native](void *p, std::size_t n) { return ::madvise(p, n, native); });
+    }
+
+    /**
+     * @brief Locks a range in RAM so latency-critical lookups never page-fault.
+     * @note Needs CAP_IPC_LOCK or a sufficient RLIMIT_MEMLOCK.
+     */
+    std::error_code lock(std::size_t offset = 0, std::size_t length = std::dynamic_extent) noexcept {
+        return page_op(offset, length, [](void *p, std::size_t n) { return ::mlock(p, n); });
+    }
+
+    /** @brief Undoes lock() on a range. */
+    std::error_code unlock(std::size_t offset = 0, std::size_t length = std::dynamic_extent) noexcept {
+        return page_op(offset, length, [](void *p, std::size_t n) { return ::munlock(p, n); });
+    }
+
+    /**
+     * @brief Flushes dirty pages of a read-write mapping to the file.
+     * @param wait MS_SYNC when true, MS_ASYNC (schedule only) otherwise.
+     */
+    std::error_code sync(bool wait = true) noexcept {
+        if (!data_) return {};
+        return ::msync(data_, size_, wait ? MS_SYNC : MS_ASYNC) == 0 ? std::error_code{} : posix::last_error();
+    }
+
+    /** @brief Unmaps the file. Safe to call more than once. */
+    void close() noexcept {
+        if (data_) ::munmap(data_, size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+private:
+    mapped_file(std::byte *data, std::size_t size, access_t access) noexcept
+        : data_(data), size_(size), access_(access) {}
+
+    static std::expected<mapped_file, std::error_code> map(int fd, std::size_t size, const map_options_t &options) {
+        if (size == 0) return mapped_file(nullptr, 0, options.access);
+
+        bool writable = options.access == access_t::read_write;
+        int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+        if (options.populate) flags |= MAP_POPULATE;
+#endif
+        void *p = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, flags, fd, 0);
+        if (p == MAP_FAILED) return std::unexpected(posix::last_error());
+
+        mapped_file file(static_cast<std::byte *>(p), size, options.access);
+        if (options.advice != advice_t::normal) (void)file.advise(options.advice);
+        if (options.lock) {
+            if (auto ec = file.lock()) return std::unexpected(ec);
+        }
+        return file;
+    }
+
+    template <class T> [[nodiscard]] T load(std::size_t offset) const noexcept {
+        T value;
+        std::memcpy(&value, data_ + offset, sizeof(T));
+        return value;
+    }
+
+    [[nodiscard]] static int to_native(advice_t advice) noexcept {
+        switch (advice) {
+        case advice_t::normal:     return MADV_NORMAL;
+        case advice_t::sequential: return MADV_SEQUENTIAL;
+        case advice_t::random:     return MADV_RANDOM;
+        case advice_t::willneed:   return MADV_WILLNEED;
+        case advice_t::dontneed:   return MADV_DONTNEED;
+#if defined(MADV_HUGEPAGE)
+        case advice_t::hugepage:   return MADV_HUGEPAGE;
+#endif
+        default:                   return -1;
+        }
+    }
+
+    template <class F> std::error_code page_op(std::size_t offset, std::size_t length, F &&op) noexcept {
+        if (!data_ || offset >= size_) return {};
+        std::size_t end = length < size_ - offset ? offset + length : size_;
+        std::size_t begin = posix::align_down(offset, posix::page_size());
+        return op(data_ + begin, end - begin) == 0 ? std::error_code{} : posix::last_error();
+    }
+
+    std::byte *data_ = nullptr;
+    std::size_t size_ = 0;
+    access_t access_ = access_t::read_only;
+};
+
+#endif // SABUROU_PLATFORM_V2_POSIX_LIKE
+
+} // namespace saburou::platform::v2::io
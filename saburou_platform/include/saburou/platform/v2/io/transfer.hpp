@@ -0,0 +1,287 @@
+/**
+ * @file transfer.hpp
+ * @brief Zero-copy file-to-file and file-to-socket transfers with a buffered fallback.
+ *
+ * @code
+ * auto r = io::transfer(blob_fd, socket_fd);  // splice through a pipe, no user-space copy
+ * if (r.error) log(r.error.message());
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <system_error>
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+#include <saburou/platform/v2/io/detail/posix.hpp>
+
+#include <memory>
+
+#include <sys/stat.h>
+#endif
+#if SABUROU_PLATFORM_V2_OS_LINUX
+#include <saburou/platform/v2/os/linux/kernel/query.hpp>
+
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
+
+namespace saburou::platform::v2::io {
+
+/**
+ * @brief Mechanism used (or last tried) by transfer().
+ */
+enum class transfer_method_t : uint8_t {
+    none,            // Nothing attempted (zero-length request)
+    copy_file_range, // In-kernel file-to-file copy; may reflink or offload to the device (Linux 4.5+)
+    splice,          // Page moves through an intermediate pipe; any destination type (Linux)
+    sendfile,        // File pages to any descriptor (Linux)
+    read_write       // pread/write through a user-space buffer
+};
+
+/**
+ * @brief Options for transfer().
+ */
+struct transfer_options_t {
+    std::size_t chunk_size = std::size_t{256} << 10; ///< Bytes per syscall (also the pipe size for splice)
+    bool zero_copy = true;                           ///< Set to false to force the read/write loop
+};
+
+/**
+ * @brief Outcome of transfer().
+ */
+struct transfer_result_t {
+    uint64_t bytes = 0;                                  ///< Bytes written to the destination
+    transfer_method_t method = transfer_method_t::none;  ///< Path that moved the data
+    std::error_code error;                               ///< First unrecoverable error, if any
+};
+
+/**
+ * @brief Converts a transfer_method_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(transfer_method_t m) {
+    switch (m) {
+    case transfer_method_t::none:            return "none";
+    case transfer_method_t::copy_file_range: return "copy_file_range";
+    case transfer_method_t::splice:          return "splice";
+    case transfer_method_t::sendfile:        return "sendfile";
+    case transfer_method_t::read_write:      return "read_write";
+    default:                                 return "unknown";
+    }
+}
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+
+namespace detail {
+
+/** @brief Per-step result: bytes moved, or a negated errno. */
+using step_fn = long (*)(int in, int out, uint64_t &offset, std::size_t count, void *ctx) noexcept;
+
+/**
+ * @brief True if @p err means "this mechanism cannot handle these descriptors", so the next one may.
+ * * EBADF and EPERM are not in the list: a bad descriptor or a forbidden write fails every mechanism alike.
+ */
+[[nodiscard]] constexpr bool is_unsupported(int err) noexcept {
+    return err == EINVAL || err == ENOSYS || err == EXDEV || err == EOPNOTSUPP || err == ENOTSUP || err == ESPIPE;
+}
+
+/**
+ * @brief Drives one mechanism until @p remaining is exhausted or the source hits end of file.
+ * @return 0 on success, the errno otherwise; @p done counts the bytes moved.
+ */
+inline int pump(step_fn step, void *ctx, int in, int out, uint64_t &offset, uint64_t remaining, std::size_t chunk,
+                uint64_t &done) noexcept {
+    while (remaining > 0) {
+        std::size_t count = remaining < chunk ? static_cast<std::size_t>(remaining) : chunk;
+        long n = step(in, out, offset, count, ctx);
+        if (n < 0) {
+            if (-n == EINTR) continue;
+            return static_cast<int>(-n);
+        }
+        if (n == 0) break; // end of file
+        done += static_cast<uint64_t>(n);
+        remaining -= static_cast<uint64_t>(n);
+    }
+    return 0;
+}
+
+/** @brief pread (read for pipes and sockets) into a buffer, then write all of it (handles short writes). */
+inline long step_read_write(int in, int out, uint64_t &offset, std::size_t count, void *ctx) noexcept {
+    auto *buffer = static_cast<std::byte *>(ctx);
+    ssize_t n = ::pread(in, buffer, count, static_cast<off_t>(offset));
+    if (n < 0 && errno == ESPIPE) n = ::read(in, buffer, count);
+    if (n <= 0) return n < 0 ? -errno : 0;
+    std::size_t written = 0;
+    while (written < static_cast<std::size_t>(n)) {
+        ssize_t w = ::write(out, buffer + written, static_cast<std::size_t>(n) - written);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            // Bytes already written count; report the error on the next call.
+            if (written == 0) return -errno;
+            break;
+        }
+        written += static_cast<std::size_t>(w);
+    }
+    offset += written;
+    return static_cast<long>(written);
+}
+
+#if SABUROU_PLATFORM_V2_OS_LINUX
+
+inline long step_copy_file_range(int in, int out, uint64_t &offset, std::size_t count, void *) noexcept {
+    auto off = static_cast<loff_t>(offset);
+    long n = ::syscall(__NR_copy_file_range, in, &off, out, nullptr, count, 0u);
+    if (n < 0) return -errno;
+    offset = static_cast<uint64_t>(off);
+    return n;
+}
+
+inline long step_sendfile(int in, int out, uint64_t &offset, std::size_t count, void *) noexcept {
+    auto off = static_cast<off_t>(offset);
+    ssize_t n = ::sendfile(out, in, &off, count);
+    if (n < 0) return -errno;
+    offset = static_cast<uint64_t>(off);
+    return n;
+}
+
+/** @brief Pipe pair used as the in-kernel buffer of splice(). */
+struct splice_pipe_t {
+    posix::unique_fd read_end;
+    posix::unique_fd write_end;
+    std::size_t buffered = 0; // bytes sitting in the pipe (left over by a failed drain)
+};
+
+/**
+ * @brief Splices up to @p count bytes into the pipe, then from the pipe to @p out.
+ * * If the drain fails before moving anything, the bytes still in the pipe are dropped and @p offset goes
+ * back by as many, so whatever runs next (another mechanism, or the caller resuming at in_offset + bytes)
+ * reads them again from the source.
+ */
+inline long step_splice(int in, int out, uint64_t &offset, std::size_t count, void *ctx) noexcept {
+    auto &pipe = *static_cast<splice_pipe_t *>(ctx);
+    if (pipe.buffered == 0) {
+        auto off = static_cast<loff_t>(offset);
+        ssize_t n = ::splice(in, &off, pipe.write_end.get(), nullptr, count, SPLICE_F_MOVE | SPLICE_F_MORE);
+        if (n <= 0) return n < 0 ? -errno : 0;
+        offset = static_cast<uint64_t>(off);
+        pipe.buffered = static_cast<std::size_t>(n);
+    }
+    std::size_t moved = 0;
+    while (pipe.buffered > 0) {
+        ssize_t n = ::splice(pipe.read_end.get(), nullptr, out, nullptr, pipe.buffered, SPLICE_F_MOVE | SPLICE_F_MORE);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (moved == 0) {
+                int err = errno;
+                offset -= pipe.buffered;
+                pipe.buffered = 0;
+                return -err;
+            }
+            break;
+        }
+        pipe.buffered -= static_cast<std::size_t>(n);
+        moved += static_cast<std::size_t>(n);
+    }
+    return static_cast<long>(moved);
+}
+
+#endif // SABUROU_PLATFORM_V2_OS_LINUX
+
+} // namespace detail
+
+/**
+ * @brief Copies up to @p count bytes from @p in (starting at @p in_offset) to @p out.
+ * * Mechanisms are tried in order and each is skipped when it cannot apply:
+ * 1. copy_file_range: both regular files, @p out not O_APPEND, and the cached kernel probe reports it usable.
+ * 2. splice through a private pipe: any destination (socket, pipe, file).
+ * 3. sendfile: source must support mmap-style reads.
+ * 4. pread/write loop with a chunk_size buffer.
+ * A mechanism that fails with EINVAL/EXDEV/EOPNOTSUPP/... before moving any byte hands over to the next one.
+ * @param in Source descriptor; files are read positionally (their offset is not changed), pipes and
+ * sockets are only supported by the read/write loop.
+ * @param out Destination; written at its current position (sockets and pipes have none).
+ * Non-blocking destinations stop the transfer with EAGAIN: resume at in_offset + bytes.
+ * @param count Maximum bytes; the default copies until end of file.
+ * @param in_offset Start position in the source.
+ * @return Bytes moved, the mechanism that moved them and the first hard error.
+ */
+inline transfer_result_t transfer(int in, int out, uint64_t count = std::numeric_limits<uint64_t>::max(),
+                                  uint64_t in_offset = 0, const transfer_options_t &options = {}) {
+    transfer_result_t result{};
+    if (count == 0) return result;
+    std::size_t chunk = options.chunk_size ? options.chunk_size : transfer_options_t{}.chunk_size;
+    uint64_t offset = in_offset;
+
+    auto attempt = [&](transfer_method_t method, detail::step_fn step, void *ctx) {
+        result.method = method;
+        uint64_t done = 0;
+        int err = detail::pump(step, ctx, in, out, offset, count - result.bytes, chunk, done);
+        result.bytes += done;
+        if (err == 0) return true;
+        if (done == 0 && result.bytes == 0 && detail::is_unsupported(err)) return false; // try the next one
+        result.error = std::error_code(err, std::generic_category());
+        return true;
+    };
+
+#if SABUROU_PLATFORM_V2_OS_LINUX
+    if (options.zero_copy) {
+        struct stat in_st{}, out_st{};
+        bool in_regular = ::fstat(in, &in_st) == 0 && S_ISREG(in_st.st_mode);
+        bool out_regular = ::fstat(out, &out_st) == 0 && S_ISREG(out_st.st_mode);
+        // copy_file_range rejects O_APPEND destinations with EBADF, which must stay a hard error otherwise.
+        int out_flags = ::fcntl(out, F_GETFL);
+        bool out_append = out_flags != -1 && (out_flags & O_APPEND);
+
+        if (in_regular && out_regular && !out_append &&
+            os::linux::kernel_features().copy_file_range == os::linux::support_t::supported &&
+            attempt(transfer_method_t::copy_file_range, detail::step_copy_file_range, nullptr))
+            return result;
+
+        int fds[2];
+        if (::pipe2(fds, O_CLOEXEC) == 0) {
+            detail::splice_pipe_t pipe{posix::unique_fd(fds[0]), posix::unique_fd(fds[1])};
+            // A pipe holding a whole chunk lets each splice pair move chunk_size bytes.
+            (void)::fcntl(pipe.write_end.get(), F_SETPIPE_SZ, static_cast<int>(chunk));
+            if (attempt(transfer_method_t::splice, detail::step_splice, &pipe)) return result;
+        }
+
+        if (attempt(transfer_method_t::sendfile, detail::step_sendfile, nullptr)) return result;
+    }
+#endif
+
+    auto buffer = std::make_unique_for_overwrite<std::byte[]>(chunk);
+    if (!attempt(transfer_method_t::read_write, detail::step_read_write, buffer.get()))
+        result.error = std::make_error_code(std::errc::not_supported);
+    return result;
+}
+
+#endif // SABUROU_PLATFORM_V2_POSIX_LIKE
+
+} // namespace saburou::platform::v2::io
+
+/**
+ * @brief std::formatter specialization for transfer_method_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "transfer_method_t::splice").
+ */
+template <> struct std::formatter<saburou::platform::v2::io::transfer_method_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::io::transfer_method_t &m, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::io::to_code_name(m);
+        return repr ? std::format_to(ctx.out(), "transfer_method_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
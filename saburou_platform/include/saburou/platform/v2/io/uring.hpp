@@ -0,0 +1,378 @@
+/**
+ * @file uring.hpp
+ * @brief Minimal io_uring ring on raw syscalls (no liburing dependency).
+ *
+ * @code
+ * auto ring = io::uring::create(64);
+ * ring->prep_read(fd, buffer, 0, 1);
+ * io::completion_t done[1];
+ * auto n = ring->submit_and_wait(done);  // done[0].user_data == 1, done[0].result == bytes read
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <system_error>
+
+#if SABUROU_PLATFORM_V2_OS_LINUX
+#include <saburou/platform/v2/io/detail/posix.hpp>
+#include <saburou/platform/v2/os/linux/kernel/detail/probe.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <utility>
+
+#include <sys/mman.h>
+#include <sys/uio.h>
+
+#if !defined(__alpha__) && !defined(__NR_io_uring_enter)
+#define __NR_io_uring_enter 426
+#endif
+#endif
+
+namespace saburou::platform::v2::io {
+
+/**
+ * @brief One finished request.
+ */
+struct completion_t {
+    uint64_t user_data = 0; ///< Tag passed when the request was queued
+    int32_t result = 0;     ///< Bytes transferred (>= 0) or a negated errno
+    uint32_t flags = 0;     ///< IORING_CQE_F_* bits (0 for the thread-pool backend)
+};
+
+/**
+ * @brief Index of a descriptor registered with uring::register_files().
+ */
+struct registered_file_t {
+    unsigned index = 0; ///< Position in the registered table
+};
+
+#if SABUROU_PLATFORM_V2_OS_LINUX && SABUROU_PLATFORM_V2_HAS_IO_URING_UAPI
+
+namespace detail {
+// Opcodes and flags newer than the 5.4 uapi headers (see kernel/detail/probe.hpp).
+namespace uring_abi = os::linux::detail::uring_abi;
+} // namespace detail
+
+/**
+ * @brief Move-only io_uring instance with submission batching.
+ * * prep_*() calls only fill SQEs in shared memory; nothing reaches the kernel until submit(), so any
+ * number of requests (up to the ring size) cost a single io_uring_enter. Completions are reaped from the
+ * shared CQ ring without a syscall whenever they are already available.
+ * @note Not thread-safe: use one ring per thread, as the kernel design intends.
+ */
+class uring {
+public:
+    uring() = default;
+
+    uring(const uring &) = delete;
+    uring &operator=(const uring &) = delete;
+
+    uring(uring &&other) noexcept { swap(other); }
+    uring &operator=(uring &&other) noexcept {
+        if (this != &other) {
+            uring tmp(std::move(other));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~uring() { close(); }
+
+    /**
+     * @brief Creates a ring.
+     * @param entries Requested SQ size (rounded up to a power of two and clamped by the kernel).
+     * @return The ring, or the errno of io_uring_setup/mmap (ENOSYS on kernels before 5.1).
+     * @note Callers that want a silent fallback should check os::linux::kernel_features() first, as
+     * io::async_engine does.
+     */
+    [[nodiscard]] static std::expected<uring, std::error_code> create(unsigned entries = 256) {
+        uring ring;
+        io_uring_params params{};
+        params.flags = detail::uring_abi::setup_clamp;
+        long fd = ::syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0 && errno == EINVAL) { // kernels before 5.6 reject IORING_SETUP_CLAMP
+            params = {};
+            fd = ::syscall(__NR_io_uring_setup, entries, &params);
+        }
+        if (fd < 0) return std::unexpected(posix::last_error());
+        ring.fd_.reset(static_cast<int>(fd));
+        ring.features_ = params.features;
+
+        ring.sq_map_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring.cq_map_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single && ring.cq_map_size_ > ring.sq_map_size_) ring.sq_map_size_ = ring.cq_map_size_;
+
+        ring.sq_map_ = map(ring.fd_.get(), ring.sq_map_size_, IORING_OFF_SQ_RING);
+        if (!ring.sq_map_) return std::unexpected(posix::last_error());
+        ring.cq_map_ = single ? ring.sq_map_ : map(ring.fd_.get(), ring.cq_map_size_, IORING_OFF_CQ_RING);
+        if (!ring.cq_map_) return std::unexpected(posix::last_error());
+        ring.sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        ring.sqes_ = static_cast<io_uring_sqe *>(map(ring.fd_.get(), ring.sqes_size_, IORING_OFF_SQES));
+        if (!ring.sqes_) return std::unexpected(posix::last_error());
+
+        auto *sq = static_cast<std::byte *>(ring.sq_map_);
+        ring.sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        ring.sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        ring.sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        ring.sq_entries_ = params.sq_entries;
+        // SQE slots are used in ring order, so the indirection array is the identity and set up once.
+        auto *array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        for (unsigned i = 0; i < params.sq_entries; ++i) array[i] = i;
+
+        auto *cq = static_cast<std::byte *>(ring.cq_map_);
+        ring.cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        ring.cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        ring.cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        ring.cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+        ring.local_tail_ = *ring.sq_tail_;
+        return ring;
+    }
+
+    /** @brief True if the ring is set up. */
+    [[nodiscard]] explicit operator bool() const noexcept { return static_cast<bool>(fd_); }
+
+    /** @brief Ring descriptor. */
+    [[nodiscard]] int fd() const noexcept { return fd_.get(); }
+
+    /** @brief IORING_FEAT_* bits reported by the kernel. */
+    [[nodiscard]] uint32_t features() const noexcept { return features_; }
+
+    /** @brief Number of SQ slots. */
+    [[nodiscard]] unsigned capacity() const noexcept { return sq_entries_; }
+
+    /** @brief Requests queued with prep_*() that the kernel has not consumed yet (including unsubmitted ones). */
+    [[nodiscard]] unsigned pending() const noexcept {
+        return local_tail_ - std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+    }
+
+    /** @brief Free SQ slots. */
+    [[nodiscard]] unsigned space_left() const noexcept {
+        return sq_entries_ - (local_tail_ - std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Queues a read of @p buffer.size() bytes at @p offset.
+     * @return False if the SQ is full (submit() and retry).
+     */
+    bool prep_read(int fd, std::span<std::byte> buffer, uint64_t offset, uint64_t user_data) noexcept {
+        return prep(detail::uring_abi::op_read, fd, 0, buffer.data(), buffer.size(), offset, user_data);
+    }
+    bool prep_read(registered_file_t file, std::span<std::byte> buffer, uint64_t offset,
+                   uint64_t user_data) noexcept {
+        return prep(detail::uring_abi::op_read, static_cast<int>(file.index), IOSQE_FIXED_FILE, buffer.data(),
+                    buffer.size(), offset, user_data);
+    }
+
+    /** @brief Queues a write of @p buffer at @p offset. */
+    bool prep_write(int fd, std::span<const std::byte> buffer, uint64_t offset, uint64_t user_data) noexcept {
+        return prep(detail::uring_abi::op_write, fd, 0, buffer.data(), buffer.size(), offset, user_data);
+    }
+    bool prep_write(registered_file_t file, std::span<const std::byte> buffer, uint64_t offset,
+                    uint64_t user_data) noexcept {
+        return prep(detail::uring_abi::op_write, static_cast<int>(file.index), IOSQE_FIXED_FILE, buffer.data(),
+                    buffer.size(), offset, user_data);
+    }
+
+    /**
+     * @brief Queues a read into (part of) registered buffer @p buffer_index.
+     * * Registered buffers are pinned once at registration, saving the per-request page walk.
+     * @param buffer Must lie inside the registered buffer.
+     */
+    bool prep_read_fixed(int fd, std::span<std::byte> buffer, uint64_t offset, uint16_t buffer_index,
+                         uint64_t user_data) noexcept {
+        if (!prep(IORING_OP_READ_FIXED, fd, 0, buffer.data(), buffer.size(), offset, user_data)) return false;
+        sqes_[(local_tail_ - 1) & sq_mask_].buf_index = buffer_index;
+        return true;
+    }
+    bool prep_read_fixed(registered_file_t file, std::span<std::byte> buffer, uint64_t offset,
+                         uint16_t buffer_index, uint64_t user_data) noexcept {
+        if (!prep(IORING_OP_READ_FIXED, static_cast<int>(file.index), IOSQE_FIXED_FILE, buffer.data(), buffer.size(),
+                  offset, user_data))
+            return false;
+        sqes_[(local_tail_ - 1) & sq_mask_].buf_index = buffer_index;
+        return true;
+    }
+
+    /** @brief Queues a write from (part of) registered buffer @p buffer_index. */
+    bool prep_write_fixed(int fd, std::span<const std::byte> buffer, uint64_t offset, uint16_t buffer_index,
+                          uint64_t user_data) noexcept {
+        if (!prep(IORING_OP_WRITE_FIXED, fd, 0, buffer.data(), buffer.size(), offset, user_data)) return false;
+        sqes_[(local_tail_ - 1) & sq_mask_].buf_index = buffer_index;
+        return true;
+    }
+    bool prep_write_fixed(registered_file_t file, std::span<const std::byte> buffer, uint64_t offset,
+                          uint16_t buffer_index, uint64_t user_data) noexcept {
+        if (!prep(IORING_OP_WRITE_FIXED, static_cast<int>(file.index), IOSQE_FIXED_FILE, buffer.data(),
+                  buffer.size(), offset, user_data))
+            return false;
+        sqes_[(local_tail_ - 1) & sq_mask_].buf_index = buffer_index;
+        return true;
+    }
+
+    /** @brief Queues a no-op (useful to wake a waiter or measure ring overhead). */
+    bool prep_nop(uint64_t user_data) noexcept { return prep(IORING_OP_NOP, -1, 0, nullptr, 0, 0, user_data); }
+
+    /**
+     * @brief Publishes queued SQEs and enters the kernel, normally once.
+     * * The kernel may take fewer SQEs than offered (it stops at one it cannot issue, and then does not
+     * wait) or fail the call outright (EAGAIN, EBUSY). Whatever it left is re-counted from its SQ head and
+     * offered again while it makes progress; SQEs still left after that stay queued, are counted by
+     * pending() and go with the next submit().
+     * @param wait_for Minimum completions to wait for before returning.
+     * @return Number of SQEs the kernel consumed, or the error of a call that consumed none.
+     */
+    std::expected<unsigned, std::error_code> submit(unsigned wait_for = 0) noexcept {
+        std::atomic_ref<unsigned>(*sq_tail_).store(local_tail_, std::memory_order_release);
+        unsigned consumed = 0;
+        for (;;) {
+            unsigned to_submit = pending();
+            if (to_submit == 0 && wait_for == 0) return consumed;
+            long n = ::syscall(__NR_io_uring_enter, fd_.get(), to_submit, wait_for,
+                               wait_for ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+            if (n < 0) {
+                // Interrupted: the SQ head tells what was consumed before the signal.
+                if (errno == EINTR) continue;
+                if (consumed) return consumed;
+                return std::unexpected(posix::last_error());
+            }
+            consumed += static_cast<unsigned>(n);
+            // Everything consumed means the kernel also did the waiting.
+            if (n == 0 || pending() == 0) return consumed;
+        }
+    }
+
+    /**
+     * @brief Copies already available completions into @p out without a syscall.
+     * @return Number of completions written.
+     */
+    unsigned reap(std::span<completion_t> out) noexcept {
+        unsigned head = *cq_head_;
+        unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+        unsigned n = 0;
+        while (head != tail && n < out.size()) {
+            const io_uring_cqe &cqe = cqes_[head & cq_mask_];
+            out[n++] = {cqe.user_data, cqe.res, cqe.flags};
+            ++head;
+        }
+        std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief Submits pending SQEs, waits for at least @p min_complete completions and reaps them.
+     * @return Number of completions written to @p out (at most out.size()).
+     */
+    std::expected<unsigned, std::error_code> submit_and_wait(std::span<completion_t> out,
+                                                             unsigned min_complete = 1) noexcept {
+        if (min_complete > out.size()) min_complete = static_cast<unsigned>(out.size());
+        unsigned got = reap(out);
+        if (got >= min_complete && pending() == 0) return got;
+        auto r = submit(min_complete > got ? min_complete - got : 0);
+        if (!r) return std::unexpected(r.error());
+        return got + reap(out.subspan(got));
+    }
+
+    /** @brief Pins buffers for prep_*_fixed(). At most one table can be registered at a time. */
+    std::error_code register_buffers(std::span<const iovec> buffers) noexcept {
+        return enter_register(IORING_REGISTER_BUFFERS, buffers.data(), static_cast<unsigned>(buffers.size()));
+    }
+    std::error_code unregister_buffers() noexcept { return enter_register(IORING_UNREGISTER_BUFFERS, nullptr, 0); }
+
+    /** @brief Registers descriptors, addressed afterwards as registered_file_t{index}. */
+    std::error_code register_files(std::span<const int> fds) noexcept {
+        return enter_register(IORING_REGISTER_FILES, fds.data(), static_cast<unsigned>(fds.size()));
+    }
+    std::error_code unregister_files() noexcept { return enter_register(IORING_UNREGISTER_FILES, nullptr, 0); }
+
+    /** @brief Unmaps the rings and closes the descriptor. Safe to call more than once. */
+    void close() noexcept {
+        if (sqes_) ::munmap(sqes_, sqes_size_);
+        if (cq_map_ && cq_map_ != sq_map_) ::munmap(cq_map_, cq_map_size_);
+        if (sq_map_) ::munmap(sq_map_, sq_map_size_);
+        sqes_ = nullptr;
+        cq_map_ = sq_map_ = nullptr;
+        fd_.reset();
+    }
+
+private:
+    static void *map(int fd, std::size_t size, uint64_t offset) noexcept {
+        void *p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                         static_cast<off_t>(offset));
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    bool prep(uint8_t opcode, int fd, uint8_t flags, const void *addr, std::size_t len, uint64_t offset,
+              uint64_t user_data) noexcept {
+        if (space_left() == 0) return false;
+        io_uring_sqe &sqe = sqes_[local_tail_ & sq_mask_];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = opcode;
+        sqe.flags = flags;
+        sqe.fd = fd;
+        sqe.off = offset;
+        sqe.addr = reinterpret_cast<uint64_t>(addr);
+        sqe.len = static_cast<uint32_t>(len);
+        sqe.user_data = user_data;
+        ++local_tail_;
+        return true;
+    }
+
+    std::error_code enter_register(unsigned opcode, const void *arg, unsigned count) noexcept {
+        return ::syscall(__NR_io_uring_register, fd_.get(), opcode, arg, count) == 0 ? std::error_code{}
+                                                                                      : posix::last_error();
+    }
+
+    void swap(uring &o) noexcept {
+        std::swap(fd_, o.fd_);
+        std::swap(features_, o.features_);
+        std::swap(sq_map_, o.sq_map_);
+        std::swap(cq_map_, o.cq_map_);
+        std::swap(sq_map_size_, o.sq_map_size_);
+        std::swap(cq_map_size_, o.cq_map_size_);
+        std::swap(sqes_, o.sqes_);
+        std::swap(sqes_size_, o.sqes_size_);
+        std::swap(sq_head_, o.sq_head_);
+        std::swap(sq_tail_, o.sq_tail_);
+        std::swap(sq_mask_, o.sq_mask_);
+        std::swap(sq_entries_, o.sq_entries_);
+        std::swap(local_tail_, o.local_tail_);
+        std::swap(cq_head_, o.cq_head_);
+        std::swap(cq_tail_, o.cq_tail_);
+        std::swap(cq_mask_, o.cq_mask_);
+        std::swap(cqes_, o.cqes_);
+    }
+
+    posix::unique_fd fd_;
+    uint32_t features_ = 0;
+    void *sq_map_ = nullptr;
+    void *cq_map_ = nullptr;
+    std::size_t sq_map_size_ = 0;
+    std::size_t cq_map_size_ = 0;
+    io_uring_sqe *sqes_ = nullptr;
+    std::size_t sqes_size_ = 0;
+
+    unsigned *sq_head_ = nullptr; // advanced by the kernel
+    unsigned *sq_tail_ = nullptr; // published by submit()
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned local_tail_ = 0; // includes SQEs prepared but not yet published
+
+    unsigned *cq_head_ = nullptr; // advanced by reap()
+    unsigned *cq_tail_ = nullptr; // advanced by the kernel
+    unsigned cq_mask_ = 0;
+    io_uring_cqe *cqes_ = nullptr;
+};
+
+#endif // SABUROU_PLATFORM_V2_OS_LINUX && SABUROU_PLATFORM_V2_HAS_IO_URING_UAPI
+
+} // namespace saburou::platform::v2::io
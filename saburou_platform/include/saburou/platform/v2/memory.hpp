@@ -0,0 +1,11 @@
+/**
+ * @file memory.hpp
+ * @brief Umbrella header for page mapping, arena/slab allocation and malloc introspection.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/memory/arena.hpp>  // IWYU pragma: export
+#include <saburou/platform/v2/memory/malloc.hpp> // IWYU pragma: export
+#include <saburou/platform/v2/memory/pages.hpp>  // IWYU pragma: export
+#include <saburou/platform/v2/memory/slab.hpp>   // IWYU pragma: export
@@ -0,0 +1,289 @@
+/**
+ * @file arena.hpp
+ * @brief Monotonic (bump-pointer) arena over page-granular chunks, with rewind markers and a pmr adapter.
+ *
+ * @code
+ * auto &arena = memory::thread_arena();
+ * memory::arena_scope scope(arena);                 // everything below is released at scope exit
+ * memory::arena_resource resource(arena);
+ * std::pmr::vector<int> scratch(&resource);
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/cpu/topology.hpp>
+#include <saburou/platform/v2/memory/pages.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace saburou::platform::v2::memory {
+
+/**
+ * @brief Options for monotonic_arena.
+ */
+struct arena_options_t {
+    std::size_t chunk_size = std::size_t{64} << 10; ///< Minimum chunk size; rounded up to the page granularity
+    bool huge_pages = false;                         ///< Back chunks with transparent huge pages (2 MiB granularity)
+    bool numa_local = false;                         ///< Place chunks on the NUMA node of the allocating thread
+};
+
+/**
+ * @brief Instrumentation counters of a monotonic_arena.
+ */
+struct arena_stats_t {
+    std::size_t bytes_used = 0;     ///< Bytes handed out since the last reset, including alignment padding
+    std::size_t bytes_reserved = 0; ///< Bytes mapped across all chunks
+    std::size_t high_water = 0;     ///< Largest bytes_used ever observed
+    std::size_t chunk_count = 0;    ///< Chunks currently owned (kept across rewind/reset for reuse)
+    uint64_t allocations = 0;       ///< allocate() calls served since construction
+};
+
+/**
+ * @brief Single-threaded bump allocator.
+ * * Memory comes from map_pages() in chunks whose size is a multiple of the page (or huge page) size; the
+ * first cacheline of each chunk holds its header, so every chunk payload starts cacheline-aligned.
+ * Individual frees are no-ops: memory is reclaimed by rewind() or reset(), which keep the chunks so that
+ * steady-state request processing never maps memory.
+ * @note Not thread-safe. Use one arena per thread (see thread_arena()).
+ */
+class monotonic_arena {
+public:
+    /**
+     * @brief Opaque position returned by mark() and accepted by rewind().
+     */
+    struct marker_t {
+        void *chunk = nullptr;
+        std::size_t offset = 0;
+        std::size_t used = 0;
+    };
+
+    explicit monotonic_arena(const arena_options_t &options = {}) noexcept : options_(options) {}
+
+    monotonic_arena(const monotonic_arena &) = delete;
+    monotonic_arena &operator=(const monotonic_arena &) = delete;
+
+    monotonic_arena(monotonic_arena &&other) noexcept
+        : options_(other.options_), head_(std::exchange(other.head_, nullptr)),
+          current_(std::exchange(other.current_, nullptr)), offset_(std::exchange(other.offset_, 0)),
+          stats_(std::exchange(other.stats_, {})) {}
+
+    monotonic_arena &operator=(monotonic_arena &&other) noexcept {
+        if (this != &other) {
+            release();
+            options_ = other.options_;
+            head_ = std::exchange(other.head_, nullptr);
+            current_ = std::exchange(other.current_, nullptr);
+            offset_ = std::exchange(other.offset_, 0);
+            stats_ = std::exchange(other.stats_, {});
+        }
+        return *this;
+    }
+
+    ~monotonic_arena() { release(); }
+
+    /**
+     * @brief Allocates @p bytes aligned to @p alignment (a power of two).
+     * @return The memory, or nullptr if a new chunk could not be mapped.
+     */
+    [[nodiscard]] void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept {
+        if (current_) {
+            if (void *p = bump(bytes, alignment)) return p;
+        }
+        if (!advance(bytes + alignment)) return nullptr;
+        return bump(bytes, alignment);
+    }
+
+    /** @brief Allocates and constructs a T. The destructor is never run by the arena. */
+    template <class T, class... Args> [[nodiscard]] T *make(Args &&...args) {
+        void *p = allocate(sizeof(T), alignof(T));
+        return p ? ::new (p) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    /** @brief Allocates uninitialized storage for @p count objects of T. */
+    template <class T> [[nodiscard]] T *allocate_array(std::size_t count) noexcept {
+        if (count > static_cast<std::size_t>(-1) / sizeof(T)) return nullptr;
+        return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /** @brief Captures the current position. */
+    [[nodiscard]] marker_t mark() const noexcept { return {current_, offset_, stats_.bytes_used}; }
+
+    /**
+     * @brief Releases everything allocated after @p marker was taken.
+     * @pre @p marker came from this arena and no reset() happened since.
+     */
+    void rewind(const marker_t &marker) noexcept {
+        current_ = static_cast<chunk_t *>(marker.chunk);
+        offset_ = marker.offset;
+        stats_.bytes_used = marker.used;
+    }
+
+    /** @brief Releases every allocation, keeping the chunks for reuse. */
+    void reset() noexcept { rewind({}); }
+
+    /** @brief Returns every chunk to the OS. */
+    void release() noexcept {
+        for (chunk_t *c = head_; c;) {
+            chunk_t *next = c->next;
+            unmap_pages(c, c->size, page_options());
+            c = next;
+        }
+        head_ = current_ = nullptr;
+        offset_ = 0;
+        stats_.bytes_used = stats_.bytes_reserved = stats_.chunk_count = 0;
+    }
+
+    /** @brief Snapshot of the counters. */
+    [[nodiscard]] const arena_stats_t &stats() const noexcept { return stats_; }
+
+    /** @brief Options the arena was built with. */
+    [[nodiscard]] const arena_options_t &options() const noexcept { return options_; }
+
+private:
+    struct chunk_t {
+        chunk_t *next;
+        std::size_t size; // mapped bytes, header included
+    };
+    static constexpr std::size_t header_size = (sizeof(chunk_t) + cpu::cacheline_size - 1) / cpu::cacheline_size *
+                                               cpu::cacheline_size;
+
+    [[nodiscard]] page_options_t page_options() const noexcept {
+        return {.huge = options_.huge_pages, .numa_local = options_.numa_local};
+    }
+
+    [[nodiscard]] void *bump(std::size_t bytes, std::size_t alignment) noexcept {
+        auto base = reinterpret_cast<std::uintptr_t>(current_);
+        std::uintptr_t start = (base + offset_ + alignment - 1) & ~(std::uintptr_t{alignment} - 1);
+        std::size_t end = start - base + bytes;
+        if (end > current_->size || end < offset_) return nullptr;
+        stats_.bytes_used += end - offset_;
+        if (stats_.bytes_used > stats_.high_water) stats_.high_water = stats_.bytes_used;
+        ++stats_.allocations;
+        offset_ = end;
+        return reinterpret_cast<void *>(start);
+    }
+
+    // Moves to the next kept chunk if it fits @p need bytes, otherwise maps a new one after the current.
+    bool advance(std::size_t need) noexcept {
+        chunk_t *next = current_ ? current_->next : head_;
+        if (next && next->size - header_size >= need) {
+            enter(next);
+            return true;
+        }
+        std::size_t size = round_to_pages(header_size + (need > options_.chunk_size ? need : options_.chunk_size),
+                                          page_options());
+        auto *chunk = static_cast<chunk_t *>(map_pages(size, page_options()));
+        if (!chunk) return false;
+        chunk->size = size;
+        chunk->next = next;
+        if (current_) current_->next = chunk;
+        else head_ = chunk;
+        stats_.bytes_reserved += size;
+        ++stats_.chunk_count;
+        enter(chunk);
+        return true;
+    }
+
+    void enter(chunk_t *chunk) noexcept {
+        // The unused tail of the chunk being left counts as used until the next rewind.
+        if (current_) stats_.bytes_used += current_->size - offset_;
+        current_ = chunk;
+        offset_ = header_size;
+    }
+
+    arena_options_t options_;
+    chunk_t *head_ = nullptr;
+    chunk_t *current_ = nullptr;
+    std::size_t offset_ = 0; // bump offset inside current_, from the chunk start
+    arena_stats_t stats_{};
+};
+
+/**
+ * @brief Rewinds an arena to the position it had at construction.
+ */
+class arena_scope {
+public:
+    explicit arena_scope(monotonic_arena &arena) noexcept : arena_(arena), marker_(arena.mark()) {}
+    arena_scope(const arena_scope &) = delete;
+    arena_scope &operator=(const arena_scope &) = delete;
+    ~arena_scope() { arena_.rewind(marker_); }
+
+private:
+    monotonic_arena &arena_;
+    monotonic_arena::marker_t marker_;
+};
+
+/**
+ * @brief std::pmr::memory_resource view of a monotonic_arena.
+ * * deallocate() is a no-op, as with std::pmr::monotonic_buffer_resource; exhaustion throws
+ * std::bad_alloc, as the memory_resource contract requires.
+ */
+class arena_resource final : public std::pmr::memory_resource {
+public:
+    explicit arena_resource(monotonic_arena &arena) noexcept : arena_(&arena) {}
+
+    /** @brief The wrapped arena. */
+    [[nodiscard]] monotonic_arena &arena() const noexcept { return *arena_; }
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void *p = arena_->allocate(bytes, alignment);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        auto *o = dynamic_cast<const arena_resource *>(&other);
+        return o && o->arena_ == arena_;
+    }
+
+    monotonic_arena *arena_;
+};
+
+/**
+ * @brief Per-thread arena with default options, created on first use and released at thread exit.
+ */
+[[nodiscard]] inline monotonic_arena &thread_arena() noexcept {
+    thread_local monotonic_arena arena;
+    return arena;
+}
+
+} // namespace saburou::platform::v2::memory
+
+/**
+ * @brief std::formatter specialization for arena_stats_t.
+ * Supported format specifiers: {} or {:s} for a compact summary, {:r} for full technical representation.
+ */
+template <> struct std::formatter<saburou::platform::v2::memory::arena_stats_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for arena_stats_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::memory::arena_stats_t &s, std::format_context &ctx) const {
+        if (repr) {
+            return std::format_to(ctx.out(),
+                                  "arena_stats(bytes_used={}, bytes_reserved={}, high_water={}, chunk_count={}, "
+                                  "allocations={})",
+                                  s.bytes_used, s.bytes_reserved, s.high_water, s.chunk_count, s.allocations);
+        }
+        return std::format_to(ctx.out(), "arena_stats({}/{} bytes, peak {}, {} chunks)", s.bytes_used,
+                              s.bytes_reserved, s.high_water, s.chunk_count);
+    }
+};
@@ -0,0 +1,462 @@
+/**
+ * @file malloc.hpp
+ * @brief Runtime identification, statistics and tuning of the active malloc implementation.
+ *
+ * @code
+ * auto info = memory::allocator_info();      // e.g. glibc 2.36, or jemalloc 5.3.0 via LD_PRELOAD
+ * memory::tune_arenas_for_threads(workers);  // caps glibc's default of 8 arenas per core
+ * std::println("{}", memory::heap_stats());
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/cpu/topology.hpp>
+#include <saburou/platform/v2/detect.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE && __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define SABUROU_PLATFORM_V2_HAS_DLSYM 1
+#else
+#define SABUROU_PLATFORM_V2_HAS_DLSYM 0
+#endif
+#if SABUROU_PLATFORM_V2_LIBC_GLIBC
+#include <gnu/libc-version.h>
+#include <malloc.h>
+#endif
+
+namespace saburou::platform::v2::memory {
+
+/**
+ * @brief malloc implementation serving the process.
+ */
+enum class allocator_t : uint8_t {
+    unknown,  // Could not be determined
+    glibc,    // glibc ptmalloc2 (per-thread arenas)
+    musl,     // musl mallocng (oldmalloc before 1.2.1)
+    bionic,   // Android bionic (scudo or jemalloc, chosen at platform build time)
+    apple,    // macOS/iOS libmalloc (magazine zones)
+    windows,  // Windows CRT heap (segment heap / NT heap)
+    jemalloc, // jemalloc, linked in or interposed
+    tcmalloc, // gperftools tcmalloc, linked in or interposed
+    mimalloc  // Microsoft mimalloc, overriding malloc
+};
+
+/**
+ * @brief Identity of the active allocator.
+ */
+struct allocator_info_t {
+    allocator_t kind = allocator_t::unknown;
+    bool interposed = false; ///< Replaces the libc malloc (LD_PRELOAD or linked in), rather than being libc's own
+    std::string version;     ///< Allocator (or libc) version when it can be queried, e.g. "5.3.0-0-g54eaed1d..."
+    std::string library;     ///< Object that defines malloc, when dladdr() can tell (e.g. "/usr/lib/libjemalloc.so.2")
+};
+
+/**
+ * @brief Process-wide heap counters, as reported by the allocator itself. Unknown fields stay 0.
+ */
+struct heap_stats_t {
+    allocator_t kind = allocator_t::unknown;
+    std::size_t allocated = 0; ///< Bytes in live allocations (glibc uordblks+hblkhd, jemalloc stats.allocated)
+    std::size_t free = 0;      ///< Bytes held by the allocator but not allocated (fragmentation + caches)
+    std::size_t mapped = 0;    ///< Bytes obtained from the OS (sbrk heap + mmap, or committed memory)
+    std::size_t mmapped = 0;   ///< Part of mapped served by dedicated mmap chunks (glibc hblkhd)
+    std::size_t releasable = 0; ///< Bytes release_free_memory() could return right away (glibc keepcost)
+
+    /** @brief True if the allocator reported anything. */
+    [[nodiscard]] bool is_valid() const noexcept { return mapped != 0 || allocated != 0; }
+};
+
+/**
+ * @brief Converts an allocator_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(allocator_t a) {
+    switch (a) {
+    case allocator_t::glibc:    return "glibc";
+    case allocator_t::musl:     return "musl";
+    case allocator_t::bionic:   return "bionic";
+    case allocator_t::apple:    return "apple";
+    case allocator_t::windows:  return "windows";
+    case allocator_t::jemalloc: return "jemalloc";
+    case allocator_t::tcmalloc: return "tcmalloc";
+    case allocator_t::mimalloc: return "mimalloc";
+    default:                    return "unknown";
+    }
+}
+
+namespace detail {
+
+/** @brief Looks up a global function by name in the already loaded objects; nullptr when absent. */
+template <class Fn> [[nodiscard]] inline Fn *find_symbol(const char *name) noexcept {
+#if SABUROU_PLATFORM_V2_HAS_DLSYM
+    return reinterpret_cast<Fn *>(::dlsym(RTLD_DEFAULT, name));
+#else
+    (void)name;
+    return nullptr;
+#endif
+}
+
+using mallctl_fn = int(const char *, void *, std::size_t *, void *, std::size_t);
+using tc_property_fn = int(const char *, std::size_t *);
+using tc_version_fn = const char *(int *, int *, const char **);
+using tc_release_fn = void();
+using mi_version_fn = int();
+using mi_process_info_fn = void(std::size_t *, std::size_t *, std::size_t *, std::size_t *, std::size_t *,
+                                std::size_t *, std::size_t *, std::size_t *);
+using mi_collect_fn = void(bool);
+
+/** @brief jemalloc's mallctl, also under the je_ prefix some builds use. */
+[[nodiscard]] inline mallctl_fn *jemalloc_mallctl() noexcept {
+    static mallctl_fn *const fn = [] {
+        auto *f = find_symbol<mallctl_fn>("mallctl");
+        return f ? f : find_symbol<mallctl_fn>("je_mallctl");
+    }();
+    return fn;
+}
+
+/** @brief Reads a size_t jemalloc statistic (0 on failure). */
+[[nodiscard]] inline std::size_t jemalloc_size(const char *name) noexcept {
+    std::size_t value = 0, len = sizeof(value);
+    auto *mallctl = jemalloc_mallctl();
+    return mallctl && mallctl(name, &value, &len, nullptr, 0) == 0 ? value : 0;
+}
+
+/** @brief Reads a gperftools MallocExtension numeric property (0 on failure). */
+[[nodiscard]] inline std::size_t tcmalloc_property(const char *name) noexcept {
+    static tc_property_fn *const fn = find_symbol<tc_property_fn>("MallocExtension_GetNumericProperty");
+    std::size_t value = 0;
+    return fn && fn(name, &value) ? value : 0;
+}
+
+/** @brief Classifies the object that defines malloc from its file name. */
+[[nodiscard]] constexpr allocator_t allocator_from_library(std::string_view path) noexcept {
+    auto slash = path.rfind('/');
+    std::string_view file = slash == std::string_view::npos ? path : path.substr(slash + 1);
+    if (file.find("jemalloc") != std::string_view::npos) return allocator_t::jemalloc;
+    if (file.find("tcmalloc") != std::string_view::npos) return allocator_t::tcmalloc;
+    if (file.find("mimalloc") != std::string_view::npos) return allocator_t::mimalloc;
+    return allocator_t::unknown;
+}
+
+/** @brief The allocator libc ships, from the compile-time detection in detect.hpp. */
+[[nodiscard]] constexpr allocator_t libc_allocator() noexcept {
+#if SABUROU_PLATFORM_V2_LIBC_GLIBC
+    return allocator_t::glibc;
+#elif SABUROU_PLATFORM_V2_LIBC_MUSL || SABUROU_PLATFORM_V2_LIBC_PROBABLY_MUSL
+    return allocator_t::musl;
+#elif SABUROU_PLATFORM_V2_LIBC_BIONIC
+    return allocator_t::bionic;
+#elif SABUROU_PLATFORM_V2_LIBC_APPLE
+    return allocator_t::apple;
+#elif SABUROU_PLATFORM_V2_OS_WINDOWS
+    return allocator_t::windows;
+#else
+    return allocator_t::unknown;
+#endif
+}
+
+/** @brief Identifies the allocator; see allocator_info(). */
+[[nodiscard]] inline allocator_info_t detect_allocator() {
+    allocator_info_t info{};
+#if SABUROU_PLATFORM_V2_HAS_DLSYM
+    // The object that defines the malloc every caller binds to is the strongest signal: it names
+    // LD_PRELOADed and dynamically linked replacements. Static replacements live in the executable, so
+    // fall back to their control symbols, unless malloc still resolves to libc: a library can export
+    // them without overriding malloc (prefixed jemalloc builds, mimalloc used through mi_malloc only).
+    Dl_info dl{};
+    void *resolved = ::dlsym(RTLD_DEFAULT, "malloc");
+    if (resolved && ::dladdr(resolved, &dl) && dl.dli_fname) info.library = dl.dli_fname;
+    info.kind = allocator_from_library(info.library);
+    std::string_view file = info.library;
+    bool from_libc = file.find("libc.so") != std::string_view::npos || file.find("libc.musl") != std::string_view::npos ||
+                     file.find("ld-musl") != std::string_view::npos;
+    if (info.kind == allocator_t::unknown && !from_libc) {
+        if (jemalloc_mallctl()) info.kind = allocator_t::jemalloc;
+        else if (find_symbol<tc_property_fn>("MallocExtension_GetNumericProperty")) info.kind = allocator_t::tcmalloc;
+        else if (find_symbol<mi_version_fn>("mi_version")) info.kind = allocator_t::mimalloc;
+    }
+    info.interposed = info.kind != allocator_t::unknown;
+
+    switch (info.kind) {
+    case allocator_t::jemalloc: {
+        const char *version = nullptr;
+        std::size_t len = sizeof(version);
+        auto *mallctl = jemalloc_mallctl();
+        if (mallctl && mallctl("version", &version, &len, nullptr, 0) == 0 && version) info.version = version;
+        break;
+    }
+    case allocator_t::tcmalloc:
+        if (auto *tc_version = find_symbol<tc_version_fn>("tc_version")) {
+            int major = 0, minor = 0;
+            const char *patch = nullptr;
+            if (const char *v = tc_version(&major, &minor, &patch)) info.version = v;
+        }
+        break;
+    case allocator_t::mimalloc:
+        if (auto *mi_version = find_symbol<mi_version_fn>("mi_version")) {
+            int v = mi_version(); // e.g. 212 for 2.1.2
+            info.version = std::format("{}.{}.{}", v / 100, v / 10 % 10, v % 10);
+        }
+        break;
+    default:
+        break;
+    }
+#endif
+    if (info.kind == allocator_t::unknown) info.kind = libc_allocator();
+#if SABUROU_PLATFORM_V2_LIBC_GLIBC
+    if (info.kind == allocator_t::glibc) info.version = ::gnu_get_libc_version();
+#endif
+    return info;
+}
+
+} // namespace detail
+
+/**
+ * @brief The allocator serving malloc() in this process.
+ * * Detected once: a replacement must be in place before main() (LD_PRELOAD or linking) to matter anyway.
+ */
+[[nodiscard]] inline const allocator_info_t &allocator_info() {
+    static const allocator_info_t info = detail::detect_allocator();
+    return info;
+}
+
+/**
+ * @brief Heap counters from the allocator's own statistics API.
+ * * glibc: mallinfo2() (2.33+; mallinfo() before, which saturates at 2 GiB) summed over all arenas.
+ * jemalloc: stats.allocated / active / mapped after an epoch refresh. tcmalloc: MallocExtension generic
+ * and pageheap properties. mimalloc: committed memory from mi_process_info(). musl and others expose no
+ * statistics, so only kind is filled.
+ * @note glibc walks every arena under its lock: fine for periodic reporting, not for hot paths.
+ */
+[[nodiscard]] inline heap_stats_t heap_stats() {
+    heap_stats_t s{};
+    s.kind = allocator_info().kind;
+    switch (s.kind) {
+#if SABUROU_PLATFORM_V2_LIBC_GLIBC
+    case allocator_t::glibc: {
+#if __GLIBC_PREREQ(2, 33)
+        struct mallinfo2 mi = ::mallinfo2();
+#else
+        struct mallinfo mi = ::mallinfo();
+#endif
+        s.allocated = static_cast<std::size_t>(mi.uordblks) + static_cast<std::size_t>(mi.hblkhd);
+        s.free = static_cast<std::size_t>(mi.fordblks);
+        s.mapped = static_cast<std::size_t>(mi.arena) + static_cast<std::size_t>(mi.hblkhd);
+        s.mmapped = static_cast<std::size_t>(mi.hblkhd);
+        s.releasable = static_cast<std::size_t>(mi.keepcost);
+        break;
+    }
+#endif
+    case allocator_t::jemalloc: {
+        if (auto *mallctl = detail::jemalloc_mallctl()) {
+            uint64_t epoch = 1; // statistics are cached until the epoch advances
+            std::size_t len = sizeof(epoch);
+            (void)mallctl("epoch", &epoch, &len, &epoch, len);
+        }
+        s.allocated = detail::jemalloc_size("stats.allocated");
+        std::size_t active = detail::jemalloc_size("stats.active");
+        s.free = active > s.allocated ? active - s.allocated : 0;
+        s.mapped = detail::jemalloc_size("stats.mapped");
+        break;
+    }
+    case allocator_t::tcmalloc:
+        s.allocated = detail::tcmalloc_property("generic.current_allocated_bytes");
+        s.mapped = detail::tcmalloc_property("generic.heap_size");
+        s.releasable = detail::tcmalloc_property("tcmalloc.pageheap_free_bytes");
+        s.free = s.mapped > s.allocated ? s.mapped - s.allocated : 0;
+        break;
+    case allocator_t::mimalloc:
+        if (auto *info = detail::find_symbol<detail::mi_process_info_fn>("mi_process_info")) {
+            std::size_t elapsed = 0, user = 0, sys = 0, rss = 0, peak_rss = 0, commit = 0, peak_commit = 0, faults = 0;
+            info(&elapsed, &user, &sys, &rss, &peak_rss, &commit, &peak_commit, &faults);
+            s.mapped = commit;
+        }
+        break;
+    default:
+        break;
+    }
+    return s;
+}
+
+/**
+ * @brief Caps the number of malloc arenas (glibc M_ARENA_MAX).
+ * * glibc creates up to 8 arenas per core on 64-bit systems as threads contend, which inflates RSS in
+ * thread-heavy services. jemalloc fixes its arena count at startup (MALLOC_CONF=narenas:N), and the other
+ * allocators use per-thread or per-CPU caches instead of arenas.
+ * @return True if the allocator accepted the setting.
+ * @note Call early: arenas that already exist are never destroyed.
+ */
+inline bool set_arena_limit(std::size_t arenas) noexcept {
+#if SABUROU_PLATFORM_V2_LIBC_GLIBC
+    if (allocator_info().kind == allocator_t::glibc && arenas > 0 && arenas <= 0x7fffffff)
+        return ::mallopt(M_ARENA_MAX, static_cast<int>(arenas)) == 1;
+#endif
+    (void)arenas;
+    return false;
+}
+
+/**
+ * @brief Sets how much free memory at the top of the heap glibc keeps before trimming it (M_TRIM_THRESHOLD).
+ * @return True if the allocator accepted the setting.
+ * @note Setting it disables glibc's dynamic adjustment of the trim and mmap thresholds.
+ */
+inline bool set_trim_threshold(std::size_t bytes) noexcept {
+#if SABUROU_PLATFORM_V2_LIBC_GLIBC
+    if (allocator_info().kind == allocator_t::glibc && bytes <= 0x7fffffff)
+        return ::mallopt(M_TRIM_THRESHOLD, static_cast<int>(bytes)) == 1;
+#endif
+    (void)bytes;
+    return false;
+}
+
+/**
+ * @brief Sets the request size from which glibc serves allocations with their own mmap (M_MMAP_THRESHOLD).
+ * @return True if the allocator accepted the setting (glibc caps it at 32 MiB on 64-bit).
+ * @note Like set_trim_threshold(), this disables the dynamic threshold adjustment.
+ */
+inline bool set_mmap_threshold(std::size_t bytes) noexcept {
+#if SABUROU_PLATFORM_V2_LIBC_GLIBC
+    if (allocator_info().kind == allocator_t::glibc && bytes <= 0x7fffffff)
+        return ::mallopt(M_MMAP_THRESHOLD, static_cast<int>(bytes)) == 1;
+#endif
+    (void)bytes;
+    return false;
+}
+
+/**
+ * @brief Returns cached free memory to the OS.
+ * * glibc malloc_trim(0) (which also madvises free pages inside every arena), jemalloc purge of all
+ * arenas, tcmalloc MallocExtension_ReleaseFreeMemory(), mimalloc mi_collect(true).
+ * @return True if the allocator offers such an operation.
+ */
+inline bool release_free_memory() noexcept {
+    switch (allocator_info().kind) {
+#if SABUROU_PLATFORM_V2_LIBC_GLIBC
+    case allocator_t::glibc:
+        (void)::malloc_trim(0);
+        return true;
+#endif
+    case allocator_t::jemalloc: {
+        // "arena.<MALLCTL_ARENAS_ALL>.purge", MALLCTL_ARENAS_ALL being 4096.
+        auto *mallctl = detail::jemalloc_mallctl();
+        return mallctl && mallctl("arena.4096.purge", nullptr, nullptr, nullptr, 0) == 0;
+    }
+    case allocator_t::tcmalloc:
+        if (auto *release = detail::find_symbol<detail::tc_release_fn>("MallocExtension_ReleaseFreeMemory")) {
+            release();
+            return true;
+        }
+        return false;
+    case allocator_t::mimalloc:
+        if (auto *collect = detail::find_symbol<detail::mi_collect_fn>("mi_collect")) {
+            collect(true);
+            return true;
+        }
+        return false;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Arena count that keeps contention low for @p threads workers without one arena per thread.
+ * * One arena per thread up to two per online CPU: threads beyond that cannot run concurrently, so more
+ * arenas only add fragmentation.
+ */
+[[nodiscard]] inline std::size_t suggested_arena_count(std::size_t threads) {
+    std::size_t cap = 2 * cpu::online_count();
+    if (threads == 0) threads = 1;
+    return threads < cap ? threads : cap;
+}
+
+/**
+ * @brief Applies suggested_arena_count(@p threads) with set_arena_limit().
+ * @return True if the allocator has tunable arenas and accepted the limit.
+ */
+inline bool tune_arenas_for_threads(std::size_t threads) { return set_arena_limit(suggested_arena_count(threads)); }
+
+} // namespace saburou::platform::v2::memory
+
+/**
+ * @brief std::formatter specialization for allocator_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "allocator_t::glibc").
+ */
+template <> struct std::formatter<saburou::platform::v2::memory::allocator_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::memory::allocator_t &a, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::memory::to_code_name(a);
+        return repr ? std::format_to(ctx.out(), "allocator_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
+
+/**
+ * @brief std::formatter specialization for allocator_info_t.
+ * Supported format specifiers: {} or {:s} for a compact summary, {:r} for full technical representation.
+ */
+template <> struct std::formatter<saburou::platform::v2::memory::allocator_info_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for allocator_info_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::memory::allocator_info_t &a, std::format_context &ctx) const {
+        if (repr) {
+            return std::format_to(ctx.out(), "allocator_info(kind={:r}, interposed={}, version={}, library={})",
+                                  a.kind, a.interposed, a.version, a.library);
+        }
+        if (a.version.empty()) return std::format_to(ctx.out(), "allocator({})", a.kind);
+        return std::format_to(ctx.out(), "allocator({} {})", a.kind, a.version);
+    }
+};
+
+/**
+ * @brief std::formatter specialization for heap_stats_t.
+ * Supported format specifiers: {} or {:s} for a compact summary, {:r} for full technical representation.
+ */
+template <> struct std::formatter<saburou::platform::v2::memory::heap_stats_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for heap_stats_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::memory::heap_stats_t &s, std::format_context &ctx) const {
+        if (repr) {
+            return std::format_to(ctx.out(),
+                                  "heap_stats(kind={:r}, allocated={}, free={}, mapped={}, mmapped={}, releasable={})",
+                                  s.kind, s.allocated, s.free, s.mapped, s.mmapped, s.releasable);
+        }
+        if (!s.is_valid()) return std::format_to(ctx.out(), "heap_stats({}, unavailable)", s.kind);
+        return std::format_to(ctx.out(), "heap_stats({}, {}/{} bytes allocated)", s.kind, s.allocated, s.mapped);
+    }
+};
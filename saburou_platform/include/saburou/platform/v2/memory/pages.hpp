@@ -0,0 +1,169 @@
+/**
+ * @file pages.hpp
+ * @brief Page-granular memory mapping with optional transparent huge pages and NUMA-local placement.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/cpu/topology.hpp>
+#include <saburou/platform/v2/detect.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#if SABUROU_PLATFORM_V2_OS_LINUX
+#include <saburou/platform/v2/os/linux/procfs/parse.hpp>
+#include <saburou/platform/v2/os/linux/procfs/reader.hpp>
+
+#include <sys/syscall.h>
+#endif
+
+namespace saburou::platform::v2::memory {
+
+/**
+ * @brief How map_pages() backs a region.
+ */
+struct page_options_t {
+    bool huge = false;       ///< Align to and request transparent huge pages (MADV_HUGEPAGE)
+    bool numa_local = false; ///< Prefer the NUMA node of the calling thread (Linux mbind, MPOL_PREFERRED)
+    bool populate = false;   ///< Prefault the pages up front (MAP_POPULATE)
+};
+
+/**
+ * @brief Base page size, queried once.
+ */
+[[nodiscard]] inline std::size_t page_size() noexcept {
+    static const std::size_t size = [] {
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+        long s = ::sysconf(_SC_PAGESIZE);
+        if (s > 0) return static_cast<std::size_t>(s);
+#endif
+        return std::size_t{4096};
+    }();
+    return size;
+}
+
+/**
+ * @brief Transparent huge page size, queried once.
+ * * Reads /sys/kernel/mm/transparent_hugepage/hpage_pmd_size, then Hugepagesize from /proc/meminfo.
+ * @return The huge page size in bytes, or 0 when the platform has none.
+ */
+[[nodiscard]] inline std::size_t huge_page_size() noexcept {
+    static const std::size_t size = [] {
+        std::size_t n = 0;
+#if SABUROU_PLATFORM_V2_OS_LINUX
+        namespace procfs = saburou::platform::v2::os::linux::procfs;
+        procfs::file_reader pmd("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", 64);
+        if (procfs::parse_number(procfs::trim(pmd.read()), n) && n) return n;
+        procfs::file_reader meminfo("/proc/meminfo", 8192);
+        std::size_t kb = 0;
+        if (procfs::parse_number(procfs::find_value(meminfo.read(), "Hugepagesize"), kb)) n = kb * 1024;
+#endif
+        return n;
+    }();
+    return size;
+}
+
+/**
+ * @brief NUMA node of the CPU the caller is running on.
+ * @return The node id, or -1 when unknown (non-Linux or getcpu unavailable).
+ */
+[[nodiscard]] inline int current_numa_node() noexcept {
+#if SABUROU_PLATFORM_V2_OS_LINUX && defined(SYS_getcpu)
+    unsigned cpu = 0, node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return static_cast<int>(node);
+#endif
+    return -1;
+}
+
+/** @brief Rounds @p bytes up to the granularity map_pages() uses for @p options. */
+[[nodiscard]] inline std::size_t round_to_pages(std::size_t bytes, const page_options_t &options = {}) noexcept {
+    std::size_t granule = options.huge && huge_page_size() ? huge_page_size() : page_size();
+    return (bytes + granule - 1) / granule * granule;
+}
+
+/**
+ * @brief Maps anonymous, zero-filled, page-aligned memory.
+ * @param bytes Length; rounded up with round_to_pages().
+ * @param options Huge page, NUMA and prefault preferences. All of them are best-effort.
+ * @return The region (huge-page aligned when options.huge), or nullptr on failure. Release it with
+ * unmap_pages() and the same length and options.
+ */
+[[nodiscard]] inline void *map_pages(std::size_t bytes, const page_options_t &options = {}) noexcept {
+    bytes = round_to_pages(bytes, options);
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+    std::size_t huge = options.huge ? huge_page_size() : 0;
+    // Prefaulting must wait for MADV_HUGEPAGE and mbind, or it would place base pages on any node.
+    bool late_populate = options.populate && (huge || options.numa_local);
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_POPULATE)
+    if (options.populate && !late_populate) flags |= MAP_POPULATE;
+#endif
+    // Over-allocate by one huge page so the region can be trimmed to a huge-page boundary.
+    std::size_t length = huge ? bytes + huge : bytes;
+    void *raw = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+
+    auto *p = static_cast<std::byte *>(raw);
+    if (huge) {
+        auto addr = reinterpret_cast<std::uintptr_t>(p);
+        std::size_t head = (huge - addr % huge) % huge;
+        if (head) ::munmap(p, head);
+        if (std::size_t tail = length - head - bytes) ::munmap(p + head + bytes, tail);
+        p += head;
+#if defined(MADV_HUGEPAGE)
+        (void)::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+    }
+
+#if SABUROU_PLATFORM_V2_OS_LINUX && defined(SYS_mbind)
+    if (options.numa_local) {
+        int node = current_numa_node();
+        if (node >= 0 && node < 1024) {
+            constexpr unsigned long mpol_preferred = 1;
+            unsigned long mask[1024 / (8 * sizeof(unsigned long))]{};
+            mask[node / (8 * sizeof(unsigned long))] = 1ul << (node % (8 * sizeof(unsigned long)));
+            // The kernel ignores the last bit of maxnode, hence the + 1.
+            (void)::syscall(SYS_mbind, p, bytes, mpol_preferred, mask, 1024ul + 1, 0u);
+        }
+    }
+#endif
+
+    if (late_populate) {
+        bool populated = false;
+#if defined(MADV_POPULATE_WRITE)
+        populated = ::madvise(p, bytes, MADV_POPULATE_WRITE) == 0; // Linux 5.14+
+#endif
+        if (!populated) {
+            std::size_t step = huge ? huge : page_size();
+            for (std::size_t off = 0; off < bytes; off += step) static_cast<volatile std::byte *>(p)[off] = {};
+        }
+    }
+    return p;
+#else
+    (void)options;
+    return ::operator new(bytes, std::align_val_t{cpu::cacheline_size}, std::nothrow);
+#endif
+}
+
+/**
+ * @brief Releases a region returned by map_pages().
+ * @param bytes The length passed to map_pages().
+ */
+inline void unmap_pages(void *p, std::size_t bytes, const page_options_t &options = {}) noexcept {
+    if (!p) return;
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+    ::munmap(p, round_to_pages(bytes, options));
+#else
+    (void)bytes;
+    (void)options;
+    ::operator delete(p, std::align_val_t{cpu::cacheline_size});
+#endif
+}
+
+} // namespace saburou::platform::v2::memory
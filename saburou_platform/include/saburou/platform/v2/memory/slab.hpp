@@ -0,0 +1,443 @@
+/**
+ * @file slab.hpp
+ * @brief Fixed-size object pool: cacheline-aligned slabs, per-thread magazines and a shared depot.
+ *
+ * @code
+ * static memory::object_pool<node_t> nodes;
+ * node_t *n = nodes.make(key, value);  // usually a pop from this thread's magazine
+ * nodes.destroy(n);                    // any thread may free; full magazines go to the shared depot
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/cpu/topology.hpp>
+#include <saburou/platform/v2/memory/pages.hpp>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace saburou::platform::v2::memory {
+
+/**
+ * @brief Options for slab_pool.
+ */
+struct slab_options_t {
+    std::size_t slab_size = std::size_t{64} << 10; ///< Bytes per slab; rounded up to the page granularity
+    std::size_t magazine_size = 64;                ///< Objects per magazine (per-thread cache batch)
+    bool huge_pages = false;                       ///< Back slabs with transparent huge pages
+    bool numa_local = false;                       ///< Place slabs on the NUMA node of the refilling thread
+};
+
+/**
+ * @brief Counters of a slab_pool. Refreshed on slow paths only, so they are cheap and approximate.
+ */
+struct slab_stats_t {
+    std::size_t object_size = 0;    ///< Stride between objects (size rounded up to the alignment)
+    std::size_t slab_count = 0;     ///< Slabs mapped
+    std::size_t bytes_reserved = 0; ///< Bytes mapped across all slabs
+    std::size_t depot_full = 0;     ///< Full magazines parked in the depot
+};
+
+class slab_pool;
+
+namespace detail {
+
+/** @brief Fixed-capacity stack of free objects moved between threads as a unit. */
+struct magazine_t {
+    std::atomic<uint32_t> next{0}; ///< Index of the magazine below this one in a depot stack
+    uint32_t index = 0;            ///< Own index in the pool's magazine_table
+    std::size_t count = 0;
+
+    /** @brief The object slots, stored right after the header. */
+    [[nodiscard]] void **items() noexcept { return reinterpret_cast<void **>(this + 1); }
+
+    [[nodiscard]] static magazine_t *create(std::size_t capacity) {
+        void *p = ::operator new(sizeof(magazine_t) + capacity * sizeof(void *));
+        return ::new (p) magazine_t{};
+    }
+    static void destroy(magazine_t *m) noexcept { ::operator delete(m); }
+};
+
+/**
+ * @brief Every magazine of one pool, addressed by a 32-bit index (0 means none). Owns the magazines.
+ * * Segment s holds indices [2^s, 2^(s+1)), so the table grows without moving published slots and lookups
+ * take no lock. A slot is written once, by the creating thread, before the magazine first enters a depot.
+ */
+class magazine_table {
+public:
+    magazine_table() = default;
+    magazine_table(const magazine_table &) = delete;
+    magazine_table &operator=(const magazine_table &) = delete;
+
+    ~magazine_table() {
+        for (uint32_t i = 1, n = size_.load(std::memory_order_relaxed); i <= n && i != 0; ++i) {
+            if (magazine_t *m = (*this)[i]) magazine_t::destroy(m);
+        }
+        for (auto &segment : segments_) delete[] segment.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] magazine_t *create(std::size_t capacity) {
+        magazine_t *m = magazine_t::create(capacity);
+        uint32_t index = size_.fetch_add(1, std::memory_order_relaxed) + 1;
+        unsigned s = static_cast<unsigned>(std::bit_width(index)) - 1;
+        magazine_t **segment = segments_[s].load(std::memory_order_acquire);
+        if (!segment) {
+            magazine_t **fresh = new (std::nothrow) magazine_t *[std::size_t{1} << s]{};
+            if (!fresh) {
+                magazine_t::destroy(m); // the index stays unused: its slot is null
+                throw std::bad_alloc();
+            }
+            if (segments_[s].compare_exchange_strong(segment, fresh, std::memory_order_acq_rel)) segment = fresh;
+            else delete[] fresh;
+        }
+        segment[index - (uint32_t{1} << s)] = m;
+        m->index = index;
+        return m;
+    }
+
+    [[nodiscard]] magazine_t *operator[](uint32_t index) const noexcept {
+        unsigned s = static_cast<unsigned>(std::bit_width(index)) - 1;
+        magazine_t **segment = segments_[s].load(std::memory_order_acquire);
+        return segment ? segment[index - (uint32_t{1} << s)] : nullptr;
+    }
+
+private:
+    std::array<std::atomic<magazine_t **>, 32> segments_{};
+    std::atomic<uint32_t> size_{0};
+};
+
+/**
+ * @brief Lock-free stack of magazines (Treiber stack).
+ * * The head packs a 32-bit magazine index with a 32-bit tag bumped on every update, so a pop that raced
+ * with a pop and re-push of the same magazine (ABA) fails its CAS. That fits a plain 8-byte CAS: no
+ * mutex, no -mcx16 and no libatomic. Magazines are never freed before their pool, so reading the next
+ * index of a magazine another thread just popped is harmless.
+ */
+class magazine_stack {
+public:
+    void push(magazine_t *m) noexcept {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        do {
+            m->next.store(index_of(head), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, bump(head, m->index), std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    [[nodiscard]] magazine_t *pop(const magazine_table &table) noexcept {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        magazine_t *m;
+        do {
+            if (index_of(head) == 0) return nullptr;
+            m = table[index_of(head)];
+        } while (!head_.compare_exchange_weak(head, bump(head, m->next.load(std::memory_order_relaxed)),
+                                              std::memory_order_acquire, std::memory_order_acquire));
+        return m;
+    }
+
+private:
+    [[nodiscard]] static uint32_t index_of(uint64_t head) noexcept { return static_cast<uint32_t>(head); }
+
+    // Next tag, new top index.
+    [[nodiscard]] static uint64_t bump(uint64_t head, uint32_t index) noexcept {
+        return (((head >> 32) + 1) << 32) | index;
+    }
+
+    alignas(cpu::cacheline_size) std::atomic<uint64_t> head_{0};
+};
+
+/** @brief One thread's pair of magazines for one pool (Bonwick's loaded/previous scheme). */
+struct thread_cache_t {
+    uint64_t pool_id = 0;
+    magazine_t *loaded = nullptr;
+    magazine_t *previous = nullptr;
+};
+
+/** @brief Live pools by id, so exiting threads only flush into pools that still exist. */
+struct slab_registry {
+    std::mutex mutex;
+    std::unordered_map<uint64_t, slab_pool *> live;
+    std::atomic<uint64_t> next_id{1};
+    std::atomic<uint64_t> generation{0}; ///< Bumped whenever a pool is destroyed
+
+    [[nodiscard]] static slab_registry &get() {
+        static slab_registry *registry = new slab_registry; // leaked: outlives every thread_local
+        return *registry;
+    }
+};
+
+/** @brief The calling thread's caches, flushed back to their pools at thread exit. */
+struct thread_caches {
+    std::vector<thread_cache_t> caches;
+    std::size_t last = 0;
+    uint64_t generation = 0; ///< slab_registry::generation when caches last held only live pools
+    static inline thread_local bool exited = false; // trivially destructible, so readable after ~thread_caches
+    ~thread_caches();
+
+    /** @brief Drops the caches of pools destroyed since the last call; their magazines died with the pool. */
+    void prune() {
+        auto &registry = slab_registry::get();
+        if (registry.generation.load(std::memory_order_acquire) == generation) return;
+        std::lock_guard lock(registry.mutex);
+        std::erase_if(caches, [&](const thread_cache_t &c) { return !registry.live.contains(c.pool_id); });
+        generation = registry.generation.load(std::memory_order_relaxed);
+        last = 0;
+    }
+
+    [[nodiscard]] static thread_caches &get() {
+        thread_local thread_caches tls;
+        return tls;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Allocator for objects of one size.
+ * * Hot path: a pop from (or push to) the calling thread's loaded magazine, without atomics. When the
+ * magazine runs empty or full, whole magazines are exchanged with the pool's depot, so objects
+ * freed by one thread are reused by others in batches. New slabs are carved under a mutex only when the
+ * depot is empty. Memory goes back to the OS only when the pool is destroyed.
+ * @note The pool must outlive every object it handed out. Its magazines, including those still cached by
+ * other threads, are freed with it; those threads drop their stale caches on their next cache miss.
+ */
+class slab_pool {
+public:
+    /**
+     * @param object_size Size of each object.
+     * @param alignment Alignment of each object (a power of two, at most the page size).
+     */
+    explicit slab_pool(std::size_t object_size, std::size_t alignment = alignof(std::max_align_t),
+                       const slab_options_t &options = {})
+        : options_(options) {
+        if (alignment < alignof(void *)) alignment = alignof(void *);
+        if (object_size < sizeof(void *)) object_size = sizeof(void *);
+        stride_ = (object_size + alignment - 1) / alignment * alignment;
+        if (options_.magazine_size == 0) options_.magazine_size = 1;
+        auto &registry = detail::slab_registry::get();
+        std::lock_guard lock(registry.mutex);
+        id_ = registry.next_id.fetch_add(1, std::memory_order_relaxed);
+        registry.live.emplace(id_, this);
+    }
+
+    slab_pool(const slab_pool &) = delete;
+    slab_pool &operator=(const slab_pool &) = delete;
+
+    ~slab_pool() {
+        {
+            auto &registry = detail::slab_registry::get();
+            std::lock_guard lock(registry.mutex);
+            registry.live.erase(id_);
+            registry.generation.fetch_add(1, std::memory_order_release);
+        }
+        // A static pool dies after the main thread's caches, which already flushed into the depot.
+        if (!detail::thread_caches::exited) detail::thread_caches::get().prune();
+        std::lock_guard lock(slab_mutex_);
+        for (void *slab : slabs_) unmap_pages(slab, slab_bytes(), page_options());
+    }
+
+    /** @brief Returns storage for one object, or nullptr if a new slab could not be mapped. */
+    [[nodiscard]] void *allocate() {
+        detail::thread_cache_t &c = cache();
+        if (c.loaded->count == 0) {
+            if (c.previous && c.previous->count) {
+                std::swap(c.loaded, c.previous);
+            } else if (detail::magazine_t *full = full_.pop(magazines_)) {
+                depot_full_.fetch_sub(1, std::memory_order_relaxed);
+                if (c.previous) empty_.push(c.previous);
+                c.previous = c.loaded;
+                c.loaded = full;
+            } else if (!refill(*c.loaded)) {
+                return nullptr;
+            }
+        }
+        return c.loaded->items()[--c.loaded->count];
+    }
+
+    /** @brief Returns an object to the calling thread's cache. Any thread may free any object. */
+    void deallocate(void *p) {
+        if (!p) return;
+        detail::thread_cache_t &c = cache();
+        if (c.loaded->count == options_.magazine_size) {
+            if (c.previous && c.previous->count == 0) {
+                std::swap(c.loaded, c.previous);
+            } else {
+                if (c.previous) {
+                    full_.push(c.previous);
+                    depot_full_.fetch_add(1, std::memory_order_relaxed);
+                }
+                c.previous = c.loaded;
+                c.loaded = empty_magazine();
+            }
+        }
+        c.loaded->items()[c.loaded->count++] = p;
+    }
+
+    /** @brief Stride between objects. */
+    [[nodiscard]] std::size_t object_size() const noexcept { return stride_; }
+
+    /** @brief Approximate counters (takes the slab mutex). */
+    [[nodiscard]] slab_stats_t stats() {
+        slab_stats_t s{};
+        s.object_size = stride_;
+        s.depot_full = depot_full_.load(std::memory_order_relaxed);
+        std::lock_guard lock(slab_mutex_);
+        s.slab_count = slabs_.size();
+        s.bytes_reserved = slabs_.size() * slab_bytes();
+        return s;
+    }
+
+private:
+    friend struct detail::thread_caches;
+
+    [[nodiscard]] page_options_t page_options() const noexcept {
+        return {.huge = options_.huge_pages, .numa_local = options_.numa_local};
+    }
+
+    [[nodiscard]] std::size_t slab_bytes() const noexcept {
+        std::size_t want = options_.slab_size > stride_ + cpu::cacheline_size ? options_.slab_size
+                                                                                : stride_ + cpu::cacheline_size;
+        return round_to_pages(want, page_options());
+    }
+
+    // Finds (or creates) the calling thread's cache for this pool.
+    [[nodiscard]] detail::thread_cache_t &cache() {
+        auto &tls = detail::thread_caches::get();
+        if (tls.last < tls.caches.size() && tls.caches[tls.last].pool_id == id_) return tls.caches[tls.last];
+        tls.prune();
+        for (std::size_t i = 0; i < tls.caches.size(); ++i) {
+            if (tls.caches[i].pool_id == id_) return tls.caches[tls.last = i];
+        }
+        tls.caches.push_back({id_, empty_magazine(), nullptr});
+        return tls.caches[tls.last = tls.caches.size() - 1];
+    }
+
+    [[nodiscard]] detail::magazine_t *empty_magazine() {
+        if (detail::magazine_t *m = empty_.pop(magazines_)) return m;
+        return magazines_.create(options_.magazine_size);
+    }
+
+    // Fills an empty magazine with fresh objects, carving a new slab when the current one is used up.
+    bool refill(detail::magazine_t &m) {
+        std::lock_guard lock(slab_mutex_);
+        while (m.count < options_.magazine_size) {
+            if (carve_next_ + stride_ > carve_end_) {
+                std::size_t bytes = slab_bytes();
+                auto *slab = static_cast<std::byte *>(map_pages(bytes, page_options()));
+                if (!slab) break;
+                slabs_.push_back(slab);
+                carve_next_ = slab;
+                carve_end_ = slab + bytes;
+            }
+            m.items()[m.count++] = carve_next_;
+            carve_next_ += stride_;
+        }
+        return m.count > 0;
+    }
+
+    // Called with the registry mutex held, from a thread that is exiting.
+    void flush(detail::thread_cache_t &c) noexcept {
+        for (detail::magazine_t *m : {c.loaded, c.previous}) {
+            if (!m) continue;
+            if (m->count) {
+                full_.push(m);
+                depot_full_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                empty_.push(m);
+            }
+        }
+        c = {};
+    }
+
+    slab_options_t options_;
+    std::size_t stride_ = 0;
+    uint64_t id_ = 0;
+
+    detail::magazine_table magazines_;
+    detail::magazine_stack full_;
+    detail::magazine_stack empty_;
+    std::atomic<std::size_t> depot_full_{0};
+
+    std::mutex slab_mutex_;
+    std::vector<void *> slabs_;
+    std::byte *carve_next_ = nullptr;
+    std::byte *carve_end_ = nullptr;
+};
+
+inline detail::thread_caches::~thread_caches() {
+    exited = true;
+    auto &registry = slab_registry::get();
+    std::lock_guard lock(registry.mutex);
+    for (auto &c : caches) {
+        if (c.pool_id == 0) continue;
+        auto it = registry.live.find(c.pool_id);
+        if (it != registry.live.end()) it->second->flush(c); // a dead pool already freed its magazines
+    }
+}
+
+/**
+ * @brief Typed front end of slab_pool.
+ * @tparam T Object type; storage is aligned to alignof(T).
+ */
+template <class T> class object_pool {
+public:
+    explicit object_pool(const slab_options_t &options = {}) : pool_(sizeof(T), alignof(T), options) {}
+
+    /** @brief Allocates and constructs a T, or returns nullptr if memory is exhausted. */
+    template <class... Args> [[nodiscard]] T *make(Args &&...args) {
+        void *p = pool_.allocate();
+        return p ? ::new (p) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    /** @brief Destroys and frees an object obtained from make(). */
+    void destroy(T *p) {
+        if (!p) return;
+        p->~T();
+        pool_.deallocate(p);
+    }
+
+    /** @brief The underlying untyped pool. */
+    [[nodiscard]] slab_pool &pool() noexcept { return pool_; }
+
+private:
+    slab_pool pool_;
+};
+
+} // namespace saburou::platform::v2::memory
+
+/**
+ * @brief std::formatter specialization for slab_stats_t.
+ * Supported format specifiers: {} or {:s} for a compact summary, {:r} for full technical representation.
+ */
+template <> struct std::formatter<saburou::platform::v2::memory::slab_stats_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for slab_stats_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::memory::slab_stats_t &s, std::format_context &ctx) const {
+        if (repr) {
+            return std::format_to(ctx.out(), "slab_stats(object_size={}, slab_count={}, bytes_reserved={}, depot_full={})",
+                                  s.object_size, s.slab_count, s.bytes_reserved, s.depot_full);
+        }
+        return std::format_to(ctx.out(), "slab_stats({}B objects, {} slabs, {} bytes)", s.object_size, s.slab_count,
+                              s.bytes_reserved);
+    }
+};
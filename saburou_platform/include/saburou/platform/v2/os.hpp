@@ -2,7 +2,8 @@
  * @file os.hpp
  * @brief Main umbrella header for operating system abstraction layers.
  *
- * This header provides access to OS family, type, and runtime info queries.
+ * This header provides access to OS family, type, runtime info, process resource queries and
+ * virtualization detection.
  * Note: Platform-specific headers (like linux.hpp) are excluded to maintain 
  * a generic interface and must be included explicitly if needed.
  */
@@ -11,4 +12,6 @@
 
 #include <saburou/platform/v2/os/family.hpp> // IWYU pragma: export
 #include <saburou/platform/v2/os/info.hpp>   // IWYU pragma: export
+#include <saburou/platform/v2/os/process.hpp> // IWYU pragma: export
 #include <saburou/platform/v2/os/type.hpp>   // IWYU pragma: export
+#include <saburou/platform/v2/os/virt.hpp>   // IWYU pragma: export
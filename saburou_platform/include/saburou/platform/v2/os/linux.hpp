@@ -1,9 +1,13 @@
 /**
  * @file linux.hpp
- * @brief Umbrella header for Linux-specific distribution details.
+ * @brief Umbrella header for Linux-specific distribution details, kernel features, block devices and
+ * pseudo-file readers.
  */
 
 #pragma once
 
+#include <saburou/platform/v2/os/linux/block.hpp>  // IWYU pragma: export
 #include <saburou/platform/v2/os/linux/distro.hpp> // IWYU pragma: export
+#include <saburou/platform/v2/os/linux/kernel.hpp> // IWYU pragma: export
+#include <saburou/platform/v2/os/linux/procfs.hpp> // IWYU pragma: export
 #include <saburou/platform/v2/os/linux/types.hpp>  // IWYU pragma: export
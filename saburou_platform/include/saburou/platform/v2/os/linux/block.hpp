@@ -0,0 +1,9 @@
+/**
+ * @file block.hpp
+ * @brief Umbrella header for block device characteristics queries.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/os/linux/block/types.hpp> // IWYU pragma: export
+#include <saburou/platform/v2/os/linux/block/query.hpp> // IWYU pragma: export
@@ -0,0 +1,113 @@
+/**
+ * @file query.hpp
+ * @brief Maps a path to its backing block device and reads the device queue limits from sysfs.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+#include <saburou/platform/v2/os/linux/block/types.hpp>
+#include <saburou/platform/v2/os/linux/procfs/parse.hpp>
+#include <saburou/platform/v2/os/linux/procfs/reader.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if SABUROU_PLATFORM_V2_OS_LINUX
+#include <filesystem>
+#include <system_error>
+
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#endif
+
+namespace saburou::platform::v2::os::linux {
+
+#if SABUROU_PLATFORM_V2_OS_LINUX
+namespace detail {
+
+/** @brief Reads one numeric attribute from a sysfs directory (0 if missing). */
+[[nodiscard]] inline uint32_t read_u32(const std::string &dir, std::string_view name) {
+    procfs::file_reader reader(dir + "/" + std::string(name), 64);
+    uint32_t value = 0;
+    (void)procfs::parse_number(procfs::trim(reader.read()), value);
+    return value;
+}
+
+/** @brief Picks the active scheduler out of "none [mq-deadline] kyber". */
+[[nodiscard]] constexpr std::string_view active_scheduler(std::string_view text) noexcept {
+    auto open = text.find('[');
+    auto close = text.find(']', open);
+    if (open == std::string_view::npos || close == std::string_view::npos) return procfs::trim(text);
+    return text.substr(open + 1, close - open - 1);
+}
+
+/** @brief Classifies a disk from its kernel name and rotational flag. */
+[[nodiscard]] constexpr device_kind_t classify(std::string_view name, bool rotational) noexcept {
+    if (name.starts_with("nvme")) return device_kind_t::nvme;
+    if (name.starts_with("loop")) return device_kind_t::loop;
+    if (name.starts_with("zram") || name.starts_with("ram") || name.starts_with("pmem")) return device_kind_t::ram;
+    if (name.starts_with("nbd") || name.starts_with("rbd") || name.starts_with("drbd")) return device_kind_t::network;
+    if (name.starts_with("vd") || name.starts_with("xvd")) return device_kind_t::virtio;
+    return rotational ? device_kind_t::hdd : device_kind_t::ssd;
+}
+
+} // namespace detail
+#endif
+
+/**
+ * @brief Describes the block device that stores @p path.
+ * * st_dev of the path selects /sys/dev/block/<major>:<minor>; for partitions the parent disk's queue is
+ * used, since queue limits only exist per disk. Device-mapper and md devices report their own (stacked)
+ * limits.
+ * @param path Any file or directory.
+ * @param root Filesystem root for sysfs lookups (tests can point it at a fixture tree).
+ * @return A block_device_t; is_valid() is false for filesystems without a backing device (tmpfs,
+ * overlayfs, FUSE) and on non-Linux builds.
+ * @note Performs a stat() and about ten small sysfs reads: cache the result per file or mount.
+ */
+[[nodiscard]] inline block_device_t block_device_info(const std::string &path, const procfs::root_t &root = {}) {
+    block_device_t b{};
+#if SABUROU_PLATFORM_V2_OS_LINUX
+    namespace fs = std::filesystem;
+    struct stat st{};
+    if (::stat(path.c_str(), &st) != 0) return b;
+    // Block devices opened directly describe themselves; anything else lives on st_dev.
+    dev_t dev = S_ISBLK(st.st_mode) ? st.st_rdev : st.st_dev;
+    b.major = major(dev);
+    b.minor = minor(dev);
+    if (b.major == 0) return b; // anonymous device: tmpfs, overlayfs, btrfs subvolumes, FUSE, ...
+
+    std::error_code ec;
+    fs::path link = root.resolve("sys/dev/block/" + std::to_string(b.major) + ":" + std::to_string(b.minor));
+    fs::path device = fs::canonical(link, ec);
+    if (ec) return b;
+    if (fs::exists(device / "partition", ec)) {
+        b.partition = device.filename().string();
+        device = device.parent_path();
+    }
+    std::string queue = (device / "queue").string();
+    if (!fs::is_directory(queue, ec)) return b;
+
+    b.name = device.filename().string();
+    b.rotational = detail::read_u32(queue, "rotational") != 0;
+    b.nr_requests = detail::read_u32(queue, "nr_requests");
+    b.max_sectors_kb = detail::read_u32(queue, "max_sectors_kb");
+    b.read_ahead_kb = detail::read_u32(queue, "read_ahead_kb");
+    b.optimal_io_size = detail::read_u32(queue, "optimal_io_size");
+    b.minimum_io_size = detail::read_u32(queue, "minimum_io_size");
+    b.logical_block_size = detail::read_u32(queue, "logical_block_size");
+    b.physical_block_size = detail::read_u32(queue, "physical_block_size");
+
+    procfs::file_reader scheduler(queue + "/scheduler", 128);
+    b.scheduler = std::string(detail::active_scheduler(procfs::trim(scheduler.read())));
+    b.kind = detail::classify(b.name, b.rotational);
+#else
+    (void)path;
+    (void)root;
+#endif
+    return b;
+}
+
+} // namespace saburou::platform::v2::os::linux
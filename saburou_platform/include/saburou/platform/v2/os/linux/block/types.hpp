@@ -0,0 +1,151 @@
+/**
+ * @file types.hpp
+ * @brief Block device characteristics structures and formatters.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/core.hpp>
+
+#include <cstdint>
+#include <format>
+#include <string>
+
+namespace saburou::platform::v2::os::linux {
+
+/**
+ * @brief Coarse class of the device backing a file, used to pick I/O defaults.
+ */
+enum class device_kind_t : uint8_t {
+    unknown, // No block device (tmpfs, procfs, overlay/FUSE anonymous devices) or unreadable sysfs
+    hdd,     // Rotational disk
+    ssd,     // Non-rotational SATA/SAS/eMMC/UFS device
+    nvme,    // NVMe namespace
+    virtio,  // Paravirtual disk (virtio-blk, Xen blkfront); real media unknown
+    network, // Network block device (nbd, rbd, iSCSI-backed dm)
+    loop,    // Loop device on top of a file
+    ram      // Memory-backed (zram, brd, pmem)
+};
+
+/**
+ * @brief Queue limits and geometry of the block device backing a path.
+ * * Sizes come straight from /sys/block/<disk>/queue; partitions report the queue of their disk.
+ */
+struct block_device_t {
+    std::string name;                  ///< Kernel device name of the disk (e.g., "nvme0n1", "sda")
+    std::string partition;             ///< Partition name when the path lives on one (e.g., "nvme0n1p2")
+    uint32_t major = 0;                ///< Device major number
+    uint32_t minor = 0;                ///< Device minor number
+    device_kind_t kind = device_kind_t::unknown;
+    bool rotational = false;           ///< queue/rotational
+    uint32_t nr_requests = 0;          ///< queue/nr_requests: per-queue request slots (queue depth hint)
+    uint32_t max_sectors_kb = 0;       ///< queue/max_sectors_kb: largest single request, in KiB
+    uint32_t read_ahead_kb = 0;        ///< queue/read_ahead_kb
+    uint32_t optimal_io_size = 0;      ///< queue/optimal_io_size in bytes (0 = not reported)
+    uint32_t minimum_io_size = 0;      ///< queue/minimum_io_size in bytes
+    uint32_t logical_block_size = 0;   ///< queue/logical_block_size in bytes
+    uint32_t physical_block_size = 0;  ///< queue/physical_block_size in bytes
+    std::string scheduler;             ///< Active I/O scheduler (e.g., "none", "mq-deadline")
+
+    /** @brief True if a block device was found for the path. */
+    [[nodiscard]] bool is_valid() const noexcept { return !name.empty(); }
+
+    /** @brief Largest request the device accepts in one go, in bytes (0 if unknown). */
+    [[nodiscard]] uint64_t max_io_bytes() const noexcept { return uint64_t{max_sectors_kb} * 1024; }
+
+    /**
+     * @brief Suggested number of requests to keep in flight.
+     * * Rotational disks gain little beyond the NCQ depth (32); everything else can use the full queue.
+     * @return At least 1; 32 when the device is unknown.
+     */
+    [[nodiscard]] uint32_t suggested_queue_depth() const noexcept {
+        uint32_t depth = nr_requests ? nr_requests : 32;
+        if (kind == device_kind_t::hdd && depth > 32) depth = 32;
+        return depth;
+    }
+
+    /**
+     * @brief Suggested size of each request, in bytes.
+     * * The optimal I/O size when reported, else max_sectors_kb, capped at 1 MiB and at least the physical block.
+     */
+    [[nodiscard]] uint64_t suggested_io_bytes() const noexcept {
+        uint64_t size = optimal_io_size ? optimal_io_size : max_io_bytes();
+        if (size == 0 || size > (uint64_t{1} << 20)) size = uint64_t{1} << 20;
+        if (size < physical_block_size) size = physical_block_size;
+        return size;
+    }
+};
+
+/**
+ * @brief Converts a device_kind_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(device_kind_t k) {
+    switch (k) {
+    case device_kind_t::hdd:     return "hdd";
+    case device_kind_t::ssd:     return "ssd";
+    case device_kind_t::nvme:    return "nvme";
+    case device_kind_t::virtio:  return "virtio";
+    case device_kind_t::network: return "network";
+    case device_kind_t::loop:    return "loop";
+    case device_kind_t::ram:     return "ram";
+    default:                     return "unknown";
+    }
+}
+
+} // namespace saburou::platform::v2::os::linux
+
+/**
+ * @brief std::formatter specialization for device_kind_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "device_kind_t::nvme").
+ */
+template <> struct std::formatter<saburou::platform::v2::os::linux::device_kind_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::os::linux::device_kind_t &k, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::os::linux::to_code_name(k);
+        return repr ? std::format_to(ctx.out(), "device_kind_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
+
+/**
+ * @brief std::formatter specialization for block_device_t.
+ * Supported format specifiers: {} or {:s} for a compact summary, {:r} for full technical representation.
+ */
+template <> struct std::formatter<saburou::platform::v2::os::linux::block_device_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for block_device_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::os::linux::block_device_t &b, std::format_context &ctx) const {
+        if (repr) {
+            return std::format_to(ctx.out(),
+                                  "block_device(name={}, partition={}, dev={}:{}, kind={:r}, rotational={}, "
+                                  "nr_requests={}, max_sectors_kb={}, read_ahead_kb={}, optimal_io_size={}, "
+                                  "minimum_io_size={}, logical_block_size={}, physical_block_size={}, scheduler={})",
+                                  b.name, b.partition, b.major, b.minor, b.kind, b.rotational, b.nr_requests,
+                                  b.max_sectors_kb, b.read_ahead_kb, b.optimal_io_size, b.minimum_io_size,
+                                  b.logical_block_size, b.physical_block_size, b.scheduler);
+        }
+        if (!b.is_valid()) return std::format_to(ctx.out(), "block_device(none)");
+        return std::format_to(ctx.out(), "block_device({} {}, depth={}, max_io={}KiB, block={}/{}, scheduler={})",
+                              b.name, b.kind, b.nr_requests, b.max_sectors_kb, b.logical_block_size,
+                              b.physical_block_size, b.scheduler);
+    }
+};
@@ -0,0 +1,9 @@
+/**
+ * @file kernel.hpp
+ * @brief Umbrella header for Linux kernel fast-path syscall probing.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/os/linux/kernel/types.hpp> // IWYU pragma: export
+#include <saburou/platform/v2/os/linux/kernel/query.hpp> // IWYU pragma: export
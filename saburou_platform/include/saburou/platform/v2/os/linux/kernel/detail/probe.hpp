@@ -0,0 +1,387 @@
+/**
+ * @file probe.hpp
+ * @brief Raw-syscall probes behind kernel_features().
+ *
+ * Every probe issues the real syscall with arguments the kernel rejects cheaply (or creates and
+ * immediately closes a throwaway object), then classifies errno:
+ * - ENOSYS: the kernel (or a seccomp filter returning ENOSYS) does not provide it.
+ * - EPERM/EACCES: present but forbidden by policy.
+ * - anything else (EINVAL, EBADF, ...): the entry point exists and validated our arguments.
+ *
+ * When a seccomp filter is installed, a disallowed syscall may kill the caller instead of failing,
+ * so probes can run in a short-lived forked child and report back through a pipe.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/cpu/detail/rseq.hpp>
+#include <saburou/platform/v2/detect.hpp>
+#include <saburou/platform/v2/os/linux/kernel/types.hpp>
+#include <saburou/platform/v2/os/linux/procfs/parse.hpp>
+#include <saburou/platform/v2/os/linux/procfs/reader.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// io_uring_params::features and IORING_FEAT_SINGLE_MMAP need the 5.4 uapi; everything newer that is used
+// (IORING_OP_READ/WRITE, IORING_SETUP_CLAMP, the opcode probe) is defined in uring_abi below, so 5.4 and 5.5
+// headers (Ubuntu 20.04, RHEL 8) still compile.
+#if __has_include(<linux/io_uring.h>) && __has_include(<linux/version.h>)
+#include <linux/version.h>
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0)
+#include <linux/io_uring.h>
+#define SABUROU_PLATFORM_V2_HAS_IO_URING_UAPI 1
+#endif
+#endif
+#ifndef SABUROU_PLATFORM_V2_HAS_IO_URING_UAPI
+#define SABUROU_PLATFORM_V2_HAS_IO_URING_UAPI 0
+#endif
+
+#if __has_include(<linux/membarrier.h>)
+#include <linux/membarrier.h>
+#define SABUROU_PLATFORM_V2_HAS_MEMBARRIER_UAPI 1
+#else
+#define SABUROU_PLATFORM_V2_HAS_MEMBARRIER_UAPI 0
+#endif
+
+// Syscalls added since 5.1 share one number on every architecture except alpha. Older C library
+// headers may not know them yet.
+#if !defined(__alpha__)
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+#ifndef __NR_pidfd_open
+#define __NR_pidfd_open 434
+#endif
+#ifndef __NR_clone3
+#define __NR_clone3 435
+#endif
+#ifndef __NR_futex_waitv
+#define __NR_futex_waitv 449
+#endif
+#endif
+
+namespace saburou::platform::v2::os::linux::detail {
+
+/** @brief io_uring ABI added in Linux 5.6, with the values of <linux/io_uring.h>. */
+namespace uring_abi {
+
+inline constexpr uint8_t op_read = 22;             ///< IORING_OP_READ
+inline constexpr uint8_t op_write = 23;            ///< IORING_OP_WRITE
+inline constexpr uint32_t setup_clamp = 1u << 4;   ///< IORING_SETUP_CLAMP
+inline constexpr unsigned register_probe = 8;      ///< IORING_REGISTER_PROBE
+inline constexpr uint16_t op_supported = 1u << 0;  ///< IO_URING_OP_SUPPORTED
+
+/** @brief struct io_uring_probe_op. */
+struct probe_op_t {
+    uint8_t op;
+    uint8_t resv;
+    uint16_t flags;
+    uint32_t resv2;
+};
+
+/** @brief struct io_uring_probe, followed in memory by ops_len probe_op_t. */
+struct probe_t {
+    uint8_t last_op;
+    uint8_t ops_len;
+    uint16_t resv;
+    uint32_t resv2[3];
+};
+
+} // namespace uring_abi
+
+/** @brief How probes are shielded from seccomp filters that kill instead of failing. */
+enum class isolation_t : uint8_t {
+    automatic, // Fork per probe only when /proc/self/status reports a seccomp filter
+    always,    // Always fork per probe
+    never      // Probe in-process (fastest; unsafe under SECCOMP_RET_KILL policies)
+};
+
+/** @brief Classifies the errno of a failed probe syscall. */
+[[nodiscard]] constexpr support_t from_errno(int err) noexcept {
+    switch (err) {
+    case ENOSYS: return support_t::unsupported;
+    case EPERM:
+    case EACCES: return support_t::denied;
+    default:     return support_t::supported;
+    }
+}
+
+/** @brief True if a known kernel version is older than major.minor. */
+[[nodiscard]] constexpr bool older_than(const version_t &v, int major, int minor) noexcept {
+    if (v.major == 0) return false; // unknown version: let the syscall decide
+    return v.major < major || (v.major == major && v.minor < minor);
+}
+
+/** @brief True if /proc/self/status reports seccomp filter mode (2). */
+[[nodiscard]] inline bool seccomp_filtered() {
+    procfs::file_reader status("/proc/self/status");
+    int mode = 0;
+    return procfs::parse_number(procfs::find_value(status.read(), "Seccomp"), mode) && mode == 2;
+}
+
+inline void probe_io_uring(kernel_features_t &k) {
+#if SABUROU_PLATFORM_V2_HAS_IO_URING_UAPI && defined(__NR_io_uring_setup)
+    if (older_than(k.kernel, 5, 1)) {
+        k.io_uring = support_t::unsupported;
+        return;
+    }
+    io_uring_params params{};
+    long fd = ::syscall(__NR_io_uring_setup, 1, &params);
+    if (fd < 0) {
+        k.io_uring = from_errno(errno);
+        return;
+    }
+    k.io_uring = support_t::supported;
+    k.io_uring_features = params.features;
+
+    // Kernels before 5.6 reject the probe with EINVAL and leave io_uring_ops empty.
+    constexpr std::size_t max_ops = 256;
+    struct {
+        uring_abi::probe_t head;
+        uring_abi::probe_op_t ops[max_ops];
+    } probe{};
+    if (::syscall(__NR_io_uring_register, static_cast<int>(fd), uring_abi::register_probe, &probe, max_ops) == 0) {
+        for (std::size_t i = 0; i < probe.head.ops_len && i < max_ops; ++i)
+            if (probe.ops[i].flags & uring_abi::op_supported) k.io_uring_ops.set(probe.ops[i].op);
+    }
+    ::close(static_cast<int>(fd));
+#else
+    (void)k;
+#endif
+}
+
+inline void probe_rseq(kernel_features_t &k) {
+#if SABUROU_PLATFORM_V2_CPU_RSEQ
+    if (__rseq_size > 0) {
+        k.rseq = support_t::supported;
+        k.rseq_registered = true;
+        return;
+    }
+#endif
+#if defined(__NR_rseq)
+    if (older_than(k.kernel, 4, 18)) {
+        k.rseq = support_t::unsupported;
+        return;
+    }
+    // A NULL area with zero length is rejected with EINVAL by any kernel that implements rseq.
+    k.rseq = ::syscall(__NR_rseq, nullptr, 0, 0, 0) == 0 ? support_t::supported : from_errno(errno);
+#else
+    (void)k;
+#endif
+}
+
+inline void probe_membarrier(kernel_features_t &k) {
+#if SABUROU_PLATFORM_V2_HAS_MEMBARRIER_UAPI && defined(__NR_membarrier)
+    if (older_than(k.kernel, 4, 3)) {
+        k.membarrier = support_t::unsupported;
+        return;
+    }
+    long mask = ::syscall(__NR_membarrier, MEMBARRIER_CMD_QUERY, 0, 0);
+    if (mask < 0) {
+        k.membarrier = from_errno(errno);
+        return;
+    }
+    k.membarrier = support_t::supported;
+    k.membarrier_cmds = static_cast<uint32_t>(mask);
+#else
+    (void)k;
+#endif
+}
+
+inline void probe_memfd_create(kernel_features_t &k) {
+#if defined(__NR_memfd_create)
+    if (older_than(k.kernel, 3, 17)) {
+        k.memfd_create = support_t::unsupported;
+        return;
+    }
+    long fd = ::syscall(__NR_memfd_create, "saburou-probe", 1u /* MFD_CLOEXEC */);
+    if (fd < 0) {
+        k.memfd_create = from_errno(errno);
+        return;
+    }
+    ::close(static_cast<int>(fd));
+    k.memfd_create = support_t::supported;
+#else
+    (void)k;
+#endif
+}
+
+inline void probe_copy_file_range(kernel_features_t &k) {
+#if defined(__NR_copy_file_range)
+    if (older_than(k.kernel, 4, 5)) {
+        k.copy_file_range = support_t::unsupported;
+        return;
+    }
+    // Raw syscall: some C libraries used to emulate copy_file_range in user space.
+    k.copy_file_range = ::syscall(__NR_copy_file_range, -1, nullptr, -1, nullptr, 0, 0u) == 0 ? support_t::supported
+                                                                                               : from_errno(errno);
+#else
+    (void)k;
+#endif
+}
+
+inline void probe_pidfd_open(kernel_features_t &k) {
+#if defined(__NR_pidfd_open)
+    if (older_than(k.kernel, 5, 3)) {
+        k.pidfd_open = support_t::unsupported;
+        return;
+    }
+    long fd = ::syscall(__NR_pidfd_open, ::getpid(), 0u);
+    if (fd < 0) {
+        k.pidfd_open = from_errno(errno);
+        return;
+    }
+    ::close(static_cast<int>(fd));
+    k.pidfd_open = support_t::supported;
+#else
+    (void)k;
+#endif
+}
+
+inline void probe_futex_waitv(kernel_features_t &k) {
+#if defined(__NR_futex_waitv)
+    if (older_than(k.kernel, 5, 16)) {
+        k.futex_waitv = support_t::unsupported;
+        return;
+    }
+    // An empty wait vector is rejected with EINVAL.
+    k.futex_waitv =
+        ::syscall(__NR_futex_waitv, nullptr, 0u, 0u, nullptr, 0) == 0 ? support_t::supported : from_errno(errno);
+#else
+    (void)k;
+#endif
+}
+
+inline void probe_clone3(kernel_features_t &k) {
+#if defined(__NR_clone3)
+    if (older_than(k.kernel, 5, 3)) {
+        k.clone3 = support_t::unsupported;
+        return;
+    }
+    // size 0 is below CLONE_ARGS_SIZE_VER0, so the kernel fails with EINVAL before creating anything.
+    k.clone3 = ::syscall(__NR_clone3, nullptr, std::size_t{0}) == 0 ? support_t::supported : from_errno(errno);
+#else
+    (void)k;
+#endif
+}
+
+inline void probe_madvise(kernel_features_t &k) {
+    const long page = ::sysconf(_SC_PAGESIZE);
+    const std::size_t len = page > 0 ? static_cast<std::size_t>(page) : 4096;
+    void *p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return;
+    auto accepts = [&](int advice) { return ::madvise(p, len, advice) == 0; };
+    madvise_support_t &m = k.madvise;
+    m.free = accepts(8);            // MADV_FREE
+    m.hugepage = accepts(14);       // MADV_HUGEPAGE
+    m.cold = accepts(20);           // MADV_COLD
+    m.pageout = accepts(21);        // MADV_PAGEOUT
+    m.populate_read = accepts(22);  // MADV_POPULATE_READ
+    m.populate_write = accepts(23); // MADV_POPULATE_WRITE
+    m.collapse = accepts(25);       // MADV_COLLAPSE
+    ::munmap(p, len);
+}
+
+/**
+ * @brief Runs a probe in a forked child and copies its view of the result back.
+ * @param k In: current results. Out: results as updated by the child.
+ * @param probe Function that updates k.
+ * @param status Field to mark as denied if the child is killed (e.g., SIGSYS from seccomp), or nullptr.
+ * @return False if isolation itself failed (pipe/fork unavailable); k is then left untouched.
+ */
+inline bool run_isolated(kernel_features_t &k, void (*probe)(kernel_features_t &),
+                         support_t kernel_features_t::*status) {
+    static_assert(std::is_trivially_copyable_v<kernel_features_t>);
+    int fds[2];
+    if (::pipe2(fds, O_CLOEXEC) != 0) return false;
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        ::close(fds[0]);
+        kernel_features_t child = k;
+        probe(child);
+        const auto *src = reinterpret_cast<const unsigned char *>(&child);
+        std::size_t done = 0;
+        while (done < sizeof(child)) {
+            ssize_t n = ::write(fds[1], src + done, sizeof(child) - done);
+            if (n <= 0) ::_exit(1);
+            done += static_cast<std::size_t>(n);
+        }
+        ::_exit(0);
+    }
+    ::close(fds[1]);
+    kernel_features_t result = k;
+    auto *dst = reinterpret_cast<unsigned char *>(&result);
+    std::size_t got = 0;
+    while (got < sizeof(result)) {
+        ssize_t n = ::read(fds[0], dst + got, sizeof(result) - got);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        got += static_cast<std::size_t>(n);
+    }
+    ::close(fds[0]);
+    int wstatus = 0;
+    while (::waitpid(pid, &wstatus, 0) < 0 && errno == EINTR) {
+    }
+    if (got == sizeof(result) && WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0) {
+        k = result;
+    } else if (WIFSIGNALED(wstatus) && status) {
+        k.*status = support_t::denied;
+    }
+    return true;
+}
+
+/**
+ * @brief Runs every probe, isolating them if requested or if a seccomp filter is present.
+ * @param kernel Kernel version used to skip syscalls that cannot exist.
+ * @param isolation Isolation policy.
+ */
+inline kernel_features_t probe_all(const version_t &kernel, isolation_t isolation) {
+    kernel_features_t k{};
+    k.kernel = kernel;
+    k.seccomp_filtered = seccomp_filtered();
+    const bool isolate =
+        isolation == isolation_t::always || (isolation == isolation_t::automatic && k.seccomp_filtered);
+
+    struct entry_t {
+        void (*probe)(kernel_features_t &);
+        support_t kernel_features_t::*status;
+    };
+    const entry_t probes[] = {
+        {probe_io_uring, &kernel_features_t::io_uring},
+        {probe_rseq, &kernel_features_t::rseq},
+        {probe_membarrier, &kernel_features_t::membarrier},
+        {probe_memfd_create, &kernel_features_t::memfd_create},
+        {probe_copy_file_range, &kernel_features_t::copy_file_range},
+        {probe_pidfd_open, &kernel_features_t::pidfd_open},
+        {probe_futex_waitv, &kernel_features_t::futex_waitv},
+        {probe_clone3, &kernel_features_t::clone3},
+        {probe_madvise, nullptr},
+    };
+    for (const auto &e : probes) {
+        // If isolation fails (no fork), the fields stay unknown rather than risking a kill in-process.
+        if (isolate)
+            run_isolated(k, e.probe, e.status);
+        else
+            e.probe(k);
+    }
+    return k;
+}
+
+} // namespace saburou::platform::v2::os::linux::detail
@@ -0,0 +1,53 @@
+/**
+ * @file query.hpp
+ * @brief Runtime availability queries for Linux fast-path syscalls.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+#include <saburou/platform/v2/os/info/query.hpp>
+#include <saburou/platform/v2/os/linux/kernel/types.hpp>
+
+#if SABUROU_PLATFORM_V2_OS_LINUX
+#include <saburou/platform/v2/os/linux/kernel/detail/probe.hpp>
+#endif
+
+namespace saburou::platform::v2::os::linux {
+
+#if SABUROU_PLATFORM_V2_OS_LINUX
+using detail::isolation_t;
+#else
+/** @brief How probes are shielded from seccomp filters (no effect outside Linux). */
+enum class isolation_t : uint8_t { automatic, always, never };
+#endif
+
+/**
+ * @brief Probes the running kernel for fast-path syscalls without caching.
+ * @param isolation Whether probes run in forked children. The default forks only when a seccomp filter is
+ * installed, so a SECCOMP_RET_KILL policy cannot take the process down.
+ * @return A kernel_features_t; on non-Linux builds every facility is support_t::unknown.
+ * @note The kernel version from os::info() filters out syscalls the kernel cannot have before any is issued.
+ */
+[[nodiscard]] inline kernel_features_t probe_kernel_features(isolation_t isolation = isolation_t::automatic) {
+#if SABUROU_PLATFORM_V2_OS_LINUX
+    return detail::probe_all(os::info().version, isolation);
+#else
+    (void)isolation;
+    kernel_features_t k{};
+    k.kernel = os::info().version;
+    return k;
+#endif
+}
+
+/**
+ * @brief Returns the kernel features of this process, probed once on first use.
+ * @return A reference to a process-wide, immutable kernel_features_t.
+ * @note Thread-safe. Fast paths should branch on this rather than on SABUROU_PLATFORM_V2_OS_LINUX alone.
+ */
+[[nodiscard]] inline const kernel_features_t &kernel_features() {
+    static const kernel_features_t cached = probe_kernel_features();
+    return cached;
+}
+
+} // namespace saburou::platform::v2::os::linux
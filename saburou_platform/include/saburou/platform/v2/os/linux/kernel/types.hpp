@@ -0,0 +1,165 @@
+/**
+ * @file types.hpp
+ * @brief Linux kernel fast-path syscall availability structures.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/core.hpp>
+#include <saburou/platform/v2/os/info/types.hpp>
+
+#include <bitset>
+#include <cstdint>
+#include <format>
+
+namespace saburou::platform::v2::os::linux {
+
+/**
+ * @brief Outcome of probing a single kernel facility.
+ * * Distinguishes "the kernel does not have it" from "a policy (seccomp, sysctl, LSM) forbids it", since
+ * the former is permanent for this host while the latter may differ between containers.
+ */
+enum class support_t : uint8_t {
+    unknown,     // Not probed (non-Linux build, missing headers, or isolation failed)
+    unsupported, // Kernel too old or ENOSYS/EINVAL from the syscall itself
+    denied,      // EPERM/EACCES: present but blocked by seccomp, sysctl or an LSM
+    supported    // Usable from this process
+};
+
+/**
+ * @brief madvise() advice values accepted by the running kernel.
+ */
+struct madvise_support_t {
+    bool free = false;           ///< MADV_FREE (4.5)
+    bool hugepage = false;       ///< MADV_HUGEPAGE (THP enabled)
+    bool cold = false;           ///< MADV_COLD (5.4)
+    bool pageout = false;        ///< MADV_PAGEOUT (5.4)
+    bool populate_read = false;  ///< MADV_POPULATE_READ (5.14)
+    bool populate_write = false; ///< MADV_POPULATE_WRITE (5.14)
+    bool collapse = false;       ///< MADV_COLLAPSE (6.1)
+};
+
+/**
+ * @brief Availability of fast-path kernel interfaces for the current process.
+ */
+struct kernel_features_t {
+    version_t kernel;                        ///< Kernel version used as first filter
+    bool seccomp_filtered = false;           ///< A seccomp filter is installed (probes ran isolated)
+
+    support_t io_uring = support_t::unknown; ///< io_uring_setup (5.1)
+    uint32_t io_uring_features = 0;          ///< IORING_FEAT_* bits reported by setup
+    std::bitset<256> io_uring_ops;           ///< Opcodes reported by IORING_REGISTER_PROBE (5.6)
+
+    support_t rseq = support_t::unknown;     ///< Restartable sequences (4.18)
+    bool rseq_registered = false;            ///< The C library already registered an rseq area
+
+    support_t membarrier = support_t::unknown; ///< membarrier (4.3)
+    uint32_t membarrier_cmds = 0;              ///< MEMBARRIER_CMD_* mask from MEMBARRIER_CMD_QUERY
+
+    support_t memfd_create = support_t::unknown;    ///< memfd_create (3.17)
+    support_t copy_file_range = support_t::unknown; ///< copy_file_range (4.5)
+    support_t pidfd_open = support_t::unknown;      ///< pidfd_open (5.3)
+    support_t futex_waitv = support_t::unknown;     ///< futex2 vectored wait (5.16)
+    support_t clone3 = support_t::unknown;          ///< clone3 (5.3)
+    madvise_support_t madvise;                      ///< Accepted madvise() advice
+
+    /** @brief True if io_uring is usable and the probe reported @p opcode. */
+    [[nodiscard]] bool has_io_uring_op(uint8_t opcode) const noexcept {
+        return io_uring == support_t::supported && io_uring_ops.test(opcode);
+    }
+
+    /** @brief True if MEMBARRIER_CMD_QUERY reported every bit of @p cmd_mask. */
+    [[nodiscard]] constexpr bool has_membarrier(uint32_t cmd_mask) const noexcept {
+        return membarrier == support_t::supported && (membarrier_cmds & cmd_mask) == cmd_mask;
+    }
+};
+
+/**
+ * @brief Converts a support_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(support_t s) {
+    switch (s) {
+    case support_t::unknown:     return "unknown";
+    case support_t::unsupported: return "unsupported";
+    case support_t::denied:      return "denied";
+    case support_t::supported:   return "supported";
+    default:                     return "unknown";
+    }
+}
+
+} // namespace saburou::platform::v2::os::linux
+
+/**
+ * @brief std::formatter specialization for support_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "support_t::denied").
+ */
+template <> struct std::formatter<saburou::platform::v2::os::linux::support_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::os::linux::support_t &s, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::os::linux::to_code_name(s);
+        return repr ? std::format_to(ctx.out(), "support_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
+
+/**
+ * @brief std::formatter specialization for kernel_features_t.
+ * Supported format specifiers: {} or {:s} lists only supported facilities, {:r} shows every field.
+ */
+template <> struct std::formatter<saburou::platform::v2::os::linux::kernel_features_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for kernel_features_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::os::linux::kernel_features_t &k, std::format_context &ctx) const {
+        using saburou::platform::v2::os::linux::support_t;
+        const auto &m = k.madvise;
+        if (repr) {
+            return std::format_to(
+                ctx.out(),
+                "kernel_features(kernel={:r}, seccomp_filtered={}, io_uring={:r}, io_uring_features={:#x}, "
+                "io_uring_ops={}, rseq={:r}, rseq_registered={}, membarrier={:r}, membarrier_cmds={:#x}, "
+                "memfd_create={:r}, copy_file_range={:r}, pidfd_open={:r}, futex_waitv={:r}, clone3={:r}, "
+                "madvise(free={}, hugepage={}, cold={}, pageout={}, populate_read={}, populate_write={}, "
+                "collapse={}))",
+                k.kernel, k.seccomp_filtered, k.io_uring, k.io_uring_features, k.io_uring_ops.count(), k.rseq,
+                k.rseq_registered, k.membarrier, k.membarrier_cmds, k.memfd_create, k.copy_file_range,
+                k.pidfd_open, k.futex_waitv, k.clone3, m.free, m.hugepage, m.cold, m.pageout, m.populate_read,
+                m.populate_write, m.collapse);
+        }
+        auto out = std::format_to(ctx.out(), "kernel_features({}:", k.kernel);
+        auto item = [&](bool on, const char *name) {
+            if (on) out = std::format_to(out, " {}", name);
+        };
+        item(k.io_uring == support_t::supported, "io_uring");
+        item(k.rseq == support_t::supported, "rseq");
+        item(k.membarrier == support_t::supported, "membarrier");
+        item(k.memfd_create == support_t::supported, "memfd_create");
+        item(k.copy_file_range == support_t::supported, "copy_file_range");
+        item(k.pidfd_open == support_t::supported, "pidfd_open");
+        item(k.futex_waitv == support_t::supported, "futex_waitv");
+        item(k.clone3 == support_t::supported, "clone3");
+        item(m.free, "madv_free");
+        item(m.hugepage, "madv_hugepage");
+        item(m.populate_read && m.populate_write, "madv_populate");
+        item(m.collapse, "madv_collapse");
+        return std::format_to(out, ")");
+    }
+};
@@ -0,0 +1,12 @@
+/**
+ * @file procfs.hpp
+ * @brief Umbrella header for the persistent procfs/sysfs reader framework.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/os/linux/procfs/parse.hpp>   // IWYU pragma: export
+#include <saburou/platform/v2/os/linux/procfs/reader.hpp>  // IWYU pragma: export
+#include <saburou/platform/v2/os/linux/procfs/schema.hpp>  // IWYU pragma: export
+#include <saburou/platform/v2/os/linux/procfs/sources.hpp> // IWYU pragma: export
+#include <saburou/platform/v2/os/linux/procfs/types.hpp>   // IWYU pragma: export
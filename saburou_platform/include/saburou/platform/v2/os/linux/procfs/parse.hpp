@@ -0,0 +1,125 @@
+/**
+ * @file parse.hpp
+ * @brief Allocation-free field extractors for kernel pseudo-file text.
+ *
+ * All helpers operate on std::string_view and std::from_chars, so parsing a snapshot never touches the
+ * heap or the locale.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/core.hpp>
+
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+namespace saburou::platform::v2::os::linux::procfs {
+
+/** @brief True for the separators used by procfs tables (space, tab, newline). */
+[[nodiscard]] constexpr bool is_space(char c) noexcept { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+/** @brief Removes leading and trailing whitespace. */
+[[nodiscard]] constexpr std::string_view trim(std::string_view s) noexcept {
+    while (!s.empty() && is_space(s.front())) s.remove_prefix(1);
+    while (!s.empty() && is_space(s.back())) s.remove_suffix(1);
+    return s;
+}
+
+/**
+ * @brief Pops the next whitespace-separated token from the front of a view.
+ * @param in Input view; advanced past the returned token.
+ * @return The token, or an empty view when the input is exhausted.
+ */
+[[nodiscard]] constexpr std::string_view next_token(std::string_view &in) noexcept {
+    std::size_t i = 0;
+    while (i < in.size() && is_space(in[i])) ++i;
+    std::size_t j = i;
+    while (j < in.size() && !is_space(in[j])) ++j;
+    std::string_view tok = in.substr(i, j - i);
+    in.remove_prefix(j);
+    return tok;
+}
+
+/**
+ * @brief Pops the next line (without its terminating newline) from the front of a view.
+ * @param in Input view; advanced past the line and its newline.
+ */
+[[nodiscard]] constexpr std::string_view next_line(std::string_view &in) noexcept {
+    auto pos = in.find('\n');
+    std::string_view line = in.substr(0, pos);
+    in.remove_prefix(pos == std::string_view::npos ? in.size() : pos + 1);
+    return line;
+}
+
+/**
+ * @brief Parses an arithmetic value with std::from_chars, ignoring surrounding whitespace.
+ * @tparam T Integral or floating-point destination type.
+ * @param s Text to parse; trailing characters after the number (e.g., " kB") are ignored.
+ * @param out Destination, left untouched on failure.
+ * @return True if a number was parsed.
+ */
+template <class T>
+    requires std::is_arithmetic_v<T>
+constexpr bool parse_number(std::string_view s, T &out) noexcept {
+    s = trim(s);
+    if (!s.empty() && s.front() == '+') s.remove_prefix(1); // from_chars does not accept '+'
+    T value{};
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (ec != std::errc{} || ptr == s.data()) return false;
+    out = value;
+    return true;
+}
+
+/**
+ * @brief Returns the n-th (0-based) whitespace-separated token of a line.
+ * @return The token, or an empty view if the line has fewer tokens.
+ */
+[[nodiscard]] constexpr std::string_view nth_token(std::string_view in, std::size_t n) noexcept {
+    std::string_view tok = next_token(in);
+    while (n-- > 0 && !tok.empty()) tok = next_token(in);
+    return tok;
+}
+
+/**
+ * @brief Splits a "key<sep>value" line, in the style of the os-release parser.
+ * @param line Input line (e.g., "MemTotal:  16318480 kB" or "anon 1234").
+ * @param sep Key/value separator; whitespace separators also accept runs of spaces.
+ * @param key Receives the trimmed key.
+ * @param value Receives the trimmed value.
+ * @return False if the separator is missing.
+ */
+constexpr bool split_key_value(std::string_view line, char sep, std::string_view &key,
+                               std::string_view &value) noexcept {
+    auto pos = line.find(sep);
+    if (pos == std::string_view::npos) return false;
+    key = trim(line.substr(0, pos));
+    value = trim(line.substr(pos + 1));
+    return true;
+}
+
+/**
+ * @brief Finds the value associated with a key in a "key<sep>value" per-line table.
+ * @return The trimmed value, or an empty view if the key is absent.
+ */
+[[nodiscard]] constexpr std::string_view find_value(std::string_view text, std::string_view key,
+                                                    char sep = ':') noexcept {
+    while (!text.empty()) {
+        std::string_view k, v;
+        if (split_key_value(next_line(text), sep, k, v) && k == key) return v;
+    }
+    return {};
+}
+
+/**
+ * @brief Skips past the last occurrence of a delimiter.
+ * * Used for /proc/<pid>/stat, whose second field "(comm)" may itself contain spaces and parentheses.
+ * @return The text after the delimiter, or the input unchanged if it is absent.
+ */
+[[nodiscard]] constexpr std::string_view skip_past_last(std::string_view text, char delim) noexcept {
+    auto pos = text.rfind(delim);
+    return pos == std::string_view::npos ? text : text.substr(pos + 1);
+}
+
+} // namespace saburou::platform::v2::os::linux::procfs
@@ -0,0 +1,167 @@
+/**
+ * @file reader.hpp
+ * @brief Persistent-descriptor reader for procfs, sysfs and cgroupfs pseudo-files.
+ *
+ * Kernel pseudo-files are regenerated on every read at offset 0, so a descriptor can be kept open and
+ * re-read with pread() instead of paying open()/close() and iostream setup on each poll.
+ *
+ * A "self" path (/proc/self/...) is resolved when it is opened, so a child of fork() inheriting the
+ * descriptor would keep reading its parent's file. Readers of such paths reopen whenever the process id
+ * changes.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace saburou::platform::v2::os::linux::procfs {
+
+/**
+ * @brief Filesystem root used to resolve kernel pseudo-file paths.
+ * * Defaults to "/". Tests can point it at a fixture directory that mirrors the proc/sys layout.
+ */
+struct root_t {
+    std::string path = "/"; ///< Directory that plays the role of "/"
+
+    /**
+     * @brief Joins a root-relative path (e.g., "proc/loadavg") onto the root directory.
+     * @param relative Path without leading slash; a leading slash is tolerated and ignored.
+     * @return The resolved absolute path.
+     */
+    [[nodiscard]] std::string resolve(std::string_view relative) const {
+        while (relative.starts_with('/')) relative.remove_prefix(1);
+        std::string full = path.empty() ? std::string("/") : path;
+        if (!full.ends_with('/')) full.push_back('/');
+        full.append(relative);
+        return full;
+    }
+};
+
+/**
+ * @brief Keeps a pseudo-file open and re-reads it into a reusable buffer.
+ * * Move-only RAII owner of the descriptor. The buffer grows geometrically when a read fills it, so
+ * after the first few polls no allocation happens on the hot path.
+ * @note On non-POSIX platforms the reader never opens and read() always returns an empty view.
+ */
+class file_reader {
+public:
+    /** @brief Default buffer size; enough for loadavg, stat, statm and most cgroup files. */
+    static constexpr std::size_t default_capacity = 4096;
+
+    file_reader() = default;
+
+    /**
+     * @brief Opens an absolute path.
+     * @param path Absolute path of the pseudo-file.
+     * @param capacity Initial buffer size in bytes.
+     */
+    explicit file_reader(std::string path, std::size_t capacity = default_capacity)
+        : path_(std::move(path)), buf_(capacity ? capacity : default_capacity) {
+        open();
+    }
+
+    /**
+     * @brief Opens a path relative to an injectable root.
+     * @param root Root directory (e.g., a test fixture).
+     * @param relative Root-relative path such as "proc/self/stat".
+     * @param capacity Initial buffer size in bytes.
+     */
+    file_reader(const root_t &root, std::string_view relative, std::size_t capacity = default_capacity)
+        : file_reader(root.resolve(relative), capacity) {}
+
+    file_reader(const file_reader &) = delete;
+    file_reader &operator=(const file_reader &) = delete;
+
+    file_reader(file_reader &&other) noexcept
+        : path_(std::move(other.path_)), buf_(std::move(other.buf_)), fd_(std::exchange(other.fd_, -1)),
+          pid_(other.pid_) {}
+
+    file_reader &operator=(file_reader &&other) noexcept {
+        if (this != &other) {
+            close();
+            path_ = std::move(other.path_);
+            buf_ = std::move(other.buf_);
+            fd_ = std::exchange(other.fd_, -1);
+            pid_ = other.pid_;
+        }
+        return *this;
+    }
+
+    ~file_reader() { close(); }
+
+    /** @brief True if the descriptor is open. */
+    [[nodiscard]] bool is_open() const noexcept { return fd_ >= 0; }
+
+    /** @brief The resolved path this reader was opened with. */
+    [[nodiscard]] const std::string &path() const noexcept { return path_; }
+
+    /**
+     * @brief Re-reads the whole file from offset 0.
+     * @return A view over the current contents, valid until the next read() or destruction.
+     * @note Returns an empty view if the reader is closed or the read fails.
+     */
+    [[nodiscard]] std::string_view read() {
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+        if (pid_ && pid_ != ::getpid()) {
+            close();
+            open();
+        }
+        if (fd_ < 0) return {};
+        for (;;) {
+            std::size_t total = 0;
+            for (;;) {
+                ssize_t n = ::pread(fd_, buf_.data() + total, buf_.size() - total, static_cast<off_t>(total));
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    return {};
+                }
+                if (n == 0) break;
+                total += static_cast<std::size_t>(n);
+                if (total == buf_.size()) break;
+            }
+            // A full buffer may mean truncation: grow and regenerate the snapshot from offset 0.
+            if (total < buf_.size()) return {buf_.data(), total};
+            buf_.resize(buf_.size() * 2);
+        }
+#else
+        return {};
+#endif
+    }
+
+    /** @brief Closes the descriptor. Safe to call more than once. */
+    void close() noexcept {
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+        if (fd_ >= 0) ::close(fd_);
+#endif
+        fd_ = -1;
+    }
+
+private:
+    void open() noexcept {
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+        do {
+            fd_ = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+        } while (fd_ < 0 && errno == EINTR);
+        if (path_.find("/self/") != std::string::npos) pid_ = ::getpid();
+#endif
+    }
+
+    std::string path_;
+    std::vector<char> buf_;
+    int fd_ = -1;
+    long pid_ = 0; ///< Opening process of a "self" path, 0 for other paths
+};
+
+} // namespace saburou::platform::v2::os::linux::procfs
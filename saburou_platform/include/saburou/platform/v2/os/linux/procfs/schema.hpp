@@ -0,0 +1,199 @@
+/**
+ * @file schema.hpp
+ * @brief Declarative mapping of pseudo-file fields into plain structs.
+ *
+ * Two table shapes cover almost every kernel interface:
+ * - keyed: one "key<sep>value" pair per line (/proc/meminfo, /proc/self/status, cgroup memory.stat).
+ * - positional: whitespace-separated columns (/proc/loadavg, /proc/self/stat, /proc/self/statm).
+ *
+ * @code
+ * constexpr auto schema = procfs::keyed(':', procfs::key("MemTotal", &meminfo_t::total_kb),
+ *                                           procfs::key("MemFree",  &meminfo_t::free_kb));
+ * meminfo_t m{};
+ * schema.apply(reader.read(), m);
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/os/linux/procfs/parse.hpp>
+#include <saburou/platform/v2/os/linux/procfs/reader.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace saburou::platform::v2::os::linux::procfs {
+
+/**
+ * @brief Default text-to-member conversion used by schema fields.
+ * * Arithmetic members go through parse_number, char members take the first character and std::string
+ * members copy the raw text.
+ */
+struct default_parser {
+    template <class M> constexpr bool operator()(std::string_view text, M &out) const {
+        if constexpr (std::is_same_v<M, char>) {
+            text = trim(text);
+            if (text.empty()) return false;
+            out = text.front();
+            return true;
+        } else if constexpr (std::is_arithmetic_v<M>) {
+            return parse_number(text, out);
+        } else {
+            out = M(text);
+            return true;
+        }
+    }
+};
+
+/** @brief Field bound to a key in a keyed table. */
+template <class T, class M, class P = default_parser> struct key_field_t {
+    std::string_view key; ///< Key as it appears in the file (without separator)
+    M T::*member;         ///< Destination member
+    P parse{};            ///< Conversion from text to member
+};
+
+/** @brief Field bound to a column number in a positional table. */
+template <class T, class M, class P = default_parser> struct index_field_t {
+    std::size_t index; ///< Column number, counted as documented by the kernel
+    M T::*member;      ///< Destination member
+    P parse{};         ///< Conversion from text to member
+};
+
+/** @brief Binds a key to a struct member. */
+template <class T, class M, class P = default_parser>
+[[nodiscard]] constexpr key_field_t<T, M, P> key(std::string_view k, M T::*member, P parse = {}) {
+    return {k, member, parse};
+}
+
+/** @brief Binds a column number to a struct member. */
+template <class T, class M, class P = default_parser>
+[[nodiscard]] constexpr index_field_t<T, M, P> at(std::size_t index, M T::*member, P parse = {}) {
+    return {index, member, parse};
+}
+
+/**
+ * @brief Schema for "key<sep>value" line tables.
+ * * A single pass over the text assigns every matching field.
+ */
+template <class... F> struct keyed_schema_t {
+    char sep;                ///< Key/value separator (':' for meminfo, ' ' for cgroup stat files)
+    std::tuple<F...> fields; ///< Field bindings
+
+    /**
+     * @brief Parses text into a struct.
+     * @return Number of fields successfully assigned.
+     */
+    template <class T> std::size_t apply(std::string_view text, T &out) const {
+        std::size_t hits = 0;
+        while (!text.empty()) {
+            std::string_view k, v;
+            if (!split_key_value(next_line(text), sep, k, v)) continue;
+            std::apply([&](const auto &...f) { ((hits += (f.key == k && f.parse(v, out.*f.member))), ...); },
+                       fields);
+        }
+        return hits;
+    }
+};
+
+/**
+ * @brief Schema for whitespace-separated column tables.
+ * * When skip_past is set, scanning starts after the last occurrence of that character and the first
+ * column seen is numbered first_index. For /proc/<pid>/stat this allows using the 1-based field numbers
+ * from proc(5) while skipping the free-form "(comm)" field: skip_past = ')', first_index = 3.
+ */
+template <class... F> struct positional_schema_t {
+    char skip_past;          ///< Start after the last occurrence of this character (0 = from the start)
+    std::size_t first_index; ///< Number assigned to the first scanned column
+    std::tuple<F...> fields; ///< Field bindings
+
+    /**
+     * @brief Parses text into a struct.
+     * @return Number of fields successfully assigned.
+     */
+    template <class T> std::size_t apply(std::string_view text, T &out) const {
+        if (skip_past) text = skip_past_last(text, skip_past);
+        const std::size_t last = std::apply([](const auto &...f) { return std::max({f.index...}); }, fields);
+        std::size_t hits = 0;
+        for (std::size_t i = first_index; i <= last; ++i) {
+            std::string_view tok = next_token(text);
+            if (tok.empty()) break;
+            std::apply([&](const auto &...f) { ((hits += (f.index == i && f.parse(tok, out.*f.member))), ...); },
+                       fields);
+        }
+        return hits;
+    }
+};
+
+/** @brief Builds a keyed schema. */
+template <class... F> [[nodiscard]] constexpr keyed_schema_t<F...> keyed(char sep, F... fields) {
+    return {sep, {fields...}};
+}
+
+/** @brief Builds a positional schema whose first column is numbered 0. */
+template <class... F> [[nodiscard]] constexpr positional_schema_t<F...> positional(F... fields) {
+    return {0, 0, {fields...}};
+}
+
+/** @brief Builds a positional schema that starts after the last @p skip_past character. */
+template <class... F>
+[[nodiscard]] constexpr positional_schema_t<F...> positional_after(char skip_past, std::size_t first_index,
+                                                                   F... fields) {
+    return {skip_past, first_index, {fields...}};
+}
+
+/**
+ * @brief Describes where a struct lives and how it is laid out.
+ * * Specializations provide `static constexpr std::string_view path` (root-relative) and
+ * `static constexpr auto schema`.
+ */
+template <class T> struct source_traits;
+
+/**
+ * @brief A typed, persistent reader: one open descriptor plus the schema of T.
+ * @tparam T A struct with a source_traits specialization.
+ */
+template <class T> class source {
+public:
+    /**
+     * @brief Opens the pseudo-file described by source_traits<T>.
+     * @param root Filesystem root; override it to read from a fixture tree.
+     */
+    explicit source(const root_t &root = {}) : reader_(root, source_traits<T>::path) {}
+
+    /** @brief True if the underlying descriptor is open. */
+    [[nodiscard]] bool is_open() const noexcept { return reader_.is_open(); }
+
+    /**
+     * @brief Re-reads and parses into an existing object, reusing its storage.
+     * @return False if the file could not be read or no field matched.
+     */
+    bool read(T &out) { return source_traits<T>::schema.apply(reader_.read(), out) > 0; }
+
+    /**
+     * @brief Re-reads and parses into a fresh object.
+     * @return A default-initialized T if the file is unavailable.
+     */
+    [[nodiscard]] T read() {
+        T out{};
+        read(out);
+        return out;
+    }
+
+private:
+    file_reader reader_;
+};
+
+/**
+ * @brief Reads a single-value file (e.g., cgroup "memory.current" or a sysfs attribute).
+ * @return False if the read or the conversion fails.
+ */
+template <class M, class P = default_parser> bool read_value(file_reader &reader, M &out, P parse = {}) {
+    std::string_view text = trim(reader.read());
+    return !text.empty() && parse(text, out);
+}
+
+} // namespace saburou::platform::v2::os::linux::procfs
@@ -0,0 +1,53 @@
+/**
+ * @file sources.hpp
+ * @brief Schema bindings for the built-in procfs snapshot types.
+ *
+ * @code
+ * procfs::source<procfs::loadavg_t> load;   // opens /proc/loadavg once
+ * auto l = load.read();                       // pread + from_chars on every poll
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/os/linux/procfs/schema.hpp>
+#include <saburou/platform/v2/os/linux/procfs/types.hpp>
+
+#include <string_view>
+
+namespace saburou::platform::v2::os::linux::procfs {
+
+/** @brief /proc/loadavg: "0.52 0.58 0.59 3/1024 12345". */
+template <> struct source_traits<loadavg_t> {
+    static constexpr std::string_view path = "proc/loadavg";
+    static constexpr auto schema = positional(
+        at(0, &loadavg_t::load1), at(1, &loadavg_t::load5), at(2, &loadavg_t::load15),
+        at(3, &loadavg_t::runnable),
+        at(3, &loadavg_t::threads,
+           [](std::string_view tok, uint32_t &out) {
+               auto slash = tok.find('/');
+               return slash != std::string_view::npos && parse_number(tok.substr(slash + 1), out);
+           }),
+        at(4, &loadavg_t::last_pid));
+};
+
+/** @brief /proc/meminfo: "MemTotal:       16318480 kB" per line. */
+template <> struct source_traits<meminfo_t> {
+    static constexpr std::string_view path = "proc/meminfo";
+    static constexpr auto schema = keyed(
+        ':', key("MemTotal", &meminfo_t::total_kb), key("MemFree", &meminfo_t::free_kb),
+        key("MemAvailable", &meminfo_t::available_kb), key("Buffers", &meminfo_t::buffers_kb),
+        key("Cached", &meminfo_t::cached_kb), key("SwapTotal", &meminfo_t::swap_total_kb),
+        key("SwapFree", &meminfo_t::swap_free_kb));
+};
+
+/** @brief /proc/self/stat, numbered as in proc(5); "(comm)" is skipped so names with spaces parse. */
+template <> struct source_traits<stat_t> {
+    static constexpr std::string_view path = "proc/self/stat";
+    static constexpr auto schema = positional_after(
+        ')', 3, at(3, &stat_t::state), at(4, &stat_t::ppid), at(10, &stat_t::minflt), at(12, &stat_t::majflt),
+        at(14, &stat_t::utime), at(15, &stat_t::stime), at(20, &stat_t::num_threads), at(23, &stat_t::vsize),
+        at(24, &stat_t::rss_pages));
+};
+
+} // namespace saburou::platform::v2::os::linux::procfs
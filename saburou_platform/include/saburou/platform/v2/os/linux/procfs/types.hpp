@@ -0,0 +1,145 @@
+/**
+ * @file types.hpp
+ * @brief Snapshot structures for frequently polled procfs files.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/core.hpp>
+
+#include <cstdint>
+#include <format>
+
+namespace saburou::platform::v2::os::linux::procfs {
+
+/**
+ * @brief Contents of /proc/loadavg.
+ */
+struct loadavg_t {
+    double load1 = 0.0;     ///< 1-minute load average
+    double load5 = 0.0;     ///< 5-minute load average
+    double load15 = 0.0;    ///< 15-minute load average
+    uint32_t runnable = 0;  ///< Currently runnable scheduling entities
+    uint32_t threads = 0;   ///< Total scheduling entities on the system
+    int32_t last_pid = 0;   ///< PID most recently created
+};
+
+/**
+ * @brief Subset of /proc/meminfo (values in kB, as reported by the kernel).
+ */
+struct meminfo_t {
+    uint64_t total_kb = 0;      ///< MemTotal
+    uint64_t free_kb = 0;       ///< MemFree
+    uint64_t available_kb = 0;  ///< MemAvailable
+    uint64_t buffers_kb = 0;    ///< Buffers
+    uint64_t cached_kb = 0;     ///< Cached
+    uint64_t swap_total_kb = 0; ///< SwapTotal
+    uint64_t swap_free_kb = 0;  ///< SwapFree
+};
+
+/**
+ * @brief Subset of /proc/self/stat (field numbers from proc(5) in brackets).
+ */
+struct stat_t {
+    char state = '?';         ///< [3] Process state (R, S, D, Z, ...)
+    int32_t ppid = 0;         ///< [4] Parent PID
+    uint64_t minflt = 0;      ///< [10] Minor faults
+    uint64_t majflt = 0;      ///< [12] Major faults
+    uint64_t utime = 0;       ///< [14] User time in clock ticks
+    uint64_t stime = 0;       ///< [15] System time in clock ticks
+    int64_t num_threads = 0;  ///< [20] Number of threads
+    uint64_t vsize = 0;       ///< [23] Virtual memory size in bytes
+    int64_t rss_pages = 0;    ///< [24] Resident set size in pages
+};
+
+} // namespace saburou::platform::v2::os::linux::procfs
+
+/**
+ * @brief std::formatter specialization for loadavg_t.
+ * Supported format specifiers: {} or {:s} for "l1 l5 l15 r/t", {:r} for detailed representation.
+ */
+template <> struct std::formatter<saburou::platform::v2::os::linux::procfs::loadavg_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for loadavg_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::os::linux::procfs::loadavg_t &l, std::format_context &ctx) const {
+        if (repr) {
+            return std::format_to(ctx.out(),
+                                  "loadavg(load1={}, load5={}, load15={}, runnable={}, threads={}, last_pid={})",
+                                  l.load1, l.load5, l.load15, l.runnable, l.threads, l.last_pid);
+        }
+        return std::format_to(ctx.out(), "{:.2f} {:.2f} {:.2f} {}/{}", l.load1, l.load5, l.load15, l.runnable,
+                              l.threads);
+    }
+};
+
+/**
+ * @brief std::formatter specialization for meminfo_t.
+ * Supported format specifiers: {} or {:s} for a compact summary, {:r} for every field.
+ */
+template <> struct std::formatter<saburou::platform::v2::os::linux::procfs::meminfo_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for meminfo_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::os::linux::procfs::meminfo_t &m, std::format_context &ctx) const {
+        if (repr) {
+            return std::format_to(ctx.out(),
+                                  "meminfo(total_kb={}, free_kb={}, available_kb={}, buffers_kb={}, cached_kb={}, "
+                                  "swap_total_kb={}, swap_free_kb={})",
+                                  m.total_kb, m.free_kb, m.available_kb, m.buffers_kb, m.cached_kb, m.swap_total_kb,
+                                  m.swap_free_kb);
+        }
+        return std::format_to(ctx.out(), "meminfo(available={} kB / total={} kB)", m.available_kb, m.total_kb);
+    }
+};
+
+/**
+ * @brief std::formatter specialization for stat_t.
+ * Supported format specifiers: {} or {:s} for a compact summary, {:r} for every field.
+ */
+template <> struct std::formatter<saburou::platform::v2::os::linux::procfs::stat_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for stat_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::os::linux::procfs::stat_t &s, std::format_context &ctx) const {
+        if (repr) {
+            return std::format_to(ctx.out(),
+                                  "stat(state={}, ppid={}, minflt={}, majflt={}, utime={}, stime={}, "
+                                  "num_threads={}, vsize={}, rss_pages={})",
+                                  s.state, s.ppid, s.minflt, s.majflt, s.utime, s.stime, s.num_threads, s.vsize,
+                                  s.rss_pages);
+        }
+        return std::format_to(ctx.out(), "stat(state={}, threads={}, rss_pages={})", s.state, s.num_threads,
+                              s.rss_pages);
+    }
+};
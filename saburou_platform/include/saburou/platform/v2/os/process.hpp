@@ -0,0 +1,9 @@
+/**
+ * @file process.hpp
+ * @brief Umbrella header for process and thread resource snapshots.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/os/process/types.hpp> // IWYU pragma: export
+#include <saburou/platform/v2/os/process/query.hpp> // IWYU pragma: export
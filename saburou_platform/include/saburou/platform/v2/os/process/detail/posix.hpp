@@ -0,0 +1,100 @@
+/**
+ * @file posix.hpp
+ * @brief POSIX-specific implementation of process and thread resource snapshots.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+#include <saburou/platform/v2/memory/pages.hpp>
+#include <saburou/platform/v2/os/linux/procfs/parse.hpp>
+#include <saburou/platform/v2/os/linux/procfs/reader.hpp>
+#include <saburou/platform/v2/os/process/types.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace saburou::platform::v2::os::process::posix {
+
+/** @brief Converts a timeval to nanoseconds. */
+[[nodiscard]] constexpr std::chrono::nanoseconds to_ns(const timeval &tv) noexcept {
+    return std::chrono::seconds(tv.tv_sec) + std::chrono::microseconds(tv.tv_usec);
+}
+
+/** @brief Converts a timespec to nanoseconds. */
+[[nodiscard]] constexpr std::chrono::nanoseconds to_ns(const timespec &ts) noexcept {
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+using saburou::platform::v2::memory::page_size;
+
+/**
+ * @brief Fills memory gauges from /proc/self/statm (and optionally /proc/self/smaps_rollup).
+ * @note Descriptors are thread_local and stay open (reopened after fork), so steady-state cost is a getpid and
+ * one pread per file.
+ * @note smaps_rollup makes the kernel walk every mapping; it is only opened when PSS is requested.
+ */
+inline void fill_memory(usage_t &u, bool with_pss) {
+    namespace procfs = saburou::platform::v2::os::linux::procfs;
+
+    thread_local procfs::file_reader statm("/proc/self/statm", 128);
+    uint64_t resident = 0;
+    if (procfs::parse_number(procfs::nth_token(statm.read(), 1), resident)) u.rss_bytes = resident * page_size();
+
+    if (with_pss) {
+        thread_local procfs::file_reader rollup("/proc/self/smaps_rollup", 2048);
+        uint64_t pss_kb = 0;
+        if (procfs::parse_number(procfs::find_value(rollup.read(), "Pss"), pss_kb)) u.pss_bytes = pss_kb * 1024;
+    }
+}
+
+/**
+ * @brief Collects a resource snapshot using getrusage and the CPUTIME clocks.
+ * @param scope Whole process or calling thread.
+ * @param with_pss Whether to also read PSS (process scope only; noticeably more expensive).
+ * @return A populated usage_t; fields the platform cannot provide stay zero.
+ */
+inline usage_t usage(scope_t scope, bool with_pss) {
+    usage_t u{};
+    u.scope = scope;
+
+    rusage ru{};
+    int rc = -1;
+    if (scope == scope_t::process) {
+        rc = ::getrusage(RUSAGE_SELF, &ru);
+    } else {
+#if defined(RUSAGE_THREAD)
+        rc = ::getrusage(RUSAGE_THREAD, &ru);
+#endif
+    }
+    if (rc == 0) {
+        u.minor_faults = static_cast<uint64_t>(ru.ru_minflt);
+        u.major_faults = static_cast<uint64_t>(ru.ru_majflt);
+        u.voluntary_switches = static_cast<uint64_t>(ru.ru_nvcsw);
+        u.involuntary_switches = static_cast<uint64_t>(ru.ru_nivcsw);
+        u.user_time = to_ns(ru.ru_utime);
+        u.system_time = to_ns(ru.ru_stime);
+        if (scope == scope_t::process) {
+#if SABUROU_PLATFORM_V2_OS_DARWIN
+            u.peak_rss_bytes = static_cast<uint64_t>(ru.ru_maxrss); // bytes on Darwin
+#else
+            u.peak_rss_bytes = static_cast<uint64_t>(ru.ru_maxrss) * 1024; // kilobytes elsewhere
+#endif
+        }
+    }
+
+    timespec ts{};
+    if (::clock_gettime(scope == scope_t::process ? CLOCK_PROCESS_CPUTIME_ID : CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        u.cpu_time = to_ns(ts);
+
+    if (scope == scope_t::process) fill_memory(u, with_pss);
+    return u;
+}
+
+} // namespace saburou::platform::v2::os::process::posix
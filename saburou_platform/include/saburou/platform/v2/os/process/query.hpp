@@ -0,0 +1,49 @@
+/**
+ * @file query.hpp
+ * @brief Process and thread resource snapshot queries for saburou-platform.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/detect.hpp>
+#include <saburou/platform/v2/os/process/types.hpp>
+
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+#include <saburou/platform/v2/os/process/detail/posix.hpp>
+#endif
+
+namespace saburou::platform::v2::os::process {
+
+/**
+ * @brief Takes a resource snapshot of the whole process.
+ * @param with_pss Also read the proportional set size. Off by default: it makes the kernel walk every
+ * mapping, which is far from free on large address spaces.
+ * @return A usage_t with scope_t::process; combine two of them with delta() or operator-.
+ * @note This function performs runtime system calls (getrusage, clock_gettime and a pread on /proc/self/statm).
+ * @note If the current platform is unsupported, it returns a default-initialized usage_t.
+ */
+[[nodiscard]] inline usage_t usage(bool with_pss = false) {
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+    return posix::usage(scope_t::process, with_pss);
+#else
+    (void)with_pss;
+    return usage_t{};
+#endif
+}
+
+/**
+ * @brief Takes a resource snapshot of the calling thread.
+ * @return A usage_t with scope_t::thread. Memory gauges are zero (memory is shared by all threads).
+ * @note cpu_time comes from CLOCK_THREAD_CPUTIME_ID; faults and context switches need RUSAGE_THREAD (Linux).
+ */
+[[nodiscard]] inline usage_t thread_usage() {
+#if SABUROU_PLATFORM_V2_POSIX_LIKE
+    return posix::usage(scope_t::thread, false);
+#else
+    usage_t u{};
+    u.scope = scope_t::thread;
+    return u;
+#endif
+}
+
+} // namespace saburou::platform::v2::os::process
@@ -0,0 +1,139 @@
+/**
+ * @file types.hpp
+ * @brief Process and thread resource snapshot structures and formatters.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/core.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <format>
+
+namespace saburou::platform::v2::os::process {
+
+/**
+ * @brief Granularity of a resource snapshot.
+ */
+enum class scope_t : uint8_t {
+    process, // Whole process (all threads)
+    thread   // Calling thread only
+};
+
+/**
+ * @brief Resource usage snapshot of the current process or thread.
+ * * Counters (faults, context switches, CPU time) are cumulative since process/thread start, so two
+ * snapshots can be subtracted. Memory figures are gauges and are only filled for scope_t::process.
+ */
+struct usage_t {
+    scope_t scope = scope_t::process;          ///< What the snapshot covers
+    uint64_t rss_bytes = 0;                    ///< Resident set size (from statm)
+    uint64_t pss_bytes = 0;                    ///< Proportional set size (0 unless explicitly requested)
+    uint64_t peak_rss_bytes = 0;               ///< High-water RSS (ru_maxrss)
+    uint64_t minor_faults = 0;                 ///< Page faults served without I/O
+    uint64_t major_faults = 0;                 ///< Page faults that required I/O
+    uint64_t voluntary_switches = 0;           ///< Context switches due to blocking
+    uint64_t involuntary_switches = 0;         ///< Context switches due to preemption
+    std::chrono::nanoseconds user_time{0};     ///< CPU time spent in user mode
+    std::chrono::nanoseconds system_time{0};   ///< CPU time spent in kernel mode
+    std::chrono::nanoseconds cpu_time{0};      ///< High-resolution total CPU time (CPUTIME clocks)
+};
+
+/**
+ * @brief Computes the activity between two snapshots of the same scope.
+ * @param before The earlier snapshot.
+ * @param after The later snapshot.
+ * @return Counters hold the difference; gauges (rss, pss, peak rss) carry the later snapshot's value.
+ */
+[[nodiscard]] constexpr usage_t delta(const usage_t &before, const usage_t &after) noexcept {
+    usage_t d = after;
+    d.minor_faults -= before.minor_faults;
+    d.major_faults -= before.major_faults;
+    d.voluntary_switches -= before.voluntary_switches;
+    d.involuntary_switches -= before.involuntary_switches;
+    d.user_time -= before.user_time;
+    d.system_time -= before.system_time;
+    d.cpu_time -= before.cpu_time;
+    return d;
+}
+
+/** @brief Shorthand for delta(before, after). */
+[[nodiscard]] constexpr usage_t operator-(const usage_t &after, const usage_t &before) noexcept {
+    return delta(before, after);
+}
+
+/**
+ * @brief Converts a scope_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(scope_t s) {
+    switch (s) {
+    case scope_t::process: return "process";
+    case scope_t::thread:  return "thread";
+    default:               return "unknown";
+    }
+}
+
+} // namespace saburou::platform::v2::os::process
+
+/**
+ * @brief std::formatter specialization for scope_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "scope_t::thread").
+ */
+template <> struct std::formatter<saburou::platform::v2::os::process::scope_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::os::process::scope_t &s, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::os::process::to_code_name(s);
+        return repr ? std::format_to(ctx.out(), "scope_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
+
+/**
+ * @brief std::formatter specialization for usage_t.
+ * Supported format specifiers: {} or {:s} for a compact summary (times in ms, memory in KiB),
+ * {:r} for every field in raw units (bytes, nanoseconds).
+ */
+template <> struct std::formatter<saburou::platform::v2::os::process::usage_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for usage_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::os::process::usage_t &u, std::format_context &ctx) const {
+        if (repr) {
+            return std::format_to(ctx.out(),
+                                  "usage(scope={:r}, rss_bytes={}, pss_bytes={}, peak_rss_bytes={}, minor_faults={}, "
+                                  "major_faults={}, voluntary_switches={}, involuntary_switches={}, "
+                                  "user_time_ns={}, system_time_ns={}, cpu_time_ns={})",
+                                  u.scope, u.rss_bytes, u.pss_bytes, u.peak_rss_bytes, u.minor_faults,
+                                  u.major_faults, u.voluntary_switches, u.involuntary_switches,
+                                  u.user_time.count(), u.system_time.count(), u.cpu_time.count());
+        }
+        using ms = std::chrono::duration<double, std::milli>;
+        auto out = std::format_to(ctx.out(), "usage({}", u.scope);
+        if (u.scope == saburou::platform::v2::os::process::scope_t::process) {
+            out = std::format_to(out, ", rss={} KiB", u.rss_bytes / 1024);
+            if (u.pss_bytes) out = std::format_to(out, ", pss={} KiB", u.pss_bytes / 1024);
+        }
+        return std::format_to(out, ", faults={}/{}, switches={}/{}, user={:.3f}ms, sys={:.3f}ms, cpu={:.3f}ms)",
+                              u.minor_faults, u.major_faults, u.voluntary_switches, u.involuntary_switches,
+                              ms(u.user_time).count(), ms(u.system_time).count(), ms(u.cpu_time).count());
+    }
+};
@@ -0,0 +1,9 @@
+/**
+ * @file virt.hpp
+ * @brief Umbrella header for runtime virtualization and cloud detection.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/os/virt/types.hpp> // IWYU pragma: export
+#include <saburou/platform/v2/os/virt/query.hpp> // IWYU pragma: export
@@ -0,0 +1,185 @@
+/**
+ * @file linux.hpp
+ * @brief Linux-specific virtualization probes: DMI, /sys/hypervisor, ACPI headers and procfs.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/cpu/detail/cpuid.hpp>
+#include <saburou/platform/v2/os/linux/procfs/parse.hpp>
+#include <saburou/platform/v2/os/linux/procfs/reader.hpp>
+#include <saburou/platform/v2/os/virt/types.hpp>
+
+#include <string>
+#include <string_view>
+
+namespace saburou::platform::v2::os::linux::detail {
+
+/** @brief Reads the first line of a small sysfs/procfs attribute, trimmed; empty if unreadable. */
+[[nodiscard]] inline std::string read_attribute(const procfs::root_t &root, std::string_view relative) {
+    procfs::file_reader reader(root, relative, 256);
+    std::string_view text = reader.read();
+    return std::string(procfs::trim(procfs::next_line(text)));
+}
+
+/** @brief DMI/SMBIOS strings exported under /sys/class/dmi/id (absent on most microVMs and on ARM). */
+struct dmi_t {
+    std::string sys_vendor;
+    std::string product_name;
+    std::string bios_vendor;
+    std::string board_vendor;
+    std::string chassis_asset_tag;
+};
+
+/** @brief Reads the world-readable DMI attributes. */
+[[nodiscard]] inline dmi_t read_dmi(const procfs::root_t &root) {
+    dmi_t d;
+    d.sys_vendor = read_attribute(root, "sys/class/dmi/id/sys_vendor");
+    d.product_name = read_attribute(root, "sys/class/dmi/id/product_name");
+    d.bios_vendor = read_attribute(root, "sys/class/dmi/id/bios_vendor");
+    d.board_vendor = read_attribute(root, "sys/class/dmi/id/board_vendor");
+    d.chassis_asset_tag = read_attribute(root, "sys/class/dmi/id/chassis_asset_tag");
+    return d;
+}
+
+/**
+ * @brief Maps a DMI vendor/product string to a hypervisor.
+ * @note Cloud vendor strings ("Amazon EC2", "Google") are left to cloud_from_dmi(): they also appear on
+ * bare-metal instances, which run no hypervisor.
+ */
+[[nodiscard]] inline hypervisor_t hypervisor_from_dmi_string(std::string_view s) noexcept {
+    if (s.empty()) return hypervisor_t::none;
+    if (s.starts_with("KVM")) return hypervisor_t::kvm;
+    if (s.starts_with("QEMU")) return hypervisor_t::qemu;
+    if (s.starts_with("VMware") || s.starts_with("VMW")) return hypervisor_t::vmware;
+    if (s.starts_with("innotek GmbH") || s.starts_with("VirtualBox") || s.starts_with("Oracle Corporation"))
+        return hypervisor_t::virtualbox;
+    if (s.starts_with("Xen")) return hypervisor_t::xen;
+    if (s.starts_with("Microsoft Corporation")) return hypervisor_t::hyperv;
+    if (s.starts_with("Parallels")) return hypervisor_t::parallels;
+    if (s.starts_with("BHYVE")) return hypervisor_t::bhyve;
+    return hypervisor_t::none;
+}
+
+/**
+ * @brief Infers the hypervisor from DMI strings.
+ * @note Microsoft's vendor string is also used by physical Surface hardware, so Hyper-V additionally
+ * requires the "Virtual Machine" product name.
+ */
+[[nodiscard]] inline hypervisor_t hypervisor_from_dmi(const dmi_t &d) noexcept {
+    for (std::string_view s : {std::string_view(d.sys_vendor), std::string_view(d.product_name),
+                               std::string_view(d.bios_vendor), std::string_view(d.board_vendor)}) {
+        hypervisor_t h = hypervisor_from_dmi_string(s);
+        if (h == hypervisor_t::hyperv && d.product_name != "Virtual Machine") continue;
+        if (h != hypervisor_t::none) return h;
+    }
+    return hypervisor_t::none;
+}
+
+/** @brief Infers the cloud provider from DMI strings and the Xen UUID. */
+[[nodiscard]] inline cloud_t cloud_from_dmi(const dmi_t &d, std::string_view xen_uuid) noexcept {
+    auto any = [&](std::string_view needle) {
+        return d.sys_vendor.find(needle) != std::string::npos || d.bios_vendor.find(needle) != std::string::npos ||
+               d.product_name.find(needle) != std::string::npos;
+    };
+    // Xen-based EC2 instances carry no Amazon DMI strings, but their UUID always starts with "ec2".
+    if (any("Amazon EC2") || xen_uuid.starts_with("ec2") || xen_uuid.starts_with("EC2")) return cloud_t::aws;
+    if (any("Google Compute Engine") || d.sys_vendor == "Google") return cloud_t::gcp;
+    // Azure stamps every VM with a fixed chassis asset tag.
+    if (d.chassis_asset_tag == "7783-7084-3265-9085-8269-3286-77") return cloud_t::azure;
+    if (d.chassis_asset_tag == "OracleCloud.com") return cloud_t::oracle;
+    if (any("Alibaba Cloud")) return cloud_t::alibaba;
+    if (any("DigitalOcean")) return cloud_t::digitalocean;
+    if (any("Hetzner")) return cloud_t::hetzner;
+    if (any("OpenStack")) return cloud_t::openstack;
+    return cloud_t::none;
+}
+
+/**
+ * @brief Reads the 6-byte OEM ID from the header of an ACPI table (e.g., "FIRECK" for Firecracker).
+ * @note ACPI tables are usually root-only; an empty string is returned when they cannot be read.
+ */
+[[nodiscard]] inline std::string acpi_oem_id(const procfs::root_t &root, std::string_view table) {
+    std::string relative = "sys/firmware/acpi/tables/";
+    relative.append(table);
+    procfs::file_reader reader(root, relative, 512);
+    std::string_view header = reader.read();
+    // Standard ACPI description header: signature(4) length(4) revision(1) checksum(1) oem_id(6).
+    if (header.size() < 16) return {};
+    return std::string(procfs::trim(header.substr(10, 6)));
+}
+
+/** @brief True if /proc/version carries the fixed banner gVisor's Sentry reports. */
+[[nodiscard]] inline bool is_gvisor(const procfs::root_t &root) {
+    procfs::file_reader version(root, "proc/version", 512);
+    return version.read().find("#1 SMP Sun Jan 10 15:06:54 PST 2016") != std::string_view::npos;
+}
+
+/** @brief True if the "hypervisor" flag appears in /proc/cpuinfo (for builds without a CPUID wrapper). */
+[[nodiscard]] inline bool cpuinfo_hypervisor_flag(const procfs::root_t &root) {
+    procfs::file_reader cpuinfo(root, "proc/cpuinfo", 8192);
+    std::string_view flags = procfs::find_value(cpuinfo.read(), "flags");
+    while (!flags.empty()) {
+        if (procfs::next_token(flags) == "hypervisor") return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Refines the CPUID/DMI result using Linux-only signals and fills the descriptive fields.
+ * @param v Descriptor already holding the CPUID-based guess.
+ * @param root Filesystem root for sysfs/procfs lookups.
+ */
+inline void detect_virt(virt_info_t &v, const procfs::root_t &root) {
+    v.clocksource = read_attribute(root, "sys/devices/system/clocksource/clocksource0/current_clocksource");
+
+    // gVisor intercepts CPUID and passes the host's answer through, so it must be checked first.
+    if (is_gvisor(root)) {
+        v.hypervisor = hypervisor_t::gvisor;
+        return;
+    }
+
+    dmi_t dmi = read_dmi(root);
+    v.sys_vendor = dmi.sys_vendor;
+    v.product_name = dmi.product_name;
+
+    std::string xen_type = read_attribute(root, "sys/hypervisor/type");
+    std::string xen_uuid = read_attribute(root, "sys/hypervisor/uuid");
+    v.cloud = cloud_from_dmi(dmi, xen_uuid);
+
+    if (!v.cpuid_hypervisor_bit && !cpu::detail::has_cpuid) v.cpuid_hypervisor_bit = cpuinfo_hypervisor_flag(root);
+
+    // On x86 every guest sets the CPUID hypervisor bit, so DMI alone (which hosts can share with their
+    // guests) is only trusted when that bit agrees.
+    bool dmi_trusted = !cpu::detail::has_cpuid || v.cpuid_hypervisor_bit;
+    if (dmi_trusted && (v.hypervisor == hypervisor_t::none || v.hypervisor == hypervisor_t::unknown)) {
+        hypervisor_t from_dmi = hypervisor_from_dmi(dmi);
+        if (from_dmi != hypervisor_t::none) v.hypervisor = from_dmi;
+    }
+    if (xen_type == "xen") {
+        // Xen PV guests (and dom0) have no hypervisor CPUID bit; dom0 owns the hardware and is not a guest.
+        procfs::file_reader caps(root, "proc/xen/capabilities", 128);
+        v.hypervisor = caps.read().find("control_d") == std::string_view::npos ? hypervisor_t::xen : hypervisor_t::none;
+    }
+    if (v.hypervisor == hypervisor_t::none) {
+        // ARM guests have neither CPUID nor DMI under Xen; the device tree names the hypervisor instead.
+        procfs::file_reader dt(root, "proc/device-tree/hypervisor/compatible", 128);
+        if (dt.read().starts_with("xen")) v.hypervisor = hypervisor_t::xen;
+    }
+
+    if (v.hypervisor == hypervisor_t::kvm && dmi.sys_vendor.empty()) {
+        // Firecracker has no SMBIOS. Recent versions publish ACPI tables with OEM ID "FIRECK"; older
+        // ones boot without ACPI and describe every device through virtio_mmio.device= parameters.
+        if (acpi_oem_id(root, "FACP") == "FIRECK" || acpi_oem_id(root, "DSDT") == "FIRECK") {
+            v.hypervisor = hypervisor_t::firecracker;
+        } else {
+            procfs::file_reader cmdline(root, "proc/cmdline", 1024);
+            if (cmdline.read().find("virtio_mmio.device=") != std::string_view::npos)
+                v.hypervisor = hypervisor_t::firecracker;
+        }
+    }
+
+    if (v.hypervisor == hypervisor_t::none && v.cpuid_hypervisor_bit) v.hypervisor = hypervisor_t::unknown;
+}
+
+} // namespace saburou::platform::v2::os::linux::detail
@@ -0,0 +1,102 @@
+/**
+ * @file query.hpp
+ * @brief Runtime virtualization and cloud detection for saburou-platform.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/cpu/detail/cpuid.hpp>
+#include <saburou/platform/v2/detect.hpp>
+#include <saburou/platform/v2/os/virt/types.hpp>
+
+#include <filesystem>
+#include <string_view>
+
+#if SABUROU_PLATFORM_V2_OS_LINUX
+#include <saburou/platform/v2/os/virt/detail/linux.hpp>
+#endif
+
+namespace saburou::platform::v2::os {
+
+namespace detail {
+
+/** @brief Maps the 12-byte signature of CPUID leaf 0x40000000 to a hypervisor. */
+[[nodiscard]] constexpr hypervisor_t hypervisor_from_cpuid(std::string_view vendor) noexcept {
+    if (vendor.starts_with("KVMKVMKVM") || vendor == "Linux KVM Hv") return hypervisor_t::kvm;
+    if (vendor == "Microsoft Hv") return hypervisor_t::hyperv;
+    if (vendor == "VMwareVMware") return hypervisor_t::vmware;
+    if (vendor == "XenVMMXenVMM") return hypervisor_t::xen;
+    if (vendor == "VBoxVBoxVBox") return hypervisor_t::virtualbox;
+    if (vendor == "TCGTCGTCGTCG") return hypervisor_t::qemu;
+    if (vendor == "bhyve bhyve ") return hypervisor_t::bhyve;
+    if (vendor == " lrpepyh  vr" || vendor == "prl hyperv  ") return hypervisor_t::parallels;
+    if (vendor == "ACRNACRNACRN") return hypervisor_t::acrn;
+    return hypervisor_t::none;
+}
+
+/**
+ * @brief Fills the CPUID-derived fields of a virt_info_t (no-op on non-x86 targets).
+ * * KVM and Xen can expose Hyper-V enlightenments at 0x40000000 and move their own signature to
+ * 0x40000100, so that leaf is checked before trusting a "Microsoft Hv" answer.
+ */
+inline void detect_virt_cpuid(virt_info_t &v) {
+    if constexpr (!cpu::detail::has_cpuid) return;
+
+    v.cpuid_hypervisor_bit = (cpu::detail::cpuid(1).ecx >> 31) & 1u;
+    if (cpu::detail::cpuid(0x80000000u).eax >= 0x80000007u)
+        v.invariant_tsc = (cpu::detail::cpuid(0x80000007u).edx >> 8) & 1u;
+    if (!v.cpuid_hypervisor_bit) return;
+
+    char vendor[13];
+    cpu::detail::vendor_bytes(cpu::detail::cpuid(0x40000000u), vendor);
+    v.cpuid_vendor = vendor;
+    v.hypervisor = hypervisor_from_cpuid(vendor);
+
+    if (v.hypervisor == hypervisor_t::hyperv) {
+        cpu::detail::cpuid_t alt = cpu::detail::cpuid(0x40000100u);
+        char alt_vendor[13];
+        cpu::detail::vendor_bytes(alt, alt_vendor);
+        hypervisor_t nested = hypervisor_from_cpuid(alt_vendor);
+        if (nested == hypervisor_t::kvm || nested == hypervisor_t::xen) {
+            v.cpuid_vendor = alt_vendor;
+            v.hypervisor = nested;
+        }
+    }
+    if (v.hypervisor == hypervisor_t::none) v.hypervisor = hypervisor_t::unknown;
+}
+
+} // namespace detail
+
+/**
+ * @brief Detects the hypervisor and cloud provider of the running machine without caching.
+ * @param root Directory that plays the role of "/" for sysfs/procfs lookups (tests can point it at a
+ * fixture tree).
+ * @return A virt_info_t; hypervisor_t::none on bare metal.
+ * @note Signals, in order of trust: gVisor's /proc/version banner, the CPUID hypervisor leaf,
+ * /sys/hypervisor and DMI strings, then ACPI OEM IDs and the kernel command line to tell Firecracker
+ * apart from other KVM guests.
+ * @note Outside Linux only the CPUID-derived fields are filled.
+ */
+[[nodiscard]] inline virt_info_t detect_virtualization(const std::filesystem::path &root = "/") {
+    virt_info_t v{};
+    detail::detect_virt_cpuid(v);
+#if SABUROU_PLATFORM_V2_OS_LINUX
+    linux::detail::detect_virt(v, linux::procfs::root_t{root.string()});
+#else
+    (void)root;
+#endif
+    return v;
+}
+
+/**
+ * @brief Returns the virtualization descriptor of this machine, detected once on first use.
+ * @return A reference to a process-wide, immutable virt_info_t.
+ * @note Thread-safe. Prefer this in timing and affinity code: e.g. skip TSC calibration when
+ * invariant_tsc is false, or treat CPU ids as vCPUs that the host may migrate.
+ */
+[[nodiscard]] inline const virt_info_t &virtualization() {
+    static const virt_info_t cached = detect_virtualization();
+    return cached;
+}
+
+} // namespace saburou::platform::v2::os
@@ -0,0 +1,188 @@
+/**
+ * @file types.hpp
+ * @brief Runtime virtualization and cloud descriptor structures and formatters.
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/core.hpp>
+
+#include <cstdint>
+#include <format>
+#include <string>
+
+namespace saburou::platform::v2::os {
+
+/**
+ * @brief Hypervisor or sandbox kernel the process is running under.
+ */
+enum class hypervisor_t : uint8_t {
+    none,        // Bare metal (no hypervisor detected)
+    kvm,         // Linux KVM (QEMU, cloud-hypervisor, crosvm, ...)
+    firecracker, // Firecracker microVM (KVM based)
+    xen,         // Xen (HVM or PV)
+    hyperv,      // Microsoft Hyper-V
+    vmware,      // VMware ESXi/Workstation
+    virtualbox,  // Oracle VirtualBox
+    qemu,        // QEMU without KVM (TCG emulation)
+    bhyve,       // FreeBSD bhyve
+    parallels,   // Parallels Desktop
+    acrn,        // Project ACRN
+    gvisor,      // gVisor (runsc) user-space kernel
+    unknown      // Virtualized, but vendor not recognized
+};
+
+/**
+ * @brief Cloud provider inferred from firmware (DMI/SMBIOS) strings.
+ */
+enum class cloud_t : uint8_t {
+    none,         // No cloud provider detected
+    aws,          // Amazon EC2
+    gcp,          // Google Compute Engine
+    azure,        // Microsoft Azure
+    oracle,       // Oracle Cloud Infrastructure
+    alibaba,      // Alibaba Cloud ECS
+    digitalocean, // DigitalOcean Droplet
+    hetzner,      // Hetzner Cloud
+    openstack,    // Generic OpenStack Nova
+    unknown       // Reserved for providers without a stable signature
+};
+
+/**
+ * @brief Structured result of runtime virtualization detection.
+ * * Unlike SABUROU_PLATFORM_V2_DEVICE_CLOUD, which is a compile-time guess, this reflects the machine the
+ * binary actually runs on. Timing and affinity code can consult clocksource and invariant_tsc directly.
+ */
+struct virt_info_t {
+    hypervisor_t hypervisor = hypervisor_t::none; ///< Detected hypervisor or sandbox
+    cloud_t cloud = cloud_t::none;                ///< Detected cloud provider
+    bool cpuid_hypervisor_bit = false;            ///< CPUID.1:ECX[31] (x86 only)
+    bool invariant_tsc = false;                   ///< CPUID.80000007H:EDX[8] (x86 only)
+    std::string cpuid_vendor;                     ///< Hypervisor CPUID signature (e.g., "KVMKVMKVM")
+    std::string sys_vendor;                       ///< DMI sys_vendor
+    std::string product_name;                     ///< DMI product_name
+    std::string clocksource;                      ///< Current kernel clocksource (e.g., "kvm-clock", "tsc")
+
+    /** @brief True if any hypervisor or sandbox was detected. */
+    [[nodiscard]] constexpr bool is_virtualized() const noexcept { return hypervisor != hypervisor_t::none; }
+
+    /** @brief True if a cloud provider was recognized. */
+    [[nodiscard]] constexpr bool is_cloud() const noexcept { return cloud != cloud_t::none; }
+};
+
+/**
+ * @brief Converts a hypervisor_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(hypervisor_t h) {
+    switch (h) {
+    case hypervisor_t::none:        return "none";
+    case hypervisor_t::kvm:         return "kvm";
+    case hypervisor_t::firecracker: return "firecracker";
+    case hypervisor_t::xen:         return "xen";
+    case hypervisor_t::hyperv:      return "hyperv";
+    case hypervisor_t::vmware:      return "vmware";
+    case hypervisor_t::virtualbox:  return "virtualbox";
+    case hypervisor_t::qemu:        return "qemu";
+    case hypervisor_t::bhyve:       return "bhyve";
+    case hypervisor_t::parallels:   return "parallels";
+    case hypervisor_t::acrn:        return "acrn";
+    case hypervisor_t::gvisor:      return "gvisor";
+    default:                        return "unknown";
+    }
+}
+
+/**
+ * @brief Converts a cloud_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(cloud_t c) {
+    switch (c) {
+    case cloud_t::none:         return "none";
+    case cloud_t::aws:          return "aws";
+    case cloud_t::gcp:          return "gcp";
+    case cloud_t::azure:        return "azure";
+    case cloud_t::oracle:       return "oracle";
+    case cloud_t::alibaba:      return "alibaba";
+    case cloud_t::digitalocean: return "digitalocean";
+    case cloud_t::hetzner:      return "hetzner";
+    case cloud_t::openstack:    return "openstack";
+    default:                    return "unknown";
+    }
+}
+
+} // namespace saburou::platform::v2::os
+
+/**
+ * @brief std::formatter specialization for hypervisor_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "hypervisor_t::kvm").
+ */
+template <> struct std::formatter<saburou::platform::v2::os::hypervisor_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::os::hypervisor_t &h, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::os::to_code_name(h);
+        return repr ? std::format_to(ctx.out(), "hypervisor_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
+
+/**
+ * @brief std::formatter specialization for cloud_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "cloud_t::aws").
+ */
+template <> struct std::formatter<saburou::platform::v2::os::cloud_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::os::cloud_t &c, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::os::to_code_name(c);
+        return repr ? std::format_to(ctx.out(), "cloud_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
+
+/**
+ * @brief std::formatter specialization for virt_info_t.
+ * Supported format specifiers: {} or {:s} for a compact summary (omits empty fields),
+ * {:r} for full technical representation.
+ */
+template <> struct std::formatter<saburou::platform::v2::os::virt_info_t> {
+    bool repr = false;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it == end || *it == '}') return it;
+
+        if (*it == 'r') repr = true;
+        else if (*it == 's') repr = false;
+        else throw std::format_error("Invalid format for virt_info_t: use 'r' or 's'");
+
+        return ++it;
+    }
+
+    auto format(const saburou::platform::v2::os::virt_info_t &v, std::format_context &ctx) const {
+        if (repr) {
+            return std::format_to(ctx.out(),
+                                  "virt_info(hypervisor={:r}, cloud={:r}, cpuid_hypervisor_bit={}, invariant_tsc={}, "
+                                  "cpuid_vendor={}, sys_vendor={}, product_name={}, clocksource={})",
+                                  v.hypervisor, v.cloud, v.cpuid_hypervisor_bit, v.invariant_tsc, v.cpuid_vendor,
+                                  v.sys_vendor, v.product_name, v.clocksource);
+        }
+        auto out = std::format_to(ctx.out(), "virt_info(hypervisor={}, cloud={}", v.hypervisor, v.cloud);
+        if (!v.clocksource.empty()) out = std::format_to(out, ", clocksource={}", v.clocksource);
+        if (!v.product_name.empty()) out = std::format_to(out, ", product_name={}", v.product_name);
+        return std::format_to(out, ")");
+    }
+};
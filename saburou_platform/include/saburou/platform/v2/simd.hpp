@@ -0,0 +1,838 @@
+/**
+ * @file simd.hpp
+ * @brief Fixed-width SIMD value types, simd<T, N> and simd_mask<T, N>, written once for every ISA.
+ *
+ * The storage is a GCC/Clang vector type, so every operator compiles to the widest instructions enabled where
+ * it is used: the build baseline (SSE2, or AVX2/AVX-512 with -march, NEON, RVV, AltiVec), or AVX2 inside a
+ * SABUROU_PLATFORM_V2_TARGET("avx2") function. A kernel is thus written once as a template over the lane count
+ * and inlined into each dispatched entry point; all members are always_inline so they take on the target of
+ * their caller, and the kernel template needs the same (SABUROU_PLATFORM_V2_SIMD_INLINE), since the target
+ * attribute does not reach functions that are merely called. Compilers without vector types (MSVC) get a
+ * plain array with element loops.
+ *
+ * The interface follows std::experimental::simd where they overlap (element_aligned/vector_aligned loads,
+ * copy_to, reduce, simd_mask with any_of/all_of/popcount); endian-swapping loads and stores, compile-time
+ * shuffles and gathers are additions. A few operations (mask bits, gathers) use intrinsics when the build
+ * baseline has them and portable code otherwise.
+ *
+ * @code
+ * template <std::size_t N> SABUROU_PLATFORM_V2_SIMD_INLINE float dot(const float *a, const float *b, std::size_t n) {
+ *     simd<float, N> acc;
+ *     for (std::size_t i = 0; i + N <= n; i += N)
+ *         acc += simd<float, N>(a + i, element_aligned) * simd<float, N>(b + i, element_aligned);
+ *     return reduce(acc);
+ * }
+ * SABUROU_PLATFORM_V2_TARGET("avx2") float dot_avx2(const float *a, const float *b, std::size_t n) {
+ *     return dot<8>(a, b, n);
+ * }
+ * @endcode
+ */
+
+#pragma once
+
+#include <saburou/platform/v2/cpu/features.hpp>
+#include <saburou/platform/v2/detect.hpp>
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if SABUROU_PLATFORM_V2_GCC || SABUROU_PLATFORM_V2_CLANG
+#define SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES 1
+#define SABUROU_PLATFORM_V2_SIMD_INLINE [[gnu::always_inline]] inline
+// The builtin, unlike std::bit_cast, is not a function returning a vector, which GCC would flag under -Wpsabi.
+#define SABUROU_PLATFORM_V2_SIMD_BIT_CAST(To, x) __builtin_bit_cast(To, x)
+#else
+#define SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES 0
+#define SABUROU_PLATFORM_V2_SIMD_INLINE inline
+#define SABUROU_PLATFORM_V2_SIMD_BIT_CAST(To, x) std::bit_cast<To>(x)
+#endif
+
+#if SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES && SABUROU_PLATFORM_V2_ARCH_X86 && defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#if SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES && SABUROU_PLATFORM_V2_ARCH_ARM_64 && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#if SABUROU_PLATFORM_V2_GCC
+// Vectors wider than the baseline ISA warn that their by-value ABI differs between targets. Every function
+// here is always_inline into its caller, so no such call ever crosses a target boundary. GCC reports some
+// returns at the end of the translation unit, outside this pragma; -Wno-psabi silences those as well.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+namespace saburou::platform::v2 {
+
+/**
+ * @brief Vector instruction set the whole build targets (compiler flags, not the running CPU).
+ */
+enum class simd_isa_t : uint8_t {
+    scalar,  // element loops: no vector types, or no SIMD unit
+    sse2,    // x86-64 baseline
+    avx2,    // -mavx2 or an -march that includes it
+    avx512,  // -mavx512f -mavx512bw or an -march that includes them
+    neon,    // AArch64 Advanced SIMD
+    rvv,     // RISC-V V extension
+    altivec  // POWER VMX/VSX
+};
+
+/**
+ * @brief Converts a simd_isa_t value to its technical lowercase string representation.
+ */
+[[nodiscard]] constexpr const char *to_code_name(simd_isa_t isa) {
+    switch (isa) {
+    case simd_isa_t::scalar:  return "scalar";
+    case simd_isa_t::sse2:    return "sse2";
+    case simd_isa_t::avx2:    return "avx2";
+    case simd_isa_t::avx512:  return "avx512";
+    case simd_isa_t::neon:    return "neon";
+    case simd_isa_t::rvv:     return "rvv";
+    case simd_isa_t::altivec: return "altivec";
+    default:                  return "unknown";
+    }
+}
+
+/** @brief Widest vector ISA enabled for the whole build; it sizes native_simd. */
+inline constexpr simd_isa_t simd_native_isa =
+#if !SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES
+    simd_isa_t::scalar;
+#elif SABUROU_PLATFORM_V2_ARCH_X86 && defined(__AVX512F__) && defined(__AVX512BW__)
+    simd_isa_t::avx512;
+#elif SABUROU_PLATFORM_V2_ARCH_X86 && defined(__AVX2__)
+    simd_isa_t::avx2;
+#elif SABUROU_PLATFORM_V2_ARCH_X86 && defined(__SSE2__)
+    simd_isa_t::sse2;
+#elif SABUROU_PLATFORM_V2_ARCH_ARM_64 && defined(__ARM_NEON)
+    simd_isa_t::neon;
+#elif SABUROU_PLATFORM_V2_ARCH_RISCV && defined(__riscv_vector)
+    simd_isa_t::rvv;
+#elif SABUROU_PLATFORM_V2_ARCH_PPC && defined(__ALTIVEC__)
+    simd_isa_t::altivec;
+#else
+    simd_isa_t::scalar;
+#endif
+
+/**
+ * @brief Register width in bytes for simd_native_isa.
+ * * RVV registers are sized at run time; 16 bytes is the minimum VLEN of the application profiles.
+ */
+inline constexpr std::size_t simd_native_bytes = simd_native_isa == simd_isa_t::avx512 ? 64
+                                                 : simd_native_isa == simd_isa_t::avx2 ? 32
+                                                                                        : 16;
+
+/**
+ * @concept SimdElement
+ * @brief Lane types of simd: integers of 1 to 8 bytes (not bool) and float/double.
+ */
+template <class T>
+concept SimdElement = (std::integral<T> || std::same_as<T, float> || std::same_as<T, double>) &&
+                      !std::same_as<T, bool> && sizeof(T) <= 8;
+
+/** @brief Load/store flag: the pointer only needs the alignment of T. */
+struct element_aligned_tag {};
+/** @brief Load/store flag: the pointer is aligned to the full vector size. */
+struct vector_aligned_tag {};
+inline constexpr element_aligned_tag element_aligned{};
+inline constexpr vector_aligned_tag vector_aligned{};
+
+template <SimdElement T, std::size_t N>
+    requires(std::has_single_bit(N) && N * sizeof(T) <= 64)
+class simd;
+
+template <SimdElement T, std::size_t N>
+    requires(std::has_single_bit(N) && N * sizeof(T) <= 64)
+class simd_mask;
+
+namespace detail {
+
+template <std::size_t Size> struct simd_lane_int;
+template <> struct simd_lane_int<1> { using type = int8_t; };
+template <> struct simd_lane_int<2> { using type = int16_t; };
+template <> struct simd_lane_int<4> { using type = int32_t; };
+template <> struct simd_lane_int<8> { using type = int64_t; };
+
+/** @brief Signed integer of @p Size bytes: the lane type of masks (all ones or zero). */
+template <std::size_t Size> using simd_lane_int_t = typename simd_lane_int<Size>::type;
+
+/** @brief Lane type arithmetic runs in: unsigned for signed integers, T otherwise. */
+template <class T> struct simd_wrap_lane { using type = T; };
+template <std::signed_integral T> struct simd_wrap_lane<T> { using type = std::make_unsigned_t<T>; };
+
+#if SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES
+template <class T, std::size_t N> struct simd_vector {
+    using type [[gnu::vector_size(sizeof(T) * N)]] = T;
+};
+
+template <class T, std::size_t N> using simd_storage_t = typename simd_vector<T, N>::type;
+#else
+/** @brief Portable storage: the element-wise operators of a compiler vector type, as loops. */
+template <class T, std::size_t N> struct simd_array {
+    T v[N];
+
+    T &operator[](std::size_t i) noexcept { return v[i]; }
+    T operator[](std::size_t i) const noexcept { return v[i]; }
+
+    // Integer lanes wrap as in hardware: computed in at least unsigned, so uint16_t * uint16_t cannot
+    // overflow a promoted int. Division keeps T's own semantics (signed quotients must stay signed).
+    using wrap_t = std::common_type_t<typename simd_wrap_lane<T>::type, unsigned>;
+
+#define SABUROU_PLATFORM_V2_SIMD_ARRAY_OP(op, U)                                                                    \
+    friend simd_array operator op(simd_array a, const simd_array &b) noexcept {                                     \
+        for (std::size_t i = 0; i < N; ++i)                                                                         \
+            a.v[i] = static_cast<T>(static_cast<U>(a.v[i]) op static_cast<U>(b.v[i]));                              \
+        return a;                                                                                                   \
+    }
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_OP(+, wrap_t)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_OP(-, wrap_t)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_OP(*, wrap_t)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_OP(/, T)
+#undef SABUROU_PLATFORM_V2_SIMD_ARRAY_OP
+
+#define SABUROU_PLATFORM_V2_SIMD_ARRAY_INT_OP(op)                                                                   \
+    friend simd_array operator op(simd_array a, const simd_array &b) noexcept                                       \
+        requires std::integral<T>                                                                                   \
+    {                                                                                                               \
+        for (std::size_t i = 0; i < N; ++i) a.v[i] = static_cast<T>(a.v[i] op b.v[i]);                              \
+        return a;                                                                                                   \
+    }
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_INT_OP(%)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_INT_OP(&)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_INT_OP(|)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_INT_OP(^)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_INT_OP(<<)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_INT_OP(>>)
+#undef SABUROU_PLATFORM_V2_SIMD_ARRAY_INT_OP
+
+#define SABUROU_PLATFORM_V2_SIMD_ARRAY_CMP(op)                                                                      \
+    friend simd_array<simd_lane_int_t<sizeof(T)>, N> operator op(const simd_array &a, const simd_array &b) noexcept { \
+        simd_array<simd_lane_int_t<sizeof(T)>, N> r;                                                                \
+        for (std::size_t i = 0; i < N; ++i) r.v[i] = a.v[i] op b.v[i] ? -1 : 0;                                     \
+        return r;                                                                                                   \
+    }
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_CMP(==)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_CMP(!=)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_CMP(<)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_CMP(<=)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_CMP(>)
+    SABUROU_PLATFORM_V2_SIMD_ARRAY_CMP(>=)
+#undef SABUROU_PLATFORM_V2_SIMD_ARRAY_CMP
+
+    friend simd_array operator-(simd_array a) noexcept {
+        for (std::size_t i = 0; i < N; ++i) a.v[i] = static_cast<T>(-a.v[i]);
+        return a;
+    }
+    friend simd_array operator~(simd_array a) noexcept
+        requires std::integral<T>
+    {
+        for (std::size_t i = 0; i < N; ++i) a.v[i] = static_cast<T>(~a.v[i]);
+        return a;
+    }
+};
+
+template <class T, std::size_t N> using simd_storage_t = simd_array<T, N>;
+#endif
+
+/** @brief Sets every lane of @p out to @p x (an out-parameter, as nothing here returns a raw vector). */
+template <class T, std::size_t N>
+SABUROU_PLATFORM_V2_SIMD_INLINE void simd_splat(simd_storage_t<T, N> &out, T x) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES
+    out = simd_storage_t<T, N>{} + x;
+#else
+    for (std::size_t i = 0; i < N; ++i) out.v[i] = x;
+#endif
+}
+
+/** @brief Lanes of @p v picked by compile-time indices @p I (any count, each below N). */
+template <class T, std::size_t N, std::size_t... I>
+SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, sizeof...(I)> simd_pick(const simd_storage_t<T, N> &v) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES
+    return simd<T, sizeof...(I)>(__builtin_shufflevector(v, v, I...));
+#else
+    return simd<T, sizeof...(I)>(simd_storage_t<T, sizeof...(I)>{{v.v[I]...}});
+#endif
+}
+
+template <class T, std::size_t N, std::size_t... J>
+SABUROU_PLATFORM_V2_SIMD_INLINE simd<uint8_t, N * sizeof(T)> simd_swap_lane_bytes(const simd_storage_t<T, N> &v,
+                                                                                  std::index_sequence<J...>) noexcept {
+    constexpr std::size_t s = sizeof(T);
+    using bytes_t = simd_storage_t<uint8_t, N * sizeof(T)>;
+    const bytes_t bytes = SABUROU_PLATFORM_V2_SIMD_BIT_CAST(bytes_t, v);
+    return simd_pick<uint8_t, N * sizeof(T), (J / s * s + s - 1 - J % s)...>(bytes);
+}
+
+} // namespace detail
+
+/**
+ * @brief N lanes of T in one value; arithmetic, comparisons and bitwise operators work lane by lane.
+ * @tparam T Lane type (SimdElement).
+ * @tparam N Lane count: a power of two, at most 64 bytes in total. Widths above the ISA's registers are
+ * split by the compiler, so simd<float, 16> is two AVX2 or four SSE2/NEON registers.
+ */
+template <SimdElement T, std::size_t N>
+    requires(std::has_single_bit(N) && N * sizeof(T) <= 64)
+class simd {
+public:
+    using value_type = T;
+    using mask_type = simd_mask<T, N>;
+    using storage_type = detail::simd_storage_t<T, N>;
+
+    [[nodiscard]] static constexpr std::size_t size() noexcept { return N; }
+
+    /** @brief All lanes zero. */
+    SABUROU_PLATFORM_V2_SIMD_INLINE simd() noexcept : v_{} {}
+
+    /** @brief All lanes @p x (implicit, so scalars mix with vectors in expressions). */
+    SABUROU_PLATFORM_V2_SIMD_INLINE simd(T x) noexcept { detail::simd_splat<T, N>(v_, x); }
+
+    SABUROU_PLATFORM_V2_SIMD_INLINE explicit simd(const storage_type &v) noexcept : v_(v) {}
+
+    /** @brief Loads N values from @p p. */
+    SABUROU_PLATFORM_V2_SIMD_INLINE simd(const T *p, element_aligned_tag) noexcept { std::memcpy(&v_, p, sizeof(v_)); }
+
+    /** @brief Loads N values from @p p. @pre @p p is aligned to sizeof(simd). */
+    SABUROU_PLATFORM_V2_SIMD_INLINE simd(const T *p, vector_aligned_tag) noexcept {
+        std::memcpy(&v_, std::assume_aligned<sizeof(storage_type)>(p), sizeof(v_));
+    }
+
+    /** @brief Lane i is f(i), for i in [0, N). */
+    template <class F> [[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE static simd generate(F &&f) noexcept {
+        simd r;
+        for (std::size_t i = 0; i < N; ++i) r.v_[i] = static_cast<T>(f(i));
+        return r;
+    }
+
+    /** @brief Loads N little-endian values from unaligned bytes. */
+    [[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE static simd load_little(const void *p) noexcept {
+        simd r(static_cast<const T *>(p), element_aligned);
+        if constexpr (std::endian::native == std::endian::big) r = byte_swap(r);
+        return r;
+    }
+
+    /** @brief Loads N big-endian values from unaligned bytes. */
+    [[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE static simd load_big(const void *p) noexcept {
+        simd r(static_cast<const T *>(p), element_aligned);
+        if constexpr (std::endian::native == std::endian::little) r = byte_swap(r);
+        return r;
+    }
+
+    SABUROU_PLATFORM_V2_SIMD_INLINE void copy_from(const T *p, element_aligned_tag t) noexcept { *this = simd(p, t); }
+    SABUROU_PLATFORM_V2_SIMD_INLINE void copy_from(const T *p, vector_aligned_tag t) noexcept { *this = simd(p, t); }
+
+    SABUROU_PLATFORM_V2_SIMD_INLINE void copy_to(T *p, element_aligned_tag) const noexcept {
+        std::memcpy(p, &v_, sizeof(v_));
+    }
+
+    /** @pre @p p is aligned to sizeof(simd). */
+    SABUROU_PLATFORM_V2_SIMD_INLINE void copy_to(T *p, vector_aligned_tag) const noexcept {
+        std::memcpy(std::assume_aligned<sizeof(storage_type)>(p), &v_, sizeof(v_));
+    }
+
+    SABUROU_PLATFORM_V2_SIMD_INLINE void store_little(void *p) const noexcept {
+        simd v = std::endian::native == std::endian::big ? byte_swap(*this) : *this;
+        v.copy_to(static_cast<T *>(p), element_aligned);
+    }
+
+    SABUROU_PLATFORM_V2_SIMD_INLINE void store_big(void *p) const noexcept {
+        simd v = std::endian::native == std::endian::little ? byte_swap(*this) : *this;
+        v.copy_to(static_cast<T *>(p), element_aligned);
+    }
+
+    [[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE T operator[](std::size_t i) const noexcept { return v_[i]; }
+
+    /** @brief The compiler vector (or array) holding the lanes, for interop with intrinsics. */
+    [[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE const storage_type &storage() const noexcept { return v_; }
+
+    // -- Arithmetic --
+
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator+(const simd &a, const simd &b) noexcept {
+        if constexpr (std::signed_integral<T>) return from_wrap(a.to_wrap() + b.to_wrap());
+        else return simd(a.v_ + b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator-(const simd &a, const simd &b) noexcept {
+        if constexpr (std::signed_integral<T>) return from_wrap(a.to_wrap() - b.to_wrap());
+        else return simd(a.v_ - b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator*(const simd &a, const simd &b) noexcept {
+        if constexpr (std::signed_integral<T>) return from_wrap(a.to_wrap() * b.to_wrap());
+        else return simd(a.v_ * b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator/(const simd &a, const simd &b) noexcept {
+        return simd(a.v_ / b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator-(const simd &a) noexcept {
+        if constexpr (std::signed_integral<T>) return from_wrap(-a.to_wrap());
+        else if constexpr (std::integral<T>) return simd(storage_type{} - a.v_);
+        else return simd(-a.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator+(const simd &a) noexcept { return a; }
+
+    // -- Integer-only: remainder, bitwise, shifts (arithmetic right shift for signed lanes) --
+
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator%(const simd &a, const simd &b) noexcept
+        requires std::integral<T>
+    {
+        return simd(a.v_ % b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator&(const simd &a, const simd &b) noexcept
+        requires std::integral<T>
+    {
+        return simd(a.v_ & b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator|(const simd &a, const simd &b) noexcept
+        requires std::integral<T>
+    {
+        return simd(a.v_ | b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator^(const simd &a, const simd &b) noexcept
+        requires std::integral<T>
+    {
+        return simd(a.v_ ^ b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator~(const simd &a) noexcept
+        requires std::integral<T>
+    {
+        return simd(~a.v_);
+    }
+    /** @pre Each shift count is below the lane width in bits. */
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator<<(const simd &a, const simd &n) noexcept
+        requires std::integral<T>
+    {
+        return simd(a.v_ << n.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator>>(const simd &a, const simd &n) noexcept
+        requires std::integral<T>
+    {
+        return simd(a.v_ >> n.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator<<(const simd &a, int n) noexcept
+        requires std::integral<T>
+    {
+        return a << simd(static_cast<T>(n));
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd operator>>(const simd &a, int n) noexcept
+        requires std::integral<T>
+    {
+        return a >> simd(static_cast<T>(n));
+    }
+
+    SABUROU_PLATFORM_V2_SIMD_INLINE simd &operator+=(const simd &b) noexcept { return *this = *this + b; }
+    SABUROU_PLATFORM_V2_SIMD_INLINE simd &operator-=(const simd &b) noexcept { return *this = *this - b; }
+    SABUROU_PLATFORM_V2_SIMD_INLINE simd &operator*=(const simd &b) noexcept { return *this = *this * b; }
+    SABUROU_PLATFORM_V2_SIMD_INLINE simd &operator/=(const simd &b) noexcept { return *this = *this / b; }
+    SABUROU_PLATFORM_V2_SIMD_INLINE simd &operator&=(const simd &b) noexcept
+        requires std::integral<T>
+    {
+        return *this = *this & b;
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE simd &operator|=(const simd &b) noexcept
+        requires std::integral<T>
+    {
+        return *this = *this | b;
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE simd &operator^=(const simd &b) noexcept
+        requires std::integral<T>
+    {
+        return *this = *this ^ b;
+    }
+
+    // -- Comparisons --
+
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend mask_type operator==(const simd &a, const simd &b) noexcept {
+        return mask_type(a.v_ == b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend mask_type operator!=(const simd &a, const simd &b) noexcept {
+        return mask_type(a.v_ != b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend mask_type operator<(const simd &a, const simd &b) noexcept {
+        return mask_type(a.v_ < b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend mask_type operator<=(const simd &a, const simd &b) noexcept {
+        return mask_type(a.v_ <= b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend mask_type operator>(const simd &a, const simd &b) noexcept {
+        return mask_type(a.v_ > b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend mask_type operator>=(const simd &a, const simd &b) noexcept {
+        return mask_type(a.v_ >= b.v_);
+    }
+
+    /** @brief Every lane with its bytes reversed (endianness swap). */
+    [[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE friend simd byte_swap(const simd &a) noexcept {
+        if constexpr (sizeof(T) == 1) {
+            return a;
+        } else {
+            auto bytes = detail::simd_swap_lane_bytes<T, N>(a.v_, std::make_index_sequence<N * sizeof(T)>{});
+            return simd(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(storage_type, bytes.storage()));
+        }
+    }
+
+private:
+    // Signed lanes add, subtract and multiply as unsigned, so overflow wraps like the instructions instead of
+    // being undefined.
+    using wrap_simd = simd<typename detail::simd_wrap_lane<T>::type, N>;
+    using wrap_storage = typename wrap_simd::storage_type;
+
+    SABUROU_PLATFORM_V2_SIMD_INLINE wrap_simd to_wrap() const noexcept {
+        return wrap_simd(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(wrap_storage, v_));
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE static simd from_wrap(const wrap_simd &w) noexcept {
+        return simd(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(storage_type, w.storage()));
+    }
+
+    storage_type v_;
+};
+
+/**
+ * @brief Per-lane booleans produced by simd comparisons, stored as all-ones/zero lanes of T's width.
+ */
+template <SimdElement T, std::size_t N>
+    requires(std::has_single_bit(N) && N * sizeof(T) <= 64)
+class simd_mask {
+public:
+    using simd_type = simd<T, N>;
+    using lane_type = detail::simd_lane_int_t<sizeof(T)>;
+    using storage_type = detail::simd_storage_t<lane_type, N>;
+
+    [[nodiscard]] static constexpr std::size_t size() noexcept { return N; }
+
+    /** @brief All lanes false. */
+    SABUROU_PLATFORM_V2_SIMD_INLINE simd_mask() noexcept : v_{} {}
+
+    /** @brief All lanes @p b. */
+    SABUROU_PLATFORM_V2_SIMD_INLINE explicit simd_mask(bool b) noexcept {
+        detail::simd_splat<lane_type, N>(v_, static_cast<lane_type>(b ? -1 : 0));
+    }
+
+    /** @pre Every lane of @p v is 0 or -1. */
+    SABUROU_PLATFORM_V2_SIMD_INLINE explicit simd_mask(const storage_type &v) noexcept : v_(v) {}
+
+    /** @brief Lane i is set if bit i of @p bits is. */
+    [[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE static simd_mask from_bits(uint64_t bits) noexcept {
+        simd_mask m;
+        for (std::size_t i = 0; i < N; ++i) m.v_[i] = static_cast<lane_type>((bits >> i & 1) ? -1 : 0);
+        return m;
+    }
+
+    [[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE bool operator[](std::size_t i) const noexcept { return v_[i] != 0; }
+
+    [[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE const storage_type &storage() const noexcept { return v_; }
+
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd_mask operator&&(const simd_mask &a, const simd_mask &b) noexcept {
+        return simd_mask(a.v_ & b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd_mask operator||(const simd_mask &a, const simd_mask &b) noexcept {
+        return simd_mask(a.v_ | b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd_mask operator&(const simd_mask &a, const simd_mask &b) noexcept {
+        return simd_mask(a.v_ & b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd_mask operator|(const simd_mask &a, const simd_mask &b) noexcept {
+        return simd_mask(a.v_ | b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd_mask operator^(const simd_mask &a, const simd_mask &b) noexcept {
+        return simd_mask(a.v_ ^ b.v_);
+    }
+    SABUROU_PLATFORM_V2_SIMD_INLINE friend simd_mask operator!(const simd_mask &a) noexcept {
+        return simd_mask(~a.v_);
+    }
+
+private:
+    storage_type v_;
+};
+
+/** @brief The widest simd of T for the build's ISA (simd_native_bytes). */
+template <SimdElement T> using native_simd = simd<T, simd_native_bytes / sizeof(T)>;
+template <SimdElement T> using native_simd_mask = simd_mask<T, simd_native_bytes / sizeof(T)>;
+
+// -- Masks --
+
+/** @brief Bit i set for each set lane i (a movemask). */
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE uint64_t to_bits(const simd_mask<T, N> &m) noexcept {
+    const auto &v = m.storage();
+#if SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES && SABUROU_PLATFORM_V2_ARCH_X86 && defined(__SSE2__)
+    if constexpr (sizeof(v) == 16) {
+        const __m128i x = SABUROU_PLATFORM_V2_SIMD_BIT_CAST(__m128i, v);
+        if constexpr (sizeof(T) == 1) return unsigned(_mm_movemask_epi8(x));
+        if constexpr (sizeof(T) == 2) return unsigned(_mm_movemask_epi8(_mm_packs_epi16(x, x))) & 0xFF;
+        if constexpr (sizeof(T) == 4) return unsigned(_mm_movemask_ps(_mm_castsi128_ps(x)));
+        if constexpr (sizeof(T) == 8) return unsigned(_mm_movemask_pd(_mm_castsi128_pd(x)));
+    }
+#if defined(__AVX2__)
+    if constexpr (sizeof(v) == 32) {
+        const __m256i x = SABUROU_PLATFORM_V2_SIMD_BIT_CAST(__m256i, v);
+        if constexpr (sizeof(T) == 1) return uint32_t(_mm256_movemask_epi8(x));
+        if constexpr (sizeof(T) == 4) return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(x)));
+        if constexpr (sizeof(T) == 8) return unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(x)));
+    }
+#endif
+#if defined(__AVX512BW__)
+    if constexpr (sizeof(v) == 64) {
+        const __m512i x = SABUROU_PLATFORM_V2_SIMD_BIT_CAST(__m512i, v);
+        if constexpr (sizeof(T) == 1) return _mm512_movepi8_mask(x);
+        if constexpr (sizeof(T) == 2) return _mm512_movepi16_mask(x);
+    }
+#endif
+#endif
+    uint64_t bits = 0;
+    for (std::size_t i = 0; i < N; ++i) bits |= static_cast<uint64_t>(v[i] & 1) << i;
+    return bits;
+}
+
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE bool any_of(const simd_mask<T, N> &m) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES && SABUROU_PLATFORM_V2_ARCH_ARM_64 && defined(__ARM_NEON)
+    if constexpr (sizeof(m.storage()) == 16) {
+        return vmaxvq_u8(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(uint8x16_t, m.storage())) != 0;
+    }
+#endif
+    return to_bits(m) != 0;
+}
+
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE bool all_of(const simd_mask<T, N> &m) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES && SABUROU_PLATFORM_V2_ARCH_ARM_64 && defined(__ARM_NEON)
+    if constexpr (sizeof(m.storage()) == 16) {
+        return vminvq_u8(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(uint8x16_t, m.storage())) == 0xFF;
+    }
+#endif
+    return to_bits(m) == (N == 64 ? ~uint64_t{0} : (uint64_t{1} << N) - 1);
+}
+
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE bool none_of(const simd_mask<T, N> &m) noexcept {
+    return !any_of(m);
+}
+
+/** @brief Number of set lanes. */
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE int popcount(const simd_mask<T, N> &m) noexcept {
+    return std::popcount(to_bits(m));
+}
+
+/** @brief Index of the first set lane. @pre any_of(m). */
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE int find_first_set(const simd_mask<T, N> &m) noexcept {
+    return std::countr_zero(to_bits(m));
+}
+
+// -- Lane-wise functions --
+
+/** @brief Lanes of @p a where @p m is set, of @p b elsewhere. */
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, N> select(const simd_mask<T, N> &m, const simd<T, N> &a,
+                                                              const simd<T, N> &b) noexcept {
+    using bits_t = typename simd_mask<T, N>::storage_type;
+    using storage_t = typename simd<T, N>::storage_type;
+    bits_t x = SABUROU_PLATFORM_V2_SIMD_BIT_CAST(bits_t, a.storage());
+    bits_t y = SABUROU_PLATFORM_V2_SIMD_BIT_CAST(bits_t, b.storage());
+    bits_t r = (x & m.storage()) | (y & ~m.storage());
+    return simd<T, N>(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(storage_t, r));
+}
+
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, N> min(const simd<T, N> &a, const simd<T, N> &b) noexcept {
+    return select(b < a, b, a);
+}
+
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, N> max(const simd<T, N> &a, const simd<T, N> &b) noexcept {
+    return select(a < b, b, a);
+}
+
+/** @brief Absolute value; floats clear the sign bit (so -0 and NaN keep their payload), integers wrap at MIN. */
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, N> abs(const simd<T, N> &a) noexcept {
+    if constexpr (std::floating_point<T>) {
+        using bits_t = typename simd_mask<T, N>::storage_type;
+        using lane_t = typename simd_mask<T, N>::lane_type;
+        using storage_t = typename simd<T, N>::storage_type;
+        bits_t magnitude;
+        detail::simd_splat<lane_t, N>(magnitude, std::numeric_limits<lane_t>::max());
+        bits_t x = SABUROU_PLATFORM_V2_SIMD_BIT_CAST(bits_t, a.storage()) & magnitude;
+        return simd<T, N>(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(storage_t, x));
+    } else if constexpr (std::is_signed_v<T>) {
+        return select(a < simd<T, N>(T{0}), -a, a);
+    } else {
+        return a;
+    }
+}
+
+/** @brief Each lane converted to U as by static_cast. */
+template <SimdElement U, class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE simd<U, N> simd_cast(const simd<T, N> &a) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES
+    return simd<U, N>(__builtin_convertvector(a.storage(), detail::simd_storage_t<U, N>));
+#else
+    return simd<U, N>::generate([&](std::size_t i) { return static_cast<U>(a[i]); });
+#endif
+}
+
+// -- Shuffles --
+
+/**
+ * @brief Lanes of @p a at compile-time indices @p I; the result has sizeof...(I) lanes.
+ * @code
+ * auto swapped = shuffle<1, 0, 3, 2>(v);      // swap neighbours
+ * auto low = shuffle<0, 1, 2, 3>(simd8);       // lower half as simd<T, 4>
+ * @endcode
+ */
+template <std::size_t... I, class T, std::size_t N>
+    requires(sizeof...(I) > 0 && ((I < N) && ...))
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, sizeof...(I)> shuffle(const simd<T, N> &a) noexcept {
+    return detail::simd_pick<T, N, I...>(a.storage());
+}
+
+namespace detail {
+
+template <class T, std::size_t N, std::size_t... I>
+SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, N / 2> simd_lower(const simd<T, N> &a, std::index_sequence<I...>) noexcept {
+    return shuffle<I...>(a);
+}
+
+template <class T, std::size_t N, std::size_t... I>
+SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, N / 2> simd_upper(const simd<T, N> &a, std::index_sequence<I...>) noexcept {
+    return shuffle<(N / 2 + I)...>(a);
+}
+
+template <class T, std::size_t N, std::size_t... I>
+SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, N> simd_reverse(const simd<T, N> &a, std::index_sequence<I...>) noexcept {
+    return shuffle<(N - 1 - I)...>(a);
+}
+
+template <class T, std::size_t N, std::size_t... I>
+SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, 2 * N> simd_concat(const simd<T, N> &a, const simd<T, N> &b,
+                                                           std::index_sequence<I...>) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES
+    return simd<T, 2 * N>(__builtin_shufflevector(a.storage(), b.storage(), I...));
+#else
+    return simd<T, 2 * N>::generate([&](std::size_t i) { return i < N ? a[i] : b[i - N]; });
+#endif
+}
+
+} // namespace detail
+
+/** @brief Lanes [0, N/2) of @p a. */
+template <class T, std::size_t N>
+    requires(N > 1)
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, N / 2> lower_half(const simd<T, N> &a) noexcept {
+    return detail::simd_lower(a, std::make_index_sequence<N / 2>{});
+}
+
+/** @brief Lanes [N/2, N) of @p a. */
+template <class T, std::size_t N>
+    requires(N > 1)
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, N / 2> upper_half(const simd<T, N> &a) noexcept {
+    return detail::simd_upper(a, std::make_index_sequence<N / 2>{});
+}
+
+/** @brief The lanes of @p a followed by those of @p b. */
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, 2 * N> concat(const simd<T, N> &a,
+                                                                   const simd<T, N> &b) noexcept {
+    return detail::simd_concat(a, b, std::make_index_sequence<2 * N>{});
+}
+
+/** @brief Lanes in reverse order. */
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, N> reverse(const simd<T, N> &a) noexcept {
+    return detail::simd_reverse(a, std::make_index_sequence<N>{});
+}
+
+// -- Reductions: pairwise halving, log2(N) vector steps --
+
+/** @brief Sum of all lanes (integer lanes wrap; float order is pairwise, not left to right). */
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE T reduce(const simd<T, N> &a) noexcept {
+    if constexpr (N == 1) return a[0];
+    else return reduce(lower_half(a) + upper_half(a));
+}
+
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE T reduce_min(const simd<T, N> &a) noexcept {
+    if constexpr (N == 1) return a[0];
+    else return reduce_min(min(lower_half(a), upper_half(a)));
+}
+
+template <class T, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE T reduce_max(const simd<T, N> &a) noexcept {
+    if constexpr (N == 1) return a[0];
+    else return reduce_max(max(lower_half(a), upper_half(a)));
+}
+
+// -- Gather --
+
+/**
+ * @brief Lane i is base[idx[i]].
+ * * Uses VPGATHERD* when the build baseline has AVX2 (AVX-512 for 16 lanes) and 32-bit lanes and indices;
+ * otherwise N scalar loads, which is also what gathers cost on most cores.
+ */
+template <class T, std::integral I, std::size_t N>
+[[nodiscard]] SABUROU_PLATFORM_V2_SIMD_INLINE simd<T, N> gather(const T *base, const simd<I, N> &idx) noexcept {
+#if SABUROU_PLATFORM_V2_SIMD_VECTOR_TYPES && SABUROU_PLATFORM_V2_ARCH_X86 && defined(__AVX2__)
+    using storage_t = typename simd<T, N>::storage_type;
+    const auto *ints = reinterpret_cast<const int *>(base);
+    if constexpr (sizeof(T) == 4 && sizeof(I) == 4 && N == 8) {
+        __m256i i = SABUROU_PLATFORM_V2_SIMD_BIT_CAST(__m256i, idx.storage());
+        if constexpr (std::floating_point<T>) {
+            return simd<T, N>(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(storage_t, _mm256_i32gather_ps(base, i, 4)));
+        } else {
+            return simd<T, N>(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(storage_t, _mm256_i32gather_epi32(ints, i, 4)));
+        }
+    }
+#if defined(__AVX512F__)
+    if constexpr (sizeof(T) == 4 && sizeof(I) == 4 && N == 16) {
+        // Full-mask forms, as in xxh3_kernels.hpp: the unmasked ones trip GCC 12's -Wuninitialized.
+        __m512i i = SABUROU_PLATFORM_V2_SIMD_BIT_CAST(__m512i, idx.storage());
+        if constexpr (std::floating_point<T>) {
+            __m512 z = _mm512_setzero_ps();
+            const __m512 g = _mm512_mask_i32gather_ps(z, 0xFFFF, i, base, 4);
+            return simd<T, N>(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(storage_t, g));
+        } else {
+            __m512i z = _mm512_setzero_si512();
+            const __m512i g = _mm512_mask_i32gather_epi32(z, 0xFFFF, i, ints, 4);
+            return simd<T, N>(SABUROU_PLATFORM_V2_SIMD_BIT_CAST(storage_t, g));
+        }
+    }
+#endif
+    (void)ints;
+#endif
+    return simd<T, N>::generate([&](std::size_t i) { return base[idx[i]]; });
+}
+
+} // namespace saburou::platform::v2
+
+#if SABUROU_PLATFORM_V2_GCC
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * @brief std::formatter specialization for simd_isa_t.
+ * Supported format specifiers: {} or {:s} for technical lowercase name, {:r} for qualified representation (e.g., "simd_isa_t::avx2").
+ */
+template <> struct std::formatter<saburou::platform::v2::simd_isa_t> {
+    bool repr = false;
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = ctx.begin(), end = ctx.end();
+        if (it != end && *it == 'r') {
+            repr = true;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const saburou::platform::v2::simd_isa_t &isa, std::format_context &ctx) const {
+        auto name = saburou::platform::v2::to_code_name(isa);
+        return repr ? std::format_to(ctx.out(), "simd_isa_t::{}", name) : std::format_to(ctx.out(), "{}", name);
+    }
+};
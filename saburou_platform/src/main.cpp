@@ -2,10 +2,20 @@
 #include <saburou/platform/v2/os/linux.hpp> // distro_info
 
 #include <saburou/platform/v2/bytes/byte_swap.hpp>
+#include <saburou/platform/v2/bytes/crc.hpp>
 #include <saburou/platform/v2/bytes/endian.hpp>
+#include <saburou/platform/v2/bytes/mem.hpp>
+#include <saburou/platform/v2/bytes/radix_sort.hpp>
+#include <saburou/platform/v2/bytes/xxh3.hpp>
+#include <saburou/platform/v2/cpu/features.hpp>
+#include <saburou/platform/v2/memory/malloc.hpp>
 
+#include <algorithm>
 #include <format>
 #include <iostream>
+#include <span>
+#include <string>
+#include <vector>
 
 namespace os = saburou::platform::v2::os;
 
@@ -37,6 +47,77 @@ int main() {
     std::cout << std::format("[normal]  {}\n", distro_info); // same as :s
 
 
+    std::cout << "\n";
+    namespace procfs = os::linux::procfs;
+    procfs::source<procfs::loadavg_t> loadavg; // descriptor stays open, every read() is a pread
+    std::cout << "loadavg\n";
+    std::cout << std::format("  [repr]  {:r}\n", loadavg.read());
+    std::cout << std::format("[normal]  {}\n", loadavg.read());
+
+
+    std::cout << "\n";
+    auto usage = os::process::usage();
+    std::cout << "(process_)usage\n";
+    std::cout << std::format("  [repr]  {:r}\n", usage);
+    std::cout << std::format("[normal]  {}\n", usage);
+    std::cout << std::format(" [delta]  {}\n", os::process::usage() - usage);
+
+
+    std::cout << "\n";
+    const auto &kernel_features = os::linux::kernel_features(); // probed once, cached
+    std::cout << "kernel_features\n";
+    std::cout << std::format("  [repr]  {:r}\n", kernel_features);
+    std::cout << std::format("[normal]  {}\n", kernel_features);
+
+
+    std::cout << "\n";
+    const auto &virt = os::virtualization(); // detected once, cached
+    std::cout << "virtualization\n";
+    std::cout << std::format("  [repr]  {:r}\n", virt);
+    std::cout << std::format("[normal]  {}\n", virt);
+
+
+    std::cout << "\n";
+    auto block_device = os::linux::block_device_info("."); // device backing the working directory
+    std::cout << "block_device_info\n";
+    std::cout << std::format("  [repr]  {:r}\n", block_device);
+    std::cout << std::format("[normal]  {}\n", block_device);
+
+
+    std::cout << "\n";
+    namespace memory = saburou::platform::v2::memory;
+    const auto &allocator = memory::allocator_info(); // detected once, cached
+    std::cout << "allocator_info\n";
+    std::cout << std::format("  [repr]  {:r}\n", allocator);
+    std::cout << std::format("[normal]  {}\n", allocator);
+    auto heap = memory::heap_stats();
+    std::cout << "heap_stats\n";
+    std::cout << std::format("  [repr]  {:r}\n", heap);
+    std::cout << std::format("[normal]  {}\n", heap);
+
+
+    std::cout << "\n";
+    namespace cpu = saburou::platform::v2::cpu;
+    std::cout << "cpu_features\n";
+    std::cout << std::format("  [repr]  {:r}\n", cpu::features());
+    std::cout << std::format("[normal]  {}\n", cpu::features());
+    std::cout << std::format("bytes::mem_backend: {:r}\n", saburou::platform::v2::bytes::mem_backend());
+    std::cout << std::format("bytes::crc32c(\"123456789\"): {:#010x}\n",
+                             saburou::platform::v2::bytes::crc32c("123456789", 9));
+    auto digest = saburou::platform::v2::bytes::xxh3_128("123456789", 9);
+    std::cout << "bytes::xxh3_128(\"123456789\")\n";
+    std::cout << std::format("  [repr]  {:r}\n", digest);
+    std::cout << std::format("[normal]  {}\n", digest);
+    // Nested prefixes ("a", "aa", "aaa", ...) share every byte but one: the deepest case for the MSD sort.
+    std::string prefixes(10000, 'a');
+    std::vector<std::span<const std::byte>> nested;
+    for (std::size_t n = prefixes.size(); n > 0; --n) nested.push_back(std::as_bytes(std::span{prefixes}.first(n)));
+    saburou::platform::v2::bytes::msd_radix_sort(nested, 1);
+    if (std::ranges::is_sorted(nested, {}, &std::span<const std::byte>::size)) {
+        std::cout << "Check: msd_radix_sort nested prefixes OK\n";
+    }
+
+
     namespace endian = saburou::platform::v2::bytes::endian;
     using saburou::platform::v2::bytes::byte_swap;
 